@@ -44,6 +44,7 @@ examples_geopmhash_LDADD = libgeopmpolicy.la
 if ENABLE_MPI
     noinst_PROGRAMS += examples/geopm_ctl_single \
                        examples/timed_region \
+                       examples/tree_comm_bench \
                        # end
     examples_geopm_ctl_single_SOURCES = examples/geopm_ctl_single.cpp
     examples_geopm_ctl_single_LDADD = libgeopm.la $(MPI_CXXLIBS)
@@ -55,6 +56,11 @@ if ENABLE_MPI
     examples_timed_region_LDFLAGS = $(AM_LDFLAGS) $(MPI_CXXLDFLAGS)
     examples_timed_region_CFLAGS = $(AM_CFLAGS) $(MPI_CFLAGS)
     examples_timed_region_CXXFLAGS = $(AM_CXXFLAGS) $(MPI_CXXFLAGS)
+    examples_tree_comm_bench_SOURCES = examples/tree_comm_bench.cpp
+    examples_tree_comm_bench_LDADD = libgeopm.la $(MPI_CXXLIBS)
+    examples_tree_comm_bench_LDFLAGS = $(AM_LDFLAGS) $(MPI_CXXLDFLAGS)
+    examples_tree_comm_bench_CFLAGS = $(AM_CFLAGS) $(MPI_CFLAGS)
+    examples_tree_comm_bench_CXXFLAGS = $(AM_CXXFLAGS) $(MPI_CXXFLAGS)
 endif
 
 if ENABLE_MPI
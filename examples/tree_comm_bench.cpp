@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "geopm_message.h"
+#include "geopm_policy.h"
+#include "geopm_time.h"
+#include "geopm_error.h"
+#include "Exception.hpp"
+#include "GlobalPolicy.hpp"
+#include "TreeCommunicator.hpp"
+
+/// Compare the cost of one level of the control tree when the
+/// mailboxes are reposted with MPI_Irecv() and the messages are sent
+/// with a new MPI_Isend() each time, against persistent requests
+/// that are only restarted.  Each iteration every member sends a
+/// sample to the root of its group, and once the root has all of
+/// them it sends a policy back to every member.
+///
+/// The "repost" and "persistent" columns are the messaging of
+/// TreeCommunicatorLevel before and after it moved to persistent
+/// requests: both poll the sample mailboxes with MPI_Testsome(),
+/// never wait on a send, and fall back to a one time send when no
+/// persistent outbox is free.  The "tree" column drives
+/// geopm::TreeCommunicator itself through the same round trip, so
+/// it adds the cost of the library around the persistent scheme.
+
+enum bench_tag_e {
+    BENCH_SAMPLE_TAG,
+    BENCH_POLICY_TAG,
+};
+
+enum bench_const_e {
+    BENCH_NUM_BUFFER = 2,
+};
+
+/// Mailboxes reposted with MPI_Irecv() once read, messages sent with
+/// MPI_Isend() and the request freed right away.
+class RepostLevel
+{
+    public:
+        RepostLevel(MPI_Comm comm)
+            : m_comm(comm)
+            , m_policy_request(MPI_REQUEST_NULL)
+        {
+            MPI_Comm_rank(comm, &m_rank);
+            MPI_Comm_size(comm, &m_size);
+            m_sample_mailbox.resize(m_size);
+            m_sample_request.resize(m_size, MPI_REQUEST_NULL);
+            m_complete.resize(m_size);
+            MPI_Irecv(&m_policy_mailbox, sizeof(m_policy_mailbox), MPI_BYTE, 0, BENCH_POLICY_TAG, m_comm, &m_policy_request);
+            if (!m_rank) {
+                for (int src = 0; src < m_size; ++src) {
+                    MPI_Irecv(&(m_sample_mailbox[src]), sizeof(m_sample_mailbox[src]), MPI_BYTE, src, BENCH_SAMPLE_TAG, m_comm, &(m_sample_request[src]));
+                }
+            }
+        }
+
+        ~RepostLevel()
+        {
+            MPI_Cancel(&m_policy_request);
+            MPI_Wait(&m_policy_request, MPI_STATUS_IGNORE);
+            for (int src = 0; src < m_size && !m_rank; ++src) {
+                MPI_Cancel(&(m_sample_request[src]));
+                MPI_Wait(&(m_sample_request[src]), MPI_STATUS_IGNORE);
+            }
+        }
+
+        void send_sample(const struct geopm_sample_message_s &sample)
+        {
+            MPI_Request request;
+            MPI_Isend(const_cast<struct geopm_sample_message_s *>(&sample), sizeof(sample), MPI_BYTE, 0, BENCH_SAMPLE_TAG, m_comm, &request);
+            MPI_Request_free(&request);
+        }
+
+        /// Returns the number of samples that arrived.
+        int get_sample(void)
+        {
+            int num_complete = 0;
+            MPI_Testsome(m_size, m_sample_request.data(), &num_complete, m_complete.data(), MPI_STATUSES_IGNORE);
+            if (num_complete == MPI_UNDEFINED) {
+                num_complete = 0;
+            }
+            for (int i = 0; i < num_complete; ++i) {
+                int src = m_complete[i];
+                MPI_Irecv(&(m_sample_mailbox[src]), sizeof(m_sample_mailbox[src]), MPI_BYTE, src, BENCH_SAMPLE_TAG, m_comm, &(m_sample_request[src]));
+            }
+            return num_complete;
+        }
+
+        void send_policy(const struct geopm_policy_message_s &policy)
+        {
+            for (int dest = 0; dest < m_size; ++dest) {
+                MPI_Request request;
+                MPI_Isend(const_cast<struct geopm_policy_message_s *>(&policy), sizeof(policy), MPI_BYTE, dest, BENCH_POLICY_TAG, m_comm, &request);
+                MPI_Request_free(&request);
+            }
+        }
+
+        /// Returns true if a policy arrived.
+        bool get_policy(void)
+        {
+            int is_complete = 0;
+            MPI_Test(&m_policy_request, &is_complete, MPI_STATUS_IGNORE);
+            if (is_complete) {
+                MPI_Irecv(&m_policy_mailbox, sizeof(m_policy_mailbox), MPI_BYTE, 0, BENCH_POLICY_TAG, m_comm, &m_policy_request);
+            }
+            return is_complete;
+        }
+
+    private:
+        MPI_Comm m_comm;
+        int m_rank;
+        int m_size;
+        std::vector<struct geopm_sample_message_s> m_sample_mailbox;
+        std::vector<MPI_Request> m_sample_request;
+        std::vector<int> m_complete;
+        struct geopm_policy_message_s m_policy_mailbox;
+        MPI_Request m_policy_request;
+};
+
+/// BENCH_NUM_BUFFER persistent mailboxes per source, the next one is
+/// started before the last one is read.  Sends restart a persistent
+/// outbox once MPI_Test() shows it is free.
+class PersistentLevel
+{
+    public:
+        PersistentLevel(MPI_Comm comm)
+            : m_comm(comm)
+            , m_policy_active(0)
+            , m_sample_outbox(BENCH_NUM_BUFFER)
+            , m_sample_send_request(BENCH_NUM_BUFFER, MPI_REQUEST_NULL)
+            , m_is_sample_send_active(BENCH_NUM_BUFFER, false)
+        {
+            MPI_Comm_rank(comm, &m_rank);
+            MPI_Comm_size(comm, &m_size);
+            m_sample_mailbox.resize(BENCH_NUM_BUFFER * m_size);
+            m_sample_request.resize(BENCH_NUM_BUFFER * m_size, MPI_REQUEST_NULL);
+            m_sample_active.resize(m_size, 0);
+            m_sample_active_request.resize(m_size, MPI_REQUEST_NULL);
+            m_sample_restart.resize(m_size);
+            m_complete.resize(m_size);
+            for (int buffer = 0; buffer < BENCH_NUM_BUFFER; ++buffer) {
+                MPI_Recv_init(&(m_policy_mailbox[buffer]), sizeof(m_policy_mailbox[buffer]), MPI_BYTE, 0, BENCH_POLICY_TAG, m_comm, &(m_policy_request[buffer]));
+                MPI_Send_init(&(m_sample_outbox[buffer]), sizeof(m_sample_outbox[buffer]), MPI_BYTE, 0, BENCH_SAMPLE_TAG, m_comm, &(m_sample_send_request[buffer]));
+            }
+            MPI_Start(&(m_policy_request[m_policy_active]));
+            if (!m_rank) {
+                m_policy_outbox.resize(BENCH_NUM_BUFFER * m_size);
+                m_policy_send_request.resize(BENCH_NUM_BUFFER * m_size, MPI_REQUEST_NULL);
+                m_is_policy_send_active.resize(BENCH_NUM_BUFFER * m_size, false);
+                for (int src = 0; src < m_size; ++src) {
+                    for (int buffer = 0; buffer < BENCH_NUM_BUFFER; ++buffer) {
+                        int idx = src * BENCH_NUM_BUFFER + buffer;
+                        MPI_Recv_init(&(m_sample_mailbox[idx]), sizeof(m_sample_mailbox[idx]), MPI_BYTE, src, BENCH_SAMPLE_TAG, m_comm, &(m_sample_request[idx]));
+                        MPI_Send_init(&(m_policy_outbox[idx]), sizeof(m_policy_outbox[idx]), MPI_BYTE, src, BENCH_POLICY_TAG, m_comm, &(m_policy_send_request[idx]));
+                    }
+                    m_sample_active_request[src] = m_sample_request[src * BENCH_NUM_BUFFER];
+                }
+                MPI_Startall(m_size, m_sample_active_request.data());
+            }
+        }
+
+        ~PersistentLevel()
+        {
+            MPI_Cancel(&(m_policy_request[m_policy_active]));
+            MPI_Wait(&(m_policy_request[m_policy_active]), MPI_STATUS_IGNORE);
+            for (int buffer = 0; buffer < BENCH_NUM_BUFFER; ++buffer) {
+                MPI_Request_free(&(m_policy_request[buffer]));
+                MPI_Request_free(&(m_sample_send_request[buffer]));
+            }
+            if (!m_rank) {
+                for (int src = 0; src < m_size; ++src) {
+                    MPI_Cancel(&(m_sample_active_request[src]));
+                    MPI_Wait(&(m_sample_active_request[src]), MPI_STATUS_IGNORE);
+                }
+                for (auto it = m_sample_request.begin(); it != m_sample_request.end(); ++it) {
+                    MPI_Request_free(&(*it));
+                }
+                for (auto it = m_policy_send_request.begin(); it != m_policy_send_request.end(); ++it) {
+                    MPI_Request_free(&(*it));
+                }
+            }
+        }
+
+        void send_sample(const struct geopm_sample_message_s &sample)
+        {
+            int buffer = free_outbox(m_sample_send_request.data(), m_is_sample_send_active.begin());
+            if (buffer == BENCH_NUM_BUFFER) {
+                MPI_Request request;
+                MPI_Isend(const_cast<struct geopm_sample_message_s *>(&sample), sizeof(sample), MPI_BYTE, 0, BENCH_SAMPLE_TAG, m_comm, &request);
+                MPI_Request_free(&request);
+            }
+            else {
+                m_sample_outbox[buffer] = sample;
+                MPI_Start(&(m_sample_send_request[buffer]));
+                m_is_sample_send_active[buffer] = true;
+            }
+        }
+
+        /// Returns the number of samples that arrived.
+        int get_sample(void)
+        {
+            int num_complete = 0;
+            MPI_Testsome(m_size, m_sample_active_request.data(), &num_complete, m_complete.data(), MPI_STATUSES_IGNORE);
+            if (num_complete == MPI_UNDEFINED) {
+                num_complete = 0;
+            }
+            for (int i = 0; i < num_complete; ++i) {
+                int src = m_complete[i];
+                m_sample_active[src] = (m_sample_active[src] + 1) % BENCH_NUM_BUFFER;
+                m_sample_active_request[src] = m_sample_request[src * BENCH_NUM_BUFFER + m_sample_active[src]];
+                m_sample_restart[i] = m_sample_active_request[src];
+            }
+            if (num_complete) {
+                MPI_Startall(num_complete, m_sample_restart.data());
+            }
+            return num_complete;
+        }
+
+        void send_policy(const struct geopm_policy_message_s &policy)
+        {
+            for (int dest = 0; dest < m_size; ++dest) {
+                int offset = dest * BENCH_NUM_BUFFER;
+                int buffer = free_outbox(m_policy_send_request.data() + offset, m_is_policy_send_active.begin() + offset);
+                if (buffer == BENCH_NUM_BUFFER) {
+                    MPI_Request request;
+                    MPI_Isend(const_cast<struct geopm_policy_message_s *>(&policy), sizeof(policy), MPI_BYTE, dest, BENCH_POLICY_TAG, m_comm, &request);
+                    MPI_Request_free(&request);
+                }
+                else {
+                    m_policy_outbox[offset + buffer] = policy;
+                    MPI_Start(&(m_policy_send_request[offset + buffer]));
+                    m_is_policy_send_active[offset + buffer] = true;
+                }
+            }
+        }
+
+        /// Returns true if a policy arrived.
+        bool get_policy(void)
+        {
+            int is_complete = 0;
+            MPI_Test(&(m_policy_request[m_policy_active]), &is_complete, MPI_STATUS_IGNORE);
+            if (is_complete) {
+                m_policy_active = (m_policy_active + 1) % BENCH_NUM_BUFFER;
+                MPI_Start(&(m_policy_request[m_policy_active]));
+            }
+            return is_complete;
+        }
+
+    private:
+        /// Index of the first of BENCH_NUM_BUFFER outboxes whose send
+        /// has completed, or BENCH_NUM_BUFFER if all are in flight.
+        static int free_outbox(MPI_Request *request, std::vector<bool>::iterator is_active)
+        {
+            int buffer;
+            for (buffer = 0; buffer < BENCH_NUM_BUFFER; ++buffer, ++is_active) {
+                if (*is_active) {
+                    int is_complete = 0;
+                    MPI_Test(request + buffer, &is_complete, MPI_STATUS_IGNORE);
+                    *is_active = !is_complete;
+                }
+                if (!*is_active) {
+                    break;
+                }
+            }
+            return buffer;
+        }
+
+        MPI_Comm m_comm;
+        int m_rank;
+        int m_size;
+        std::vector<struct geopm_sample_message_s> m_sample_mailbox;
+        std::vector<MPI_Request> m_sample_request;
+        std::vector<int> m_sample_active;
+        std::vector<MPI_Request> m_sample_active_request;
+        std::vector<MPI_Request> m_sample_restart;
+        std::vector<int> m_complete;
+        struct geopm_policy_message_s m_policy_mailbox[BENCH_NUM_BUFFER];
+        MPI_Request m_policy_request[BENCH_NUM_BUFFER];
+        int m_policy_active;
+        std::vector<struct geopm_sample_message_s> m_sample_outbox;
+        std::vector<MPI_Request> m_sample_send_request;
+        std::vector<bool> m_is_sample_send_active;
+        std::vector<struct geopm_policy_message_s> m_policy_outbox;
+        std::vector<MPI_Request> m_policy_send_request;
+        std::vector<bool> m_is_policy_send_active;
+};
+
+template <class level_t>
+static double bench_level(MPI_Comm comm, int num_iter)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    struct geopm_sample_message_s sample = GEOPM_SAMPLE_INVALID;
+    struct geopm_policy_message_s policy = GEOPM_POLICY_UNKNOWN;
+    struct geopm_time_s start, end;
+    level_t level(comm);
+
+    MPI_Barrier(comm);
+    geopm_time(&start);
+    for (int iter = 0; iter < num_iter; ++iter) {
+        level.send_sample(sample);
+        if (!rank) {
+            int num_sample = 0;
+            while (num_sample < size) {
+                num_sample += level.get_sample();
+            }
+            level.send_policy(policy);
+        }
+        bool is_policy = false;
+        while (!is_policy) {
+            is_policy = level.get_policy();
+        }
+    }
+    geopm_time(&end);
+    MPI_Barrier(comm);
+    return geopm_time_diff(&start, &end) / num_iter;
+}
+
+static double bench_tree(MPI_Comm comm, int num_iter)
+{
+    int rank, size, world_rank;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    struct geopm_sample_message_s sample = GEOPM_SAMPLE_INVALID;
+    struct geopm_policy_message_s policy = GEOPM_POLICY_UNKNOWN;
+    std::vector<struct geopm_sample_message_s> child_sample(size);
+    std::vector<struct geopm_policy_message_s> child_policy(size);
+    struct geopm_time_s start, end;
+    geopm::GlobalPolicy *global_policy = NULL;
+    std::string control;
+
+    // Only the root of the tree maps a control file
+    if (!rank) {
+        control = "/tmp/tree_comm_bench_" + std::to_string(world_rank) + ".control";
+        global_policy = new geopm::GlobalPolicy("", control);
+        global_policy->mode(GEOPM_POLICY_MODE_FREQ_UNIFORM_STATIC);
+        global_policy->frequency_mhz(1200);
+        global_policy->write();
+    }
+    geopm::TreeCommunicator *tcomm = new geopm::TreeCommunicator(std::vector<int>(1, size), global_policy, comm, false);
+
+    MPI_Barrier(comm);
+    geopm_time(&start);
+    for (int iter = 0; iter < num_iter; ++iter) {
+        tcomm->send_sample(0, sample);
+        if (!rank) {
+            bool is_complete = false;
+            while (!is_complete) {
+                try {
+                    tcomm->get_sample(1, child_sample);
+                    is_complete = true;
+                }
+                catch (geopm::Exception ex) {
+                    if (ex.err_value() != GEOPM_ERROR_SAMPLE_INCOMPLETE) {
+                        throw ex;
+                    }
+                }
+            }
+            policy.flags = iter + 1;
+            std::fill(child_policy.begin(), child_policy.end(), policy);
+            tcomm->send_policy(0, child_policy);
+        }
+        // The level keeps the last policy, wait for this iteration's
+        struct geopm_policy_message_s level_policy = GEOPM_POLICY_UNKNOWN;
+        while (level_policy.flags != (unsigned long)(iter + 1)) {
+            try {
+                tcomm->get_policy(0, level_policy);
+            }
+            catch (geopm::Exception ex) {
+                if (ex.err_value() != GEOPM_ERROR_POLICY_UNKNOWN) {
+                    throw ex;
+                }
+            }
+        }
+    }
+    geopm_time(&end);
+    MPI_Barrier(comm);
+    delete tcomm;
+    if (global_policy) {
+        delete global_policy;
+        unlink(control.c_str());
+    }
+    return geopm_time_diff(&start, &end) / num_iter;
+}
+
+int main(int argc, char **argv)
+{
+    int rank, size;
+    int num_iter = 10000;
+    const int fan_out[] = {2, 4, 8, 16};
+    enum {
+        NUM_BENCH = 3,
+    };
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (argc > 1) {
+        num_iter = atoi(argv[1]);
+    }
+    if (!rank) {
+        printf("# usec per iteration, slowest group, %d iterations\n", num_iter);
+        printf("%8s %12s %12s %12s\n", "fan_out", "repost", "persistent", "tree");
+    }
+    for (unsigned i = 0; i < sizeof(fan_out) / sizeof(fan_out[0]) && fan_out[i] <= size; ++i) {
+        MPI_Comm comm;
+        int color = rank < size - size % fan_out[i] ? rank / fan_out[i] : MPI_UNDEFINED;
+        double elapsed[NUM_BENCH] = {0.0, 0.0, 0.0};
+        double max_elapsed[NUM_BENCH];
+        MPI_Comm_split(MPI_COMM_WORLD, color, rank, &comm);
+        if (comm != MPI_COMM_NULL) {
+            elapsed[0] = bench_level<RepostLevel>(comm, num_iter);
+            elapsed[1] = bench_level<PersistentLevel>(comm, num_iter);
+            elapsed[2] = bench_tree(comm, num_iter);
+            MPI_Comm_free(&comm);
+        }
+        MPI_Reduce(elapsed, max_elapsed, NUM_BENCH, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        if (!rank) {
+            printf("%8d %12.3f %12.3f %12.3f\n", fan_out[i], max_elapsed[0] * 1E6, max_elapsed[1] * 1E6, max_elapsed[2] * 1E6);
+        }
+    }
+    MPI_Finalize();
+    return 0;
+}
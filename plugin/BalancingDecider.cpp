@@ -73,6 +73,9 @@ namespace geopm
         , m_num_sample(8)
         , m_num_out_of_range(0)
         , M_GUARD_BAND(1.15)
+        , m_slack_target(0.02)
+        , m_is_iteration_done()
+        , m_is_discard(false)
     {
 
     }
@@ -119,11 +122,20 @@ namespace geopm
                 }
             }
             else {
-                // Split the budget up evenly to start.
-                double split_budget = policy_msg.power_budget / num_domain;
                 std::vector<double> domain_budget(num_domain);
-                std::fill(domain_budget.begin(), domain_budget.end(), split_budget);
-                curr_policy.update(GEOPM_REGION_ID_OUTER, domain_budget);
+                bool is_converged;
+                if (curr_policy.seed_target(GEOPM_REGION_ID_OUTER, policy_msg.power_budget, domain_budget, is_converged)) {
+                    // Start from the split learned by an earlier run.
+                    curr_policy.update(GEOPM_REGION_ID_OUTER, domain_budget);
+                    curr_policy.is_converged(GEOPM_REGION_ID_OUTER, is_converged);
+                    m_num_converged = is_converged ? m_min_num_converged : 0;
+                }
+                else {
+                    // Split the budget up evenly to start.
+                    double split_budget = policy_msg.power_budget / num_domain;
+                    std::fill(domain_budget.begin(), domain_budget.end(), split_budget);
+                    curr_policy.update(GEOPM_REGION_ID_OUTER, domain_budget);
+                }
             }
             m_last_power_budget = policy_msg.power_budget;
             result = true;
@@ -135,8 +147,11 @@ namespace geopm
     {
         bool is_updated = false;
 
+        if (is_slack_valid(curr_region, curr_policy.num_domain())) {
+            is_updated = update_slack(curr_region, curr_policy);
+        }
         // Don't do anything if we have already converged.
-        if (curr_region.num_sample(0, GEOPM_SAMPLE_TYPE_RUNTIME) >= m_num_sample) {
+        else if (curr_region.num_sample(0, GEOPM_SAMPLE_TYPE_RUNTIME) >= m_num_sample) {
             int num_domain = curr_policy.num_domain();
             std::vector<std::pair<int,double> > runtime(num_domain);
             double sum = 0.0;
@@ -208,4 +223,110 @@ namespace geopm
 
         return is_updated;
     }
+
+    bool BalancingDecider::is_slack_valid(const Region &curr_region, int num_domain) const
+    {
+        bool result = false;
+        struct geopm_sample_message_s sample;
+        for (int i = 0; !result && i < num_domain; ++i) {
+            curr_region.domain_sample_message(i, sample);
+            result = sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] > 0.0;
+        }
+        return result;
+    }
+
+    bool BalancingDecider::update_slack(Region &curr_region, Policy &curr_policy)
+    {
+        bool is_updated = false;
+        int num_domain = curr_policy.num_domain();
+
+        if (m_is_iteration_done.size() != (size_t)num_domain) {
+            m_is_iteration_done.assign(num_domain, false);
+        }
+        for (int i = 0; i < num_domain; ++i) {
+            if (curr_region.sample_age(i) == 0) {
+                m_is_iteration_done[i] = true;
+            }
+        }
+        // Wait until every child has completed an outer-loop iteration
+        bool is_iteration = std::find(m_is_iteration_done.begin(), m_is_iteration_done.end(), false) == m_is_iteration_done.end();
+        if (is_iteration) {
+            std::fill(m_is_iteration_done.begin(), m_is_iteration_done.end(), false);
+            if (m_is_discard) {
+                // The iteration straddled the last power shift
+                m_is_discard = false;
+                is_iteration = false;
+            }
+        }
+        if (is_iteration) {
+            std::vector<double> slack(num_domain);
+            struct geopm_sample_message_s sample;
+            for (int i = 0; i < num_domain; ++i) {
+                curr_region.domain_sample_message(i, sample);
+                double iteration_time = sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] + sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME];
+                slack[i] = iteration_time > 0.0 ? sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] / iteration_time : 0.0;
+            }
+            auto minmax = std::minmax_element(slack.begin(), slack.end());
+            double spread = *(minmax.second) - *(minmax.first);
+
+            if (!curr_policy.is_converged(curr_region.identifier()) && spread > m_slack_target) {
+                m_num_converged = 0;
+                // A child's share of power is scaled by the fraction of
+                // the iteration it spent computing.
+                std::vector<double> target(num_domain);
+                std::vector<bool> is_bound(num_domain, false);
+                for (int i = 0; i < num_domain; ++i) {
+                    curr_policy.target(GEOPM_REGION_ID_OUTER, i, target[i]);
+                    target[i] *= 1.0 - slack[i];
+                }
+                // Hold children that hit a bound there and share the
+                // rest of the budget among the others.
+                bool is_done = false;
+                while (!is_done) {
+                    is_done = true;
+                    double pool = m_last_power_budget;
+                    double total = 0.0;
+                    for (int i = 0; i < num_domain; ++i) {
+                        if (is_bound[i]) {
+                            pool -= target[i];
+                        }
+                        else {
+                            total += target[i];
+                        }
+                    }
+                    for (int i = 0; total > 0.0 && i < num_domain; ++i) {
+                        if (!is_bound[i]) {
+                            target[i] *= pool / total;
+                            if (target[i] < m_lower_bound || target[i] > m_upper_bound) {
+                                target[i] = target[i] < m_lower_bound ? m_lower_bound : m_upper_bound;
+                                is_bound[i] = true;
+                                is_done = false;
+                            }
+                        }
+                    }
+                }
+                curr_policy.update(GEOPM_REGION_ID_OUTER, target);
+                m_is_discard = true;
+                is_updated = true;
+            }
+            else if (curr_policy.is_converged(curr_region.identifier()) && spread > m_slack_target) {
+                ++m_num_out_of_range;
+                if (m_num_out_of_range >= m_min_num_converged) {
+                    curr_policy.is_converged(curr_region.identifier(), false);
+                    m_num_converged = 0;
+                    m_num_out_of_range = 0;
+                }
+            }
+            else if (!curr_policy.is_converged(curr_region.identifier())) {
+                ++m_num_converged;
+                if (m_num_converged >= m_min_num_converged) {
+                    curr_policy.is_converged(curr_region.identifier(), true);
+                }
+            }
+            else {
+                m_num_out_of_range = 0;
+            }
+        }
+        return is_updated;
+    }
 }
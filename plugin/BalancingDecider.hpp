@@ -33,6 +33,8 @@
 #ifndef BALANCING_DECIDER_HPP_INCLUDE
 #define BALANCING_DECIDER_HPP_INCLUDE
 
+#include <vector>
+
 #include "Decider.hpp"
 #include "geopm_plugin.h"
 
@@ -46,6 +48,12 @@ namespace geopm
     /// more power than nodes that are ahead. The sum of the individual node budgets
     /// will sum to the budget allocated to the level of the heirarchy the decider
     /// instance is running at.
+    ///
+    /// When the children report the time they spent waiting in MPI
+    /// during the last outer-loop iteration the decider balances on
+    /// that slack instead: power is moved from children that wait in
+    /// collectives to the ones on the critical path once per
+    /// iteration, and convergence is counted in iterations.
     class BalancingDecider : public Decider
     {
         public:
@@ -60,6 +68,13 @@ namespace geopm
             virtual bool decider_supported(const std::string &descripton);
             virtual const std::string& name(void) const;
         private:
+            /// @brief Returns true if any child has reported time
+            ///        spent waiting in MPI.
+            bool is_slack_valid(const Region &curr_region, int num_domain) const;
+            /// @brief Redistribute power by the MPI wait fraction of
+            ///        each child once every child has completed an
+            ///        outer-loop iteration.
+            bool update_slack(Region &curr_region, Policy &curr_policy);
             const std::string m_name;
             const double m_convergence_target;
             const unsigned m_min_num_converged;
@@ -68,6 +83,9 @@ namespace geopm
             int m_num_sample;
             unsigned m_num_out_of_range;
             const double M_GUARD_BAND;
+            const double m_slack_target;
+            std::vector<bool> m_is_iteration_done;
+            bool m_is_discard;
     };
 }
 
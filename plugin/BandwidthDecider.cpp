@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+#include <hwloc.h>
+
+#include "geopm_message.h"
+#include "geopm_plugin.h"
+#include "BandwidthDecider.hpp"
+#include "Exception.hpp"
+
+int geopm_plugin_register(int plugin_type, struct geopm_factory_c *factory, void *dl_ptr)
+{
+    int err = 0;
+
+    try {
+        if (plugin_type == GEOPM_PLUGIN_TYPE_DECIDER) {
+            geopm::Decider *decider = new geopm::BandwidthDecider;
+            geopm_factory_register(factory, decider, dl_ptr);
+        }
+    }
+    catch(...) {
+        err = geopm::exception_handler(std::current_exception());
+    }
+
+    return err;
+}
+
+namespace geopm
+{
+    BandwidthDecider::BandwidthDecider()
+        : m_name("frequency_bandwidth")
+        , m_ipc_enter(0.6)
+        , m_ipc_exit(0.9)
+        , m_bandwidth_enter(0.6)
+        , m_bandwidth_exit(0.4)
+        , m_min_num_switch(5)
+        , m_is_first_policy(true)
+        , m_max_bandwidth(0.0)
+        , m_last_region_id(0)
+    {
+
+    }
+
+    BandwidthDecider::~BandwidthDecider()
+    {
+
+    }
+
+    Decider *BandwidthDecider::clone(void) const
+    {
+        return (Decider*)(new BandwidthDecider(*this));
+    }
+
+    bool BandwidthDecider::decider_supported(const std::string &description)
+    {
+        return (description == m_name);
+    }
+
+    const std::string& BandwidthDecider::name(void) const
+    {
+        return m_name;
+    }
+
+    bool BandwidthDecider::update_policy(const struct geopm_policy_message_s &policy_msg, Policy &curr_policy)
+    {
+        bool result = false;
+        // The power budget does not steer a frequency decider, only
+        // the first policy is used to start every domain at the
+        // upper bound.
+        if (m_is_first_policy) {
+            std::vector<double> target(curr_policy.num_domain());
+            std::fill(target.begin(), target.end(), m_upper_bound);
+            curr_policy.update(GEOPM_REGION_ID_OUTER, target);
+            curr_policy.mode(policy_msg.mode);
+            curr_policy.policy_flags(policy_msg.flags);
+            m_is_first_policy = false;
+            result = true;
+        }
+        return result;
+    }
+
+    bool BandwidthDecider::update_policy(Region &curr_region, Policy &curr_policy)
+    {
+        bool is_stable = true;
+        const int num_domain = curr_policy.num_domain();
+        const uint64_t region_id = curr_region.identifier();
+        // Entering a different region is a boundary where the
+        // region's frequency should be enforced, the last region may
+        // have left the domains at the memory frequency.
+        bool is_updated = (region_id != m_last_region_id);
+        m_last_region_id = region_id;
+
+        auto state_it = m_region_state.find(region_id);
+        if (state_it == m_region_state.end()) {
+            struct m_region_state_s state;
+            // A region the application marked as memory bound runs
+            // at the memory frequency before it has been sampled.
+            state.is_memory_bound.resize(num_domain, curr_region.hint() == GEOPM_POLICY_HINT_MEMORY);
+            state.num_switch.resize(num_domain, 0);
+            state_it = m_region_state.insert(std::pair<uint64_t, struct m_region_state_s>(region_id, state)).first;
+        }
+        struct m_region_state_s &state = (*state_it).second;
+
+        bool is_changed = false;
+        std::vector<double> target(num_domain);
+        curr_policy.target(region_id, target);
+        for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
+            double inst = curr_region.derivative(domain_idx, GEOPM_TELEMETRY_TYPE_INST_RETIRED);
+            double clk = curr_region.derivative(domain_idx, GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE);
+            double bandwidth = curr_region.derivative(domain_idx, GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH);
+            if (isnan(inst) || isnan(clk) || isnan(bandwidth) || clk <= 0.0) {
+                // Fewer than two samples since the region was entered
+                is_stable = false;
+            }
+            else {
+                if (bandwidth > m_max_bandwidth) {
+                    m_max_bandwidth = bandwidth;
+                }
+                double ipc = inst / clk;
+                double bandwidth_fraction = m_max_bandwidth > 0.0 ? bandwidth / m_max_bandwidth : 0.0;
+                bool is_switch;
+                if (state.is_memory_bound[domain_idx]) {
+                    is_switch = ipc > m_ipc_exit || bandwidth_fraction < m_bandwidth_exit;
+                }
+                else {
+                    is_switch = ipc < m_ipc_enter && bandwidth_fraction > m_bandwidth_enter;
+                }
+                if (is_switch) {
+                    ++state.num_switch[domain_idx];
+                    if (state.num_switch[domain_idx] >= m_min_num_switch) {
+                        state.is_memory_bound[domain_idx] = !state.is_memory_bound[domain_idx];
+                        state.num_switch[domain_idx] = 0;
+                    }
+                    else {
+                        is_stable = false;
+                    }
+                }
+                else {
+                    state.num_switch[domain_idx] = 0;
+                }
+            }
+            double domain_target = state.is_memory_bound[domain_idx] ? memory_frequency() : m_upper_bound;
+            if (target[domain_idx] != domain_target) {
+                target[domain_idx] = domain_target;
+                is_changed = true;
+            }
+        }
+        if (is_changed) {
+            curr_policy.update(region_id, target);
+            is_updated = true;
+        }
+        curr_policy.is_converged(region_id, is_stable);
+        return is_updated;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BANDWIDTH_DECIDER_HPP_INCLUDE
+#define BANDWIDTH_DECIDER_HPP_INCLUDE
+
+#include <map>
+#include <vector>
+
+#include "Decider.hpp"
+#include "geopm_plugin.h"
+
+namespace geopm
+{
+    /// @brief Memory bandwidth aware frequency leaf decider.
+    ///
+    /// The bandwidth decider classifies each region on each domain of
+    /// control (ex: socket) as compute or memory bound using the
+    /// instructions retired per unhalted core cycle (IPC) and the
+    /// memory read bandwidth relative to the highest bandwidth seen
+    /// on any domain of the node.  Compute bound regions run at the upper
+    /// frequency bound and memory bound regions at a reduced
+    /// frequency.  Separate thresholds for entering and leaving the
+    /// memory bound state, and a minimum number of consecutive
+    /// samples before switching, keep the decider from thrashing.
+    /// Regions registered with GEOPM_POLICY_HINT_MEMORY start out in
+    /// the memory bound state.
+    /// This decider is intended to be used with the frequency
+    /// platform.
+    class BandwidthDecider : public Decider
+    {
+        public:
+            /// @ brief BandwidthDecider default constructor.
+            BandwidthDecider();
+            /// @ brief BandwidthDecider destructor, virtual.
+            virtual ~BandwidthDecider();
+            virtual Decider *clone(void) const;
+            virtual bool update_policy(const struct geopm_policy_message_s &policy_msg, Policy &curr_policy);
+            virtual bool update_policy(Region &curr_region, Policy &curr_policy);
+            virtual bool decider_supported(const std::string &descripton);
+            virtual const std::string& name(void) const;
+        private:
+            struct m_region_state_s {
+                /// @brief Current classification of each domain.
+                std::vector<bool> is_memory_bound;
+                /// @brief Number of consecutive samples classified
+                ///        against the current state on each domain.
+                std::vector<unsigned> num_switch;
+            };
+            const std::string m_name;
+            /// @brief IPC below which a domain may enter the memory
+            ///        bound state.
+            const double m_ipc_enter;
+            /// @brief IPC above which a domain leaves the memory
+            ///        bound state.
+            const double m_ipc_exit;
+            /// @brief Fraction of the peak bandwidth above which a
+            ///        domain may enter the memory bound state.
+            const double m_bandwidth_enter;
+            /// @brief Fraction of the peak bandwidth below which a
+            ///        domain leaves the memory bound state.
+            const double m_bandwidth_exit;
+            const unsigned m_min_num_switch;
+            bool m_is_first_policy;
+            /// @brief Highest read bandwidth seen on any domain.
+            double m_max_bandwidth;
+            std::map<uint64_t, struct m_region_state_s> m_region_state;
+            /// @brief Region of the last call to update_policy().
+            uint64_t m_last_region_id;
+    };
+}
+
+#endif
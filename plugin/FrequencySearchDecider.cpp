@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+#include <float.h>
+#include <hwloc.h>
+
+#include "geopm_message.h"
+#include "geopm_plugin.h"
+#include "FrequencySearchDecider.hpp"
+#include "Exception.hpp"
+
+int geopm_plugin_register(int plugin_type, struct geopm_factory_c *factory, void *dl_ptr)
+{
+    int err = 0;
+
+    try {
+        if (plugin_type == GEOPM_PLUGIN_TYPE_DECIDER) {
+            geopm::Decider *decider = new geopm::FrequencySearchDecider;
+            geopm_factory_register(factory, decider, dl_ptr);
+        }
+    }
+    catch(...) {
+        err = geopm::exception_handler(std::current_exception());
+    }
+
+    return err;
+}
+
+namespace geopm
+{
+    FrequencySearchDecider::FrequencySearchDecider()
+        : m_name("frequency_search")
+        , m_golden_ratio(0.6180339887498949)
+        , m_num_entry(3)
+        , m_resolution(0.05)
+        , m_is_first_policy(true)
+        , m_last_region_id(0)
+    {
+
+    }
+
+    FrequencySearchDecider::~FrequencySearchDecider()
+    {
+
+    }
+
+    Decider *FrequencySearchDecider::clone(void) const
+    {
+        return (Decider*)(new FrequencySearchDecider(*this));
+    }
+
+    bool FrequencySearchDecider::decider_supported(const std::string &description)
+    {
+        return (description == m_name);
+    }
+
+    const std::string& FrequencySearchDecider::name(void) const
+    {
+        return m_name;
+    }
+
+    bool FrequencySearchDecider::update_policy(const struct geopm_policy_message_s &policy_msg, Policy &curr_policy)
+    {
+        bool result = false;
+        // The power budget does not steer a frequency decider, only
+        // the first policy is used to start every domain at the
+        // upper bound.
+        if (m_is_first_policy) {
+            std::vector<double> target(curr_policy.num_domain());
+            std::fill(target.begin(), target.end(), m_upper_bound);
+            curr_policy.update(GEOPM_REGION_ID_OUTER, target);
+            curr_policy.mode(policy_msg.mode);
+            curr_policy.policy_flags(policy_msg.flags);
+            m_is_first_policy = false;
+            result = true;
+        }
+        return result;
+    }
+
+    bool FrequencySearchDecider::update_policy(Region &curr_region, Policy &curr_policy)
+    {
+        const int num_domain = curr_policy.num_domain();
+        const uint64_t region_id = curr_region.identifier();
+        // Entering a different region is a boundary where the
+        // region's frequency should be enforced.
+        bool is_updated = (region_id != m_last_region_id);
+        m_last_region_id = region_id;
+
+        auto search_it = m_search.find(region_id);
+        if (search_it == m_search.end()) {
+            struct m_search_s search;
+            double width = m_upper_bound - m_lower_bound;
+            search.lower = m_lower_bound;
+            search.upper = m_upper_bound;
+            search.frequency[0] = m_upper_bound - m_golden_ratio * width;
+            search.frequency[1] = m_lower_bound + m_golden_ratio * width;
+            search.edp[0] = NAN;
+            search.edp[1] = NAN;
+            search.curr = 0;
+            search.edp_sum = 0.0;
+            search.num_edp = 0;
+            search.is_discard = true;
+            search.best_frequency = m_upper_bound;
+            search.best_edp = DBL_MAX;
+            search.num_complete = curr_region.num_complete();
+            // The outer region targets are the upper bound on every
+            // domain, and their sum is what the policy cache records
+            // as the budget, so seeded targets are not rescaled.  A
+            // seed taken before the search finished is only a probe.
+            std::vector<double> target(num_domain);
+            bool is_converged = false;
+            if (curr_policy.seed_target(region_id, num_domain * m_upper_bound, target, is_converged) &&
+                is_converged) {
+                search.best_frequency = target[0];
+                search.curr = -1;
+            }
+            // Without a learned frequency trust the application's
+            // hint and skip the search.
+            else if (curr_region.hint() == GEOPM_POLICY_HINT_COMPUTE) {
+                search.best_frequency = m_upper_bound;
+                search.curr = -1;
+            }
+            else if (curr_region.hint() == GEOPM_POLICY_HINT_MEMORY) {
+                search.best_frequency = memory_frequency();
+                search.curr = -1;
+            }
+            else if (curr_region.hint() == GEOPM_POLICY_HINT_NETWORK) {
+                search.best_frequency = m_lower_bound;
+                search.curr = -1;
+            }
+            search_it = m_search.insert(std::pair<uint64_t, struct m_search_s>(region_id, search)).first;
+        }
+        struct m_search_s &search = (*search_it).second;
+
+        uint64_t num_complete = curr_region.num_complete();
+        if (num_complete != search.num_complete) {
+            // An entry into the region has just completed.
+            search.num_complete = num_complete;
+            struct geopm_sample_message_s sample;
+            curr_region.sample_message(sample);
+            double runtime = sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+            double energy = sample.signal[GEOPM_SAMPLE_TYPE_ENERGY];
+            if (search.is_discard) {
+                search.is_discard = false;
+            }
+            else if (search.curr != -1 && runtime > 0.0 && energy > 0.0) {
+                search.edp_sum += energy * runtime;
+                ++search.num_edp;
+                if (search.num_edp == m_num_entry) {
+                    double edp = search.edp_sum / search.num_edp;
+                    search.edp[search.curr] = edp;
+                    if (edp < search.best_edp) {
+                        search.best_edp = edp;
+                        search.best_frequency = search.frequency[search.curr];
+                    }
+                    search.edp_sum = 0.0;
+                    search.num_edp = 0;
+                    next_point(search);
+                }
+            }
+        }
+
+        double frequency = search.curr == -1 ? search.best_frequency : search.frequency[search.curr];
+        std::vector<double> target(num_domain);
+        curr_policy.target(region_id, target);
+        for (auto it = target.begin(); it != target.end(); ++it) {
+            if (*it != frequency) {
+                std::fill(target.begin(), target.end(), frequency);
+                curr_policy.update(region_id, target);
+                is_updated = true;
+                break;
+            }
+        }
+        curr_policy.is_converged(region_id, search.curr == -1);
+        return is_updated;
+    }
+
+    void FrequencySearchDecider::next_point(struct m_search_s &search) const
+    {
+        int other = 1 - search.curr;
+        if (isnan(search.edp[other])) {
+            search.curr = other;
+            return;
+        }
+        // Both interior points are measured: drop the end beyond the
+        // worse one, the better one becomes the other interior point.
+        double width;
+        if (search.edp[0] < search.edp[1]) {
+            search.upper = search.frequency[1];
+            search.frequency[1] = search.frequency[0];
+            search.edp[1] = search.edp[0];
+            width = search.upper - search.lower;
+            search.frequency[0] = search.upper - m_golden_ratio * width;
+            search.edp[0] = NAN;
+            search.curr = 0;
+        }
+        else {
+            search.lower = search.frequency[0];
+            search.frequency[0] = search.frequency[1];
+            search.edp[0] = search.edp[1];
+            width = search.upper - search.lower;
+            search.frequency[1] = search.lower + m_golden_ratio * width;
+            search.edp[1] = NAN;
+            search.curr = 1;
+        }
+        if (width < m_resolution * (m_upper_bound - m_lower_bound)) {
+            search.curr = -1;
+        }
+    }
+}
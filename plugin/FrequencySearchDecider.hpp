@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FREQUENCY_SEARCH_DECIDER_HPP_INCLUDE
+#define FREQUENCY_SEARCH_DECIDER_HPP_INCLUDE
+
+#include <map>
+
+#include "Decider.hpp"
+#include "geopm_plugin.h"
+
+namespace geopm
+{
+    /// @brief Leaf decider that searches for the frequency with the
+    ///        lowest energy-delay product of each region.
+    ///
+    /// Each region runs a golden-section search over the frequency
+    /// bounds of the platform.  A candidate frequency is scored by
+    /// the mean energy times runtime over several completed entries
+    /// into the region, and the bracket is narrowed until it is
+    /// smaller than a fraction of the frequency range.  The best
+    /// frequency measured is then locked in and the region policy is
+    /// marked as converged, which allows the result to be saved with
+    /// GEOPM_POLICY_CACHE and used to seed the region in later runs.
+    /// Regions registered with a compute, memory or network policy
+    /// hint skip the search and are locked at the upper bound, a
+    /// reduced frequency or the lower bound respectively.
+    /// New targets are only chosen when an entry into the region
+    /// completes, and the decider only asks for the policy to be
+    /// enforced at region boundaries.  This decider is intended to be
+    /// used with the frequency platform.
+    class FrequencySearchDecider : public Decider
+    {
+        public:
+            /// @ brief FrequencySearchDecider default constructor.
+            FrequencySearchDecider();
+            /// @ brief FrequencySearchDecider destructor, virtual.
+            virtual ~FrequencySearchDecider();
+            virtual Decider *clone(void) const;
+            virtual bool update_policy(const struct geopm_policy_message_s &policy_msg, Policy &curr_policy);
+            virtual bool update_policy(Region &curr_region, Policy &curr_policy);
+            virtual bool decider_supported(const std::string &descripton);
+            virtual const std::string& name(void) const;
+        private:
+            struct m_search_s {
+                /// @brief Bracket that holds the optimum.
+                double lower;
+                double upper;
+                /// @brief Interior points of the bracket and their
+                ///        mean energy-delay, NAN until measured.
+                double frequency[2];
+                double edp[2];
+                /// @brief Index of the point being measured, -1
+                ///        once the search is complete.
+                int curr;
+                /// @brief Energy-delay accumulated for the point
+                ///        being measured.
+                double edp_sum;
+                int num_edp;
+                /// @brief Skip the next completed entry, the first
+                ///        entry starts before the region frequency
+                ///        is enforced.
+                bool is_discard;
+                double best_frequency;
+                double best_edp;
+                /// @brief Region::num_complete() when last checked.
+                uint64_t num_complete;
+            };
+            void next_point(struct m_search_s &search) const;
+            const std::string m_name;
+            /// @brief Fraction of the bracket between an end and the
+            ///        far interior point.
+            const double m_golden_ratio;
+            /// @brief Entries into a region averaged for each point.
+            const int m_num_entry;
+            /// @brief Bracket width as a fraction of the frequency
+            ///        range at which the search stops.
+            const double m_resolution;
+            bool m_is_first_policy;
+            uint64_t m_last_region_id;
+            std::map<uint64_t, struct m_search_s> m_search;
+    };
+}
+
+#endif
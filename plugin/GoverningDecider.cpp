@@ -122,6 +122,21 @@ namespace geopm
         bool is_greater = false;
         bool is_less = false;
 
+        // Start a region that has not been seen before from the
+        // targets learned by an earlier run if there are any.
+        if (m_last_power_budget != DBL_MIN &&
+            m_num_converged.find(curr_region.identifier()) == m_num_converged.end()) {
+            const uint64_t region_id = curr_region.identifier();
+            std::vector<double> target(curr_policy.num_domain());
+            bool is_converged;
+            if (curr_policy.seed_target(region_id, m_last_power_budget, target, is_converged)) {
+                curr_policy.update(region_id, target);
+                curr_policy.is_converged(region_id, is_converged);
+                m_num_converged.insert(std::pair<uint64_t, unsigned>(region_id, is_converged ? m_min_num_converged : 0));
+                is_updated = true;
+            }
+        }
+
         if (curr_region.num_sample(0, GEOPM_SAMPLE_TYPE_RUNTIME) > m_num_sample) {
             const int num_domain = curr_policy.num_domain();
             const uint64_t region_id = curr_region.identifier();
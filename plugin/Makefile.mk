@@ -39,6 +39,18 @@ libgeopmpi_balancing_la_SOURCES = plugin/BalancingDecider.cpp \
                                   plugin/BalancingDecider.hpp \
                                   # end
 
+pkglib_LTLIBRARIES += libgeopmpi_bandwidth.la
+libgeopmpi_bandwidth_la_SOURCES = plugin/BandwidthDecider.cpp \
+                                  plugin/BandwidthDecider.hpp \
+                                  # end
+
+pkglib_LTLIBRARIES += libgeopmpi_search.la
+libgeopmpi_search_la_SOURCES = plugin/FrequencySearchDecider.cpp \
+                               plugin/FrequencySearchDecider.hpp \
+                               # end
+
 # -module required to force .so generation of plugin.
 libgeopmpi_governing_la_LDFLAGS = $(AM_LDFLAGS) -module
 libgeopmpi_balancing_la_LDFLAGS = $(AM_LDFLAGS) -module
+libgeopmpi_bandwidth_la_LDFLAGS = $(AM_LDFLAGS) -module
+libgeopmpi_search_la_LDFLAGS = $(AM_LDFLAGS) -module
@@ -89,7 +89,23 @@ namespace geopm
             /// at the end of the buffer.
             ///
             /// @param [in] value The value to be inserted.
-            void insert(const type value);
+            void insert(const type &value);
+            /// @brief Returns a reference to the entry the next
+            ///        insertion will occupy.
+            ///
+            /// Allows a value to be written in place rather than
+            /// copied in with insert(). If the buffer is at capacity
+            /// this is the storage of the oldest entry, which is
+            /// still returned by value(0) until advance() is called.
+            /// The size of the buffer is not modified.
+            ///
+            /// @return Reference to the next entry.
+            type &slot(void);
+            /// @brief Adds the entry returned by slot() to the buffer.
+            ///
+            /// Has the same effect on the buffer as insert() but
+            /// does not copy a value.
+            void advance(void);
             /// @brief Returns a constant refernce to the value from the buffer.
             ///
             /// Accesses the contents of the circular buffer
@@ -173,17 +189,31 @@ namespace geopm
     }
 
     template <class type>
-    void CircularBuffer<type>::insert(const type value)
+    void CircularBuffer<type>::insert(const type &value)
+    {
+        slot() = value;
+        advance();
+    }
+
+    template <class type>
+    type &CircularBuffer<type>::slot(void)
+    {
+        if (m_max_size < 1) {
+            throw Exception("CircularBuffer::slot(): Cannot insert into a buffer of 0 size", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return m_count < m_max_size ? m_buffer[m_count] : m_buffer[m_head];
+    }
+
+    template <class type>
+    void CircularBuffer<type>::advance(void)
     {
         if (m_max_size < 1) {
-            throw Exception("CircularBuffer::insert(): Cannot insert into a buffer of 0 size", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            throw Exception("CircularBuffer::advance(): Cannot insert into a buffer of 0 size", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
         if (m_count < m_max_size) {
-            m_buffer[m_count] = value;
             m_count++;
         }
         else {
-            m_buffer[m_head] = value;
             m_head = ((m_head + 1) % m_max_size);
         }
     }
@@ -35,6 +35,7 @@
 #include <libgen.h>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <streambuf>
 #include <stdexcept>
 #include <string>
@@ -48,6 +49,8 @@
 #include "geopm.h"
 #include "geopm_version.h"
 #include "geopm_signal_handler.h"
+#include "geopm_env.h"
+#include "geopm_comm.h"
 #include "Controller.hpp"
 #include "Exception.hpp"
 #include "config.h"
@@ -185,23 +188,31 @@ namespace geopm
         , m_is_in_outer(false)
         , m_rank_per_node(0)
         , m_outer_sync_time(0.0)
+        , m_mpi_sync_time(0.0)
         , m_is_outer_changed(false)
+        , m_outer_sample(GEOPM_SAMPLE_INVALID)
+        , m_ppn1_comm(MPI_COMM_NULL)
+        , m_policy_cache(NULL)
     {
         MPI_Comm ppn1_comm;
         int err = 0;
         int num_nodes = 0;
 
-        err = geopm_comm_split_ppn1(comm, "ctl", &ppn1_comm);
+        err = geopm_comm_ppn1_cached(comm, &ppn1_comm);
         if (err) {
-            throw geopm::Exception("geopm_comm_split_ppn1()", err, __FILE__, __LINE__);
+            throw geopm::Exception("geopm_comm_ppn1_cached()", err, __FILE__, __LINE__);
         }
         // Only the root rank on each node will have a fully initialized controller
         if (ppn1_comm != MPI_COMM_NULL) {
             m_is_node_root = true;
+            m_ppn1_comm = ppn1_comm;
             struct geopm_plugin_description_s plugin_desc;
             int rank;
             check_mpi(MPI_Comm_rank(ppn1_comm, &rank));
             if (!rank) { // We are the root of the tree
+                if (geopm_env_do_policy_watch()) {
+                    m_global_policy->watch();
+                }
                 plugin_desc.tree_decider[NAME_MAX - 1] = '\0';
                 plugin_desc.leaf_decider[NAME_MAX - 1] = '\0';
                 plugin_desc.platform[NAME_MAX - 1] = '\0';
@@ -237,17 +248,30 @@ namespace geopm
             check_mpi(MPI_Comm_size(ppn1_comm, &num_nodes));
 
             if (num_nodes > 1) {
-                int num_fan_out = 1;
-                std::vector<int> fan_out(num_fan_out);
-                fan_out[0] = num_nodes;
+                int max_fan_out = geopm_env_max_fan_out() ? geopm_env_max_fan_out() : M_MAX_FAN_OUT;
+                int num_fan_out = geopm_env_tree_depth();
+                std::vector<int> fan_out;
 
-                while (fan_out[0] > M_MAX_FAN_OUT && fan_out[num_fan_out - 1] != 1) {
-                    ++num_fan_out;
-                    fan_out.resize(num_fan_out);
+                if (max_fan_out < 2 || num_fan_out < 0) {
+                    throw Exception("Controller::Controller(): invalid tree fan out or depth", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                if (num_fan_out) {
+                    fan_out.resize(num_fan_out, 0);
                     check_mpi(MPI_Dims_create(num_nodes, num_fan_out, fan_out.data()));
                 }
+                else {
+                    num_fan_out = 1;
+                    fan_out.resize(num_fan_out);
+                    fan_out[0] = num_nodes;
+                    while (fan_out[0] > max_fan_out && fan_out[num_fan_out - 1] != 1) {
+                        ++num_fan_out;
+                        fan_out.resize(num_fan_out);
+                        std::fill(fan_out.begin(), fan_out.end(), 0);
+                        check_mpi(MPI_Dims_create(num_nodes, num_fan_out, fan_out.data()));
+                    }
+                }
 
-                if (num_fan_out > 1 && fan_out[num_fan_out - 1] == 1) {
+                while (num_fan_out > 1 && fan_out[num_fan_out - 1] == 1) {
                     --num_fan_out;
                     fan_out.resize(num_fan_out);
                 }
@@ -269,6 +293,7 @@ namespace geopm
 
             m_last_sample_msg.resize(num_level);
             std::fill(m_last_sample_msg.begin(), m_last_sample_msg.end(), GEOPM_SAMPLE_INVALID);
+            m_last_region_runtime.resize(num_level);
 
             m_platform_factory = new PlatformFactory;
             m_platform = m_platform_factory->platform(plugin_desc.platform);
@@ -357,6 +382,7 @@ namespace geopm
         delete m_tree_comm;
         delete m_sampler;
         delete m_sample_regulator;
+        delete m_policy_cache;
     }
 
 
@@ -374,6 +400,9 @@ namespace geopm
             m_platform->init_transform(cpu_rank);
             m_sample_regulator = new SampleRegulator(cpu_rank);
             m_is_connected = true;
+            if (strlen(geopm_env_policy_cache())) {
+                load_policy_cache();
+            }
         }
     }
 
@@ -484,7 +513,9 @@ namespace geopm
     {
         int level;
         struct geopm_sample_message_s sample_msg;
-        std::vector<struct geopm_sample_message_s> child_sample(m_max_fanout);
+        std::vector<struct geopm_sample_message_s> region_sample_msg;
+        std::vector<std::vector<struct geopm_sample_message_s> > child_sample(m_max_fanout);
+        std::vector<int> child_age(m_max_fanout);
         std::vector<struct geopm_policy_message_s> child_policy_msg(m_max_fanout);
         size_t length;
         struct geopm_time_s loop_t1;
@@ -499,10 +530,10 @@ namespace geopm
         for (level = 0; !m_do_shutdown && level < m_tree_comm->num_level(); ++level) {
             if (level) {
                 try {
-                    m_tree_comm->get_sample(level, child_sample);
-                    // use .begin() because map has only one entry
-                    auto it = m_region[level].begin();
-                    (*it).second->insert(child_sample);
+                    m_tree_comm->get_sample(level, child_sample, child_age);
+                    insert_child_sample(level, child_sample, child_age);
+                    // GEOPM_REGION_ID_OUTER is inserted at construction
+                    auto it = m_region[level].find(GEOPM_REGION_ID_OUTER);
                     if (m_tree_decider[level]->update_policy(*((*it).second), *(m_policy[level]))) {
                        m_policy[level]->policy_message(GEOPM_REGION_ID_OUTER, m_last_policy_msg[level], child_policy_msg);
                        m_tree_comm->send_policy(level - 1, child_policy_msg);
@@ -546,7 +577,7 @@ namespace geopm
                             auto tmp_it = m_region[level].insert(
                                           std::pair<uint64_t, Region *> ((*sample_it).second.region_id,
                                           new Region((*sample_it).second.region_id,
-                                                     GEOPM_POLICY_HINT_UNKNOWN,
+                                                     geopm_region_id_hint((*sample_it).second.region_id),
                                                      m_platform->num_control_domain(),
                                                      level)));
                             region_it = tmp_it.first;
@@ -631,18 +662,29 @@ namespace geopm
                 auto mpi_it = m_region[level].find(GEOPM_REGION_ID_MPI);
                 // GEOPM_REGION_ID_MPI is inserted at construction
                 struct geopm_sample_message_s mpi_sample;
-                (*mpi_it).second->sample_message(mpi_sample);
+                (*mpi_it).second->aggregate_sample_message(mpi_sample);
                 if (sample_msg.signal[GEOPM_SAMPLE_TYPE_RUNTIME] != m_outer_sync_time) {
                     m_outer_sync_time = sample_msg.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
                     m_is_outer_changed = true;
-                    sample_msg.signal[GEOPM_SAMPLE_TYPE_RUNTIME] -= mpi_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+                    // Time spent waiting in MPI since the last outer-sync
+                    double mpi_runtime = std::min(mpi_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] - m_mpi_sync_time,
+                                                  sample_msg.signal[GEOPM_SAMPLE_TYPE_RUNTIME]);
+                    m_mpi_sync_time = mpi_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+                    sample_msg.signal[GEOPM_SAMPLE_TYPE_RUNTIME] -= mpi_runtime;
+                    sample_msg.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] = mpi_runtime;
+                    m_outer_sample = sample_msg;
                 }
+                // The sample is sent once the policy has converged,
+                // which may be on a later pass, so send the one with
+                // the slack of its iteration removed.
+                sample_msg = m_outer_sample;
                 m_do_shutdown = m_sampler->do_shutdown();
             }
             if (level != m_tree_comm->root_level() &&
                 m_policy[level]->is_converged(m_region_id_all) &&
                 m_is_outer_changed) {
-                m_tree_comm->send_sample(level, sample_msg);
+                region_sample_message(level, sample_msg, region_sample_msg);
+                m_tree_comm->send_sample(level, region_sample_msg);
                 m_last_sample_msg[level] = sample_msg;
                 m_is_outer_changed = false;
             }
@@ -650,6 +692,9 @@ namespace geopm
         if (m_do_shutdown && m_sampler->do_report()) {
             generate_report();
         }
+        if (m_do_shutdown && m_policy_cache) {
+            save_policy_cache();
+        }
     }
 
     void Controller::override_telemetry(double progress)
@@ -670,7 +715,7 @@ namespace geopm
                 auto tmp_it = m_region[level].insert(
                                   std::pair<uint64_t, Region *> (m_region_id_all,
                                           new Region(m_region_id_all,
-                                                     GEOPM_POLICY_HINT_UNKNOWN,
+                                                     geopm_region_id_hint(m_region_id_all),
                                                      m_platform->num_control_domain(),
                                                      level)));
                 it = tmp_it.first;
@@ -685,6 +730,89 @@ namespace geopm
         }
     }
 
+    void Controller::insert_child_sample(int level, const std::vector<std::vector<struct geopm_sample_message_s> > &child_sample, const std::vector<int> &child_age)
+    {
+        int num_child = m_tree_comm->level_size(level - 1);
+        std::vector<struct geopm_sample_message_s> region_sample(num_child);
+        std::vector<int> region_age(num_child);
+        std::map<uint64_t, std::vector<bool> > is_reported;
+
+        for (int child = 0; child < num_child; ++child) {
+            if (child_age[child]) {
+                // A reused child sample carries no new region data
+                continue;
+            }
+            // The first sample is always for the outer sync region
+            for (size_t i = 1; i < child_sample[child].size(); ++i) {
+                auto reported_it = is_reported.insert(
+                                       std::pair<uint64_t, std::vector<bool> >(child_sample[child][i].region_id,
+                                                                               std::vector<bool>(num_child, false))).first;
+                (*reported_it).second[child] = true;
+            }
+        }
+        is_reported[GEOPM_REGION_ID_OUTER] = std::vector<bool>(num_child, true);
+        for (auto reported_it = is_reported.begin(); reported_it != is_reported.end(); ++reported_it) {
+            uint64_t region_id = (*reported_it).first;
+            auto region_it = m_region[level].find(region_id);
+            if (region_it == m_region[level].end()) {
+                region_it = m_region[level].insert(
+                                std::pair<uint64_t, Region *> (region_id,
+                                        new Region(region_id,
+                                                   geopm_region_id_hint(region_id),
+                                                   num_child,
+                                                   level))).first;
+            }
+            Region *curr_region = (*region_it).second;
+            for (int child = 0; child < num_child; ++child) {
+                if (region_id == GEOPM_REGION_ID_OUTER) {
+                    region_sample[child] = child_sample[child][0];
+                    region_age[child] = child_age[child];
+                }
+                else if ((*reported_it).second[child]) {
+                    region_sample[child] = *std::find_if(child_sample[child].begin() + 1, child_sample[child].end(),
+                                                         [region_id](const struct geopm_sample_message_s &sample) {
+                                                             return sample.region_id == region_id;
+                                                         });
+                    region_age[child] = child_age[child];
+                }
+                else {
+                    curr_region->domain_sample_message(child, region_sample[child]);
+                    region_age[child] = curr_region->sample_age(child) + 1;
+                }
+            }
+            curr_region->insert(region_sample, region_age);
+        }
+    }
+
+    void Controller::region_sample_message(int level, const struct geopm_sample_message_s &outer_sample, std::vector<struct geopm_sample_message_s> &sample)
+    {
+        struct geopm_sample_message_s agg_sample;
+        std::vector<std::pair<double, Region *> > active;
+
+        for (auto it = m_region[level].begin(); it != m_region[level].end(); ++it) {
+            if ((*it).first != GEOPM_REGION_ID_OUTER) {
+                (*it).second->aggregate_sample_message(agg_sample);
+                double runtime = agg_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] - m_last_region_runtime[level][(*it).first];
+                if (runtime > 0.0) {
+                    active.push_back(std::pair<double, Region *>(runtime, (*it).second));
+                }
+            }
+        }
+        size_t num_region = std::min(active.size(), (size_t)TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION - 1);
+        std::partial_sort(active.begin(), active.begin() + num_region, active.end(),
+                          [](const std::pair<double, Region *> &a, const std::pair<double, Region *> &b) {
+                              return a.first > b.first;
+                          });
+        sample.resize(num_region + 1);
+        sample[0] = outer_sample;
+        for (size_t i = 0; i < num_region; ++i) {
+            Region *curr_region = active[i].second;
+            curr_region->sample_message(sample[i + 1]);
+            curr_region->aggregate_sample_message(agg_sample);
+            m_last_region_runtime[level][curr_region->identifier()] = agg_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+        }
+    }
+
     void Controller::enforce_child_policy(int level, const Policy &policy) /// @todo this method is *never* called
     {
         if (!m_is_node_root) {
@@ -754,7 +882,7 @@ namespace geopm
                 name = "unmarked region";
             }
             else {
-                auto region_it = region.find(region_id);
+                auto region_it = region.find(geopm_region_id_set_hint(GEOPM_POLICY_HINT_UNKNOWN, region_id));
                 if (region_it != region.end()) {
                     name = (*region_it).second;
                 }
@@ -767,6 +895,98 @@ namespace geopm
         report.close();
     }
 
+    void Controller::load_policy_cache(void)
+    {
+        int rank;
+        int num_node;
+        std::string cache_path(geopm_env_policy_cache());
+        std::string cache_str;
+
+        check_mpi(MPI_Comm_rank(m_ppn1_comm, &rank));
+        check_mpi(MPI_Comm_size(m_ppn1_comm, &num_node));
+        m_policy_cache = new PolicyCache(m_sampler->profile_key(), num_node);
+        if (!rank) {
+            try {
+                m_policy_cache->read(cache_path);
+            }
+            catch (Exception ex) {
+                // A bad cache only costs the warm start
+                std::cerr << "Warning: <geopm> Ignoring policy cache: " << ex.what() << std::endl;
+                delete m_policy_cache;
+                m_policy_cache = new PolicyCache(m_sampler->profile_key(), num_node);
+            }
+            std::ostringstream cache_stream;
+            m_policy_cache->write(cache_stream);
+            cache_str = cache_stream.str();
+        }
+        int length = cache_str.size();
+        check_mpi(MPI_Bcast(&length, 1, MPI_INT, 0, m_ppn1_comm));
+        if (length) {
+            cache_str.resize(length);
+            check_mpi(MPI_Bcast(&cache_str[0], length, MPI_CHAR, 0, m_ppn1_comm));
+            if (rank) {
+                std::istringstream cache_stream(cache_str);
+                m_policy_cache->read(cache_stream);
+            }
+        }
+        for (int level = 0; level < m_tree_comm->num_level(); ++level) {
+            m_policy_cache->seed(rank, level, *(m_policy[level]));
+        }
+    }
+
+    void Controller::save_policy_cache(void)
+    {
+        int rank;
+        int num_node;
+        std::string cache_str;
+
+        check_mpi(MPI_Comm_rank(m_ppn1_comm, &rank));
+        check_mpi(MPI_Comm_size(m_ppn1_comm, &num_node));
+        if (rank) {
+            // Only send what was learned in this run, the root
+            // still holds the entries read from the file.
+            PolicyCache node_cache(m_sampler->profile_key(), num_node);
+            for (int level = 0; level < m_tree_comm->num_level(); ++level) {
+                node_cache.insert(rank, level, *(m_policy[level]));
+            }
+            std::ostringstream cache_stream;
+            node_cache.write(cache_stream);
+            cache_str = cache_stream.str();
+        }
+        else {
+            for (int level = 0; level < m_tree_comm->num_level(); ++level) {
+                m_policy_cache->insert(rank, level, *(m_policy[level]));
+            }
+        }
+        int length = cache_str.size();
+        std::vector<int> length_all(rank ? 0 : num_node);
+        std::vector<int> displ(rank ? 0 : num_node);
+        std::string cache_all;
+        check_mpi(MPI_Gather(&length, 1, MPI_INT, length_all.data(), 1, MPI_INT, 0, m_ppn1_comm));
+        if (!rank) {
+            int total = 0;
+            for (int i = 0; i < num_node; ++i) {
+                displ[i] = total;
+                total += length_all[i];
+            }
+            cache_all.resize(total);
+        }
+        check_mpi(MPI_Gatherv((void *)cache_str.data(), length, MPI_CHAR,
+                              (void *)cache_all.data(), length_all.data(), displ.data(), MPI_CHAR, 0, m_ppn1_comm));
+        if (!rank) {
+            try {
+                std::istringstream cache_stream(cache_all);
+                m_policy_cache->read(cache_stream);
+                m_policy_cache->write(std::string(geopm_env_policy_cache()));
+            }
+            catch (Exception ex) {
+                std::cerr << "Warning: <geopm> Unable to save policy cache: " << ex.what() << std::endl;
+            }
+        }
+        delete m_policy_cache;
+        m_policy_cache = NULL;
+    }
+
     void Controller::reset(void)
     {
         geopm_error_destroy_shmem();
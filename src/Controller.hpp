@@ -46,6 +46,7 @@
 #include "GlobalPolicy.hpp"
 #include "Profile.hpp"
 #include "Tracer.hpp"
+#include "PolicyCache.hpp"
 #include "geopm_time.h"
 #include "geopm_plugin.h"
 
@@ -174,10 +175,38 @@ namespace geopm
             void walk_up(void);
             void override_telemetry(double progress);
             void update_region(void);
+            /// @brief Insert the region samples sent by the children
+            ///        of a tree level.
+            ///
+            /// The first sample from each child is for the outer
+            /// sync region.  The others are for whichever regions
+            /// were most active on the child, and a child that did
+            /// not report a region has its last sample for that
+            /// region reused with its age incremented.
+            void insert_child_sample(int level, const std::vector<std::vector<struct geopm_sample_message_s> > &child_sample, const std::vector<int> &child_age);
+            /// @brief Build the samples to send up from a level.
+            ///
+            /// Starts with the outer sync sample followed by those
+            /// regions that accumulated the most runtime since they
+            /// were last sent, up to the capacity of one message.
+            void region_sample_message(int level, const struct geopm_sample_message_s &outer_sample, std::vector<struct geopm_sample_message_s> &sample);
+            /// @brief Seed the policies with the targets saved by an
+            ///        earlier run of the application.
+            ///
+            /// The root reads the file named by GEOPM_POLICY_CACHE
+            /// and broadcasts the entries for the profile to all
+            /// nodes.
+            void load_policy_cache(void);
+            /// @brief Save the targets of the converged regions.
+            ///
+            /// The entries from all nodes are gathered to the root
+            /// which merges them into the file named by
+            /// GEOPM_POLICY_CACHE.
+            void save_policy_cache(void);
             bool m_is_node_root;
             int m_max_fanout;
             std::vector<int> m_fan_out;
-            const GlobalPolicy *m_global_policy;
+            GlobalPolicy *m_global_policy;
             TreeCommunicatorBase *m_tree_comm;
             std::vector<Decider *> m_tree_decider;
             Decider *m_leaf_decider;
@@ -195,6 +224,9 @@ namespace geopm
             std::vector<Policy *> m_policy;
             std::vector<struct geopm_policy_message_s> m_last_policy_msg;
             std::vector<struct geopm_sample_message_s> m_last_sample_msg;
+            // Per level map from region identifier to the aggregate
+            // runtime of the region when it was last sent up the tree
+            std::vector<std::map<uint64_t, double> > m_last_region_runtime;
             std::vector<uint64_t> m_region_id;
             uint64_t m_region_id_all;
             bool m_do_shutdown;
@@ -204,7 +236,13 @@ namespace geopm
             bool m_is_in_outer;
             int m_rank_per_node;
             double m_outer_sync_time;
+            double m_mpi_sync_time;
             bool m_is_outer_changed;
+            // Outer-sync sample of the last completed iteration with
+            // its MPI wait removed, held until it is sent up the tree
+            struct geopm_sample_message_s m_outer_sample;
+            MPI_Comm m_ppn1_comm;
+            PolicyCache *m_policy_cache;
     };
 }
 
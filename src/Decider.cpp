@@ -57,6 +57,11 @@ namespace geopm
         m_lower_bound = lower_bound;
     }
 
+    double Decider::memory_frequency(void) const
+    {
+        return 0.5 * (m_lower_bound + m_upper_bound);
+    }
+
     bool Decider::update_policy(const struct geopm_policy_message_s &policy, Policy &curr_policy)
     {
         bool result = false;
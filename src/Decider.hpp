@@ -65,6 +65,14 @@ namespace geopm
             /// @param [in] lower_bound The lower control bound.
             ///
             virtual void bound(double upper_bound, double lower_bound);
+            /// @brief Frequency for regions registered with
+            /// GEOPM_POLICY_HINT_MEMORY when the control is frequency.
+            ///
+            /// Shared by the frequency deciders so that the hint has
+            /// the same meaning in each of them.
+            ///
+            /// @return The midpoint of the control bounds.
+            double memory_frequency(void) const;
             /// @brief Updates the power split among power control domains when
             /// recieving a new global budget, vitual.
             virtual bool update_policy(const struct geopm_policy_message_s &policy_msg, Policy &curr_policy);
@@ -56,13 +56,15 @@ namespace geopm
 {
 
     DeciderFactory::DeciderFactory()
+        : m_is_builtin_enabled(true)
     {
-        // register all the deciders we know about
+        // register the plugin deciders, the built in decider is only
+        // created by decider() when no plugin matches
         geopm_plugin_load(GEOPM_PLUGIN_TYPE_DECIDER, (struct geopm_factory_c *)this);
-        register_decider(new StaticPolicyDecider(), NULL);
     }
 
     DeciderFactory::DeciderFactory(Decider *decider)
+        : m_is_builtin_enabled(false)
     {
         register_decider(decider, NULL);
     }
@@ -88,6 +90,13 @@ namespace geopm
                 break;
             }
         }
+        if (!result && m_is_builtin_enabled) {
+            std::unique_ptr<Decider> builtin(new StaticPolicyDecider());
+            if (builtin->decider_supported(description)) {
+                result = builtin->clone();
+                register_decider(builtin.release(), NULL);
+            }
+        }
         if (!result) {
             // If we get here, no acceptable decider was found
             throw Exception("decider: " + description, GEOPM_ERROR_DECIDER_UNSUPPORTED, __FILE__, __LINE__);
@@ -43,11 +43,12 @@ namespace geopm
     /// @brief Factory object managing decider objects.
     ///
     /// The DeciderFactory manages all instances of Decider objects. During
-    /// construction the factory creates instances of all built in Decider classes
-    /// as well as any Decider plugins present on the system. All Deciders then register
-    /// themselves with the factory. The factory returns an appropriate Decider object
-    /// when queried with a description string. The factory deletes all Decider objects
-    /// on destruction.
+    /// construction the factory creates instances of any Decider plugins
+    /// present on the system, the built in Decider classes are created only
+    /// when requested. All Deciders then register themselves with the
+    /// factory. The factory returns an appropriate Decider object when
+    /// queried with a description string. The factory deletes all Decider
+    /// objects on destruction.
     class DeciderFactory
     {
         public:
@@ -84,6 +85,9 @@ namespace geopm
             // @brief Holds all registered concrete Decider instances
             std::list<Decider*> m_decider_list;
             std::list<void *> m_dl_ptr_list;
+            // @brief False for the testing constructor, which only
+            //        uses the decider it is given.
+            bool m_is_builtin_enabled;
     };
 
 }
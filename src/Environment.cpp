@@ -32,9 +32,13 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <limits.h>
 #include <string>
 
 #include "geopm_env.h"
+#include "geopm_error.h"
+#include "Exception.hpp"
 
 namespace geopm
 {
@@ -47,6 +51,7 @@ namespace geopm
             virtual ~Environment();
             const char *report(void) const;
             const char *policy(void) const;
+            const char *policy_cache(void) const;
             const char *shmkey(void) const;
             const char *trace(void) const;
             const char *plugin_path(void) const;
@@ -56,18 +61,34 @@ namespace geopm
             int do_trace(void) const;
             int do_ignore_affinity() const;
             int do_profile() const;
+            int do_tree_rma() const;
+            int do_policy_watch() const;
+            int max_sample_age(void) const;
+            int max_fan_out(void) const;
+            int tree_depth(void) const;
+            const char *tree_topology(void) const;
         private:
+            /// @brief Parse an environment variable holding a
+            ///        non-negative integer, zero if it is not set.
+            static int non_negative_env(const char *name);
             const std::string m_report_env;
             const std::string m_policy_env;
+            const std::string m_policy_cache_env;
             const std::string m_shmkey_env;
             const std::string m_trace_env;
             const std::string m_plugin_path_env;
+            const std::string m_tree_topology_env;
             const int m_report_verbosity;
             int m_pmpi_ctl;
             const bool m_do_region_barrier;
             const bool m_do_trace;
             const bool m_do_ignore_affinity;
             bool m_do_profile;
+            const bool m_do_tree_rma;
+            const bool m_do_policy_watch;
+            const int m_max_sample_age;
+            const int m_max_fan_out;
+            const int m_tree_depth;
     };
 
     static const Environment &environment(void)
@@ -79,9 +100,11 @@ namespace geopm
     Environment::Environment()
         : m_report_env(getenv("GEOPM_REPORT") ? getenv("GEOPM_REPORT") : "")
         , m_policy_env(getenv("GEOPM_POLICY") ? getenv("GEOPM_POLICY") : "")
+        , m_policy_cache_env(getenv("GEOPM_POLICY_CACHE") ? getenv("GEOPM_POLICY_CACHE") : "")
         , m_shmkey_env(getenv("GEOPM_SHMKEY") ? getenv("GEOPM_SHMKEY") : "/geopm-shm")
         , m_trace_env(getenv("GEOPM_TRACE") ? getenv("GEOPM_TRACE") : "")
         , m_plugin_path_env(getenv("GEOPM_PLUGIN_PATH") ? getenv("GEOPM_PLUGIN_PATH") : "")
+        , m_tree_topology_env(getenv("GEOPM_TREE_TOPOLOGY") ? getenv("GEOPM_TREE_TOPOLOGY") : "")
         , m_report_verbosity(getenv("GEOPM_REPORT_VERBOSITY") ? stol(std::string(getenv("GEOPM_REPORT_VERBOSITY"))) :
                              (m_report_env.size() ? 1 : 0))
         , m_do_region_barrier(getenv("GEOPM_REGION_BARRIER") != NULL)
@@ -90,6 +113,11 @@ namespace geopm
         , m_do_profile(m_report_env.length() ||
                        m_trace_env.length() ||
                        getenv("GEOPM_PROFILE") != NULL)
+        , m_do_tree_rma(getenv("GEOPM_TREE_RMA") != NULL)
+        , m_do_policy_watch(getenv("GEOPM_POLICY_WATCH") != NULL)
+        , m_max_sample_age(non_negative_env("GEOPM_MAX_SAMPLE_AGE"))
+        , m_max_fan_out(non_negative_env("GEOPM_MAX_FAN_OUT"))
+        , m_tree_depth(non_negative_env("GEOPM_TREE_DEPTH"))
     {
         char *pmpi_ctl_env  = getenv("GEOPM_PMPI_CTL");
         if (pmpi_ctl_env && !strncmp(pmpi_ctl_env, "process", strlen("process") + 1))  {
@@ -105,6 +133,23 @@ namespace geopm
         }
     }
 
+    int Environment::non_negative_env(const char *name)
+    {
+        int result = 0;
+        const char *env = getenv(name);
+        if (env) {
+            char *end = NULL;
+            errno = 0;
+            long value = strtol(env, &end, 10);
+            if (end == env || *end != '\0' || errno || value < 0 || value > INT_MAX) {
+                throw Exception("Environment: " + std::string(name) + " must be a non-negative integer, not \"" + env + "\"",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            result = value;
+        }
+        return result;
+    }
+
     Environment::~Environment()
     {
 
@@ -120,6 +165,11 @@ namespace geopm
         return m_policy_env.c_str();
     }
 
+    const char *Environment::policy_cache(void) const
+    {
+        return m_policy_cache_env.c_str();
+    }
+
     const char *Environment::shmkey(void) const
     {
         return m_shmkey_env.c_str();
@@ -164,6 +214,36 @@ namespace geopm
     {
         return m_do_profile;
     }
+
+    int Environment::do_tree_rma() const
+    {
+        return m_do_tree_rma;
+    }
+
+    int Environment::do_policy_watch() const
+    {
+        return m_do_policy_watch;
+    }
+
+    int Environment::max_sample_age(void) const
+    {
+        return m_max_sample_age;
+    }
+
+    int Environment::max_fan_out(void) const
+    {
+        return m_max_fan_out;
+    }
+
+    int Environment::tree_depth(void) const
+    {
+        return m_tree_depth;
+    }
+
+    const char *Environment::tree_topology(void) const
+    {
+        return m_tree_topology_env.c_str();
+    }
 }
 
 extern "C"
@@ -173,6 +253,11 @@ extern "C"
         return geopm::environment().policy();
     }
 
+    const char *geopm_env_policy_cache(void)
+    {
+        return geopm::environment().policy_cache();
+    }
+
     const char *geopm_env_shmkey(void)
     {
         return geopm::environment().shmkey();
@@ -222,4 +307,34 @@ extern "C"
     {
         return geopm::environment().do_profile();
     }
+
+    int geopm_env_do_tree_rma(void)
+    {
+        return geopm::environment().do_tree_rma();
+    }
+
+    int geopm_env_do_policy_watch(void)
+    {
+        return geopm::environment().do_policy_watch();
+    }
+
+    int geopm_env_max_sample_age(void)
+    {
+        return geopm::environment().max_sample_age();
+    }
+
+    int geopm_env_max_fan_out(void)
+    {
+        return geopm::environment().max_fan_out();
+    }
+
+    int geopm_env_tree_depth(void)
+    {
+        return geopm::environment().tree_depth();
+    }
+
+    const char *geopm_env_tree_topology(void)
+    {
+        return geopm::environment().tree_topology();
+    }
 }
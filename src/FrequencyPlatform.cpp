@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "FrequencyPlatform.hpp"
+#include "geopm_message.h"
+#include "config.h"
+
+namespace geopm
+{
+    FrequencyPlatform::FrequencyPlatform()
+        : RAPLPlatform(GEOPM_CONTROL_DOMAIN_FREQUENCY, "frequency")
+        , m_frequency_domain_type(GEOPM_DOMAIN_CPU)
+        , m_num_frequency_domain(0)
+        , m_min_frequency(0.0)
+        , m_max_frequency(0.0)
+    {
+
+    }
+
+    FrequencyPlatform::~FrequencyPlatform()
+    {
+
+    }
+
+    int FrequencyPlatform::control_domain()
+    {
+        return GEOPM_CONTROL_DOMAIN_FREQUENCY;
+    }
+
+    void FrequencyPlatform::set_implementation(PlatformImp* platform_imp)
+    {
+        RAPLPlatform::set_implementation(platform_imp);
+
+        m_frequency_domain_type = m_imp->frequency_control_domain();
+        m_num_frequency_domain = m_imp->num_domain(m_frequency_domain_type);
+        if (m_num_frequency_domain < m_num_package ||
+            m_num_frequency_domain % m_num_package) {
+            throw Exception("FrequencyPlatform::set_implementation(): frequency control domains do not evenly divide packages",
+                            GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
+        }
+        m_imp->bound(GEOPM_TELEMETRY_TYPE_FREQUENCY, m_max_frequency, m_min_frequency);
+        m_control_desc.reserve(m_num_frequency_domain);
+        m_last_frequency.resize(m_num_frequency_domain);
+        std::fill(m_last_frequency.begin(), m_last_frequency.end(), NAN);
+    }
+
+    void FrequencyPlatform::bound(double &upper_bound, double &lower_bound)
+    {
+        upper_bound = m_max_frequency;
+        lower_bound = m_min_frequency;
+    }
+
+    void FrequencyPlatform::enforce_policy(uint64_t region_id, Policy &policy) const
+    {
+        std::vector<double> target(policy.num_domain());
+        policy.target(region_id, target);
+
+        if ((int)target.size() != m_num_package &&
+            (int)target.size() != m_num_frequency_domain) {
+            throw geopm::Exception("FrequencyPlatform::enforce_policy: Policy size does not match domains of control", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+
+        int domain_per_target = m_num_frequency_domain / target.size();
+        m_control_desc.clear();
+        for (int i = 0; i < m_num_frequency_domain; ++i) {
+            double frequency = target[i / domain_per_target];
+            if (frequency < m_min_frequency) {
+                frequency = m_min_frequency;
+            }
+            if (frequency > m_max_frequency) {
+                frequency = m_max_frequency;
+            }
+            // Only write domains whose frequency changed
+            if (frequency != m_last_frequency[i]) {
+                m_control_desc.push_back({m_frequency_domain_type, i, GEOPM_TELEMETRY_TYPE_FREQUENCY, frequency});
+            }
+        }
+        if (m_control_desc.size()) {
+            m_imp->batch_write_control(m_control_desc);
+            for (auto it = m_control_desc.begin(); it != m_control_desc.end(); ++it) {
+                m_last_frequency[(*it).device_index] = (*it).value;
+            }
+        }
+    }
+
+    void FrequencyPlatform::invalidate_control(void) const
+    {
+        // IA32_PERF_CTL may be written behind our back, so the next
+        // enforce_policy() writes every domain.
+        std::fill(m_last_frequency.begin(), m_last_frequency.end(), NAN);
+    }
+} //geopm
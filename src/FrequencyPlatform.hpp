@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FREQUENCYPLATFORM_HPP_INCLUDE
+#define FREQUENCYPLATFORM_HPP_INCLUDE
+
+#include "RAPLPlatform.hpp"
+
+namespace geopm
+{
+    /// @brief This class provides an implementation of a concrete platform
+    /// supporting processors which use P-states for frequency control.
+    /// Telemetry is gathered in the same way as the RAPLPlatform, but
+    /// policy targets are frequencies which are applied to each
+    /// frequency control domain (per-CPU or per-package depending on
+    /// the PlatformImp).
+    class FrequencyPlatform : public RAPLPlatform
+    {
+        public:
+            /// @brief Default constructor.
+            FrequencyPlatform();
+            /// @brief Default destructor
+            virtual ~FrequencyPlatform();
+            virtual int control_domain(void);
+            virtual void set_implementation(PlatformImp* platform_imp);
+            /// @brief Enforce the frequency targets of a policy.
+            ///
+            /// The policy may either have one target per package, in
+            /// which case every frequency domain in the package is set
+            /// to the package target, or one target per frequency
+            /// control domain.  Only domains whose target changed
+            /// since the last call are written, and all writes are
+            /// issued as a single batch.
+            virtual void enforce_policy(uint64_t region_id, Policy &policy) const;
+            virtual void bound(double &upper_bound, double &lower_bound);
+        protected:
+            virtual void invalidate_control(void) const;
+            /// @brief The geopm_domain_type_e of frequency control.
+            int m_frequency_domain_type;
+            /// @brief Number of frequency control domains on the platform.
+            int m_num_frequency_domain;
+            /// @brief Lower bound of the frequency control.
+            double m_min_frequency;
+            /// @brief Upper bound of the frequency control.
+            double m_max_frequency;
+            /// @brief Control descriptors reused by enforce_policy().
+            mutable std::vector<struct geopm_signal_descriptor> m_control_desc;
+            /// @brief Last frequency written to each frequency domain.
+            mutable std::vector<double> m_last_frequency;
+    };
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/inotify.h>
 #include <fcntl.h>
 #include <system_error>
 #include <unistd.h>
@@ -47,6 +48,7 @@
 #include "GlobalPolicy.hpp"
 #include "Platform.hpp"
 #include "PlatformFactory.hpp"
+#include "SharedMemory.hpp"
 #include "config.h"
 
 extern "C"
@@ -320,6 +322,8 @@ namespace geopm
         ,m_is_shm_out(false)
         ,m_do_read(false)
         ,m_do_write(false)
+        ,m_shm_seq(1)
+        ,m_watch_fd(-1)
     {
         int shm_id;
         int err = 0;
@@ -355,11 +359,7 @@ namespace geopm
                     (void) umask(old_mask);
                     throw Exception("GlobalPolicy: Could not close file descriptor for root policy shared memory region", errno, __FILE__, __LINE__);
                 }
-                if (pthread_mutex_init(&(m_policy_shmem_out->lock), NULL) != 0) {
-                    munmap(m_policy_shmem_out, sizeof(struct m_policy_shmem_s));
-                    (void) umask(old_mask);
-                    throw Exception("GlobalPolicy: Could not initialize pthread mutex for shared memory region", errno, __FILE__, __LINE__);
-                }
+                m_policy_shmem_out->seq = 0;
                 umask(old_mask);
             }
             else if (m_in_config == m_out_config) {
@@ -371,11 +371,10 @@ namespace geopm
             m_do_read = true;
             if (m_in_config[0] == '/' && m_in_config.find_last_of('/') == 0) {
                 m_is_shm_in = true;
-                shm_id = shm_open(m_in_config.c_str(), O_RDWR, 0);
-
-                if (shm_id < 0) {
-                    throw Exception("GlobalPolicy: Could not open shared memory region for root policy", errno, __FILE__, __LINE__);
-                }
+                // Single attempt, but do not map a region the writer
+                // has not yet extended to the full policy size.
+                size_t shm_size = 0;
+                shm_id = shm_open_wait(m_in_config, sizeof(struct m_policy_shmem_s), 0.0, shm_size);
                 m_policy_shmem_in = (struct m_policy_shmem_s *) mmap(NULL, sizeof(struct m_policy_shmem_s),
                                     PROT_READ | PROT_WRITE, MAP_SHARED, shm_id, 0);
                 if (m_policy_shmem_in == MAP_FAILED) {
@@ -394,8 +393,11 @@ namespace geopm
 
     GlobalPolicy::~GlobalPolicy()
     {
+        if (m_watch_fd >= 0) {
+            (void) close(m_watch_fd);
+        }
         if (m_do_read && m_is_shm_in) {
-            if (munmap(m_policy_shmem_in, sizeof(struct geopm_policy_message_s))) {
+            if (munmap(m_policy_shmem_in, sizeof(struct m_policy_shmem_s))) {
 #ifdef GEOPM_DEBUG
             std::cerr << "Warning: " << Exception("GlobalPolicy: Could not unmap root policy shared memory region",
                                                   errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__).what() << std::endl;
@@ -403,7 +405,7 @@ namespace geopm
             }
         }
         if (m_do_write && m_is_shm_out) {
-            if (munmap(m_policy_shmem_out, sizeof(struct geopm_policy_message_s))) {
+            if (munmap(m_policy_shmem_out, sizeof(struct m_policy_shmem_s))) {
 #ifdef GEOPM_DEBUG
                 std::cerr << "Warning: " << Exception("GlobalPolicy: Could not unmap root policy shared memory region",
                                                       errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__).what() << std::endl;
@@ -470,9 +472,15 @@ namespace geopm
 
     void GlobalPolicy::policy_message(struct geopm_policy_message_s &policy_message)
     {
-        if (m_is_shm_in) {
+        // Only parse the shared memory again if the resource manager
+        // has written a new policy since the last read.
+        if (m_is_shm_in &&
+            __atomic_load_n(&(m_policy_shmem_in->seq), __ATOMIC_ACQUIRE) != m_shm_seq) {
             read();
         }
+        else if (m_watch_fd >= 0 && is_watch_changed()) {
+            reload_json();
+        }
         policy_message.mode = m_mode;
         policy_message.power_budget = m_power_budget_watts;
         policy_message.flags = m_flags.flags();
@@ -539,6 +547,70 @@ namespace geopm
         check_valid();
     }
 
+    void GlobalPolicy::watch(void)
+    {
+        if (!m_do_read || m_is_shm_in || m_watch_fd >= 0) {
+            return;
+        }
+        // Watch the directory rather than the file so that a file
+        // replaced by rename() is still seen.
+        size_t pos = m_in_config.find_last_of('/');
+        std::string dir_name = pos == std::string::npos ? "." : m_in_config.substr(0, pos + 1);
+        m_watch_name = pos == std::string::npos ? m_in_config : m_in_config.substr(pos + 1);
+        m_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_watch_fd < 0) {
+            throw Exception("GlobalPolicy::watch(): inotify_init1() failed", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (inotify_add_watch(m_watch_fd, dir_name.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            int err = errno;
+            (void) close(m_watch_fd);
+            m_watch_fd = -1;
+            throw Exception("GlobalPolicy::watch(): could not watch directory \"" + dir_name + "\"", err ? err : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    bool GlobalPolicy::is_watch_changed(void)
+    {
+        bool result = false;
+        char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+        ssize_t length;
+        while ((length = ::read(m_watch_fd, buffer, sizeof(buffer))) > 0) {
+            for (char *ptr = buffer; ptr < buffer + length; ) {
+                struct inotify_event *event = (struct inotify_event *)ptr;
+                if (event->len && m_watch_name == event->name) {
+                    result = true;
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return result;
+    }
+
+    void GlobalPolicy::reload_json(void)
+    {
+        int mode = m_mode;
+        int power_budget_watts = m_power_budget_watts;
+        unsigned long flags = m_flags.flags();
+        std::string tree_decider = m_tree_decider;
+        std::string leaf_decider = m_leaf_decider;
+        std::string platform = m_platform;
+        try {
+            read_json();
+            check_valid();
+        }
+        catch (Exception ex) {
+#ifdef GEOPM_DEBUG
+            std::cerr << "Warning: ignoring policy file update: " << ex.what() << std::endl;
+#endif
+            m_mode = mode;
+            m_power_budget_watts = power_budget_watts;
+            m_flags.flags(flags);
+            m_tree_decider = tree_decider;
+            m_leaf_decider = leaf_decider;
+            m_platform = platform;
+        }
+    }
+
     void GlobalPolicy::read_json(void)
     {
         std::string policy_string;
@@ -778,21 +850,31 @@ namespace geopm
 
     void GlobalPolicy::read_shm(void)
     {
-        int err;
-        err = pthread_mutex_lock(&(m_policy_shmem_in->lock));
-        if (err) {
-            throw Exception("GlobalPolicy::read_shm(): Could not lock shared memory region for root of tree", err, __FILE__, __LINE__);
-        }
-        m_mode = m_policy_shmem_in->policy.mode;
-        m_power_budget_watts = m_policy_shmem_in->policy.power_budget;
-        m_flags.flags(m_policy_shmem_in->policy.flags);
-        m_tree_decider = m_policy_shmem_in->plugin.tree_decider;
-        m_leaf_decider = m_policy_shmem_in->plugin.leaf_decider;
-        m_platform = m_policy_shmem_in->plugin.platform;
-        err = pthread_mutex_unlock(&(m_policy_shmem_in->lock));
-        if (err) {
-            throw Exception("GlobalPolicy::read(): Could not unlock shared memory region for root of tree", err, __FILE__, __LINE__);
-        }
+        uint64_t seq_begin = __atomic_load_n(&(m_policy_shmem_in->seq), __ATOMIC_ACQUIRE);
+        struct geopm_policy_message_s policy;
+        struct geopm_plugin_description_s plugin;
+        bool is_torn = true;
+        while (is_torn) {
+            while (seq_begin & 1) {
+                seq_begin = __atomic_load_n(&(m_policy_shmem_in->seq), __ATOMIC_ACQUIRE);
+            }
+            memcpy(&policy, &(m_policy_shmem_in->policy), sizeof(policy));
+            memcpy(&plugin, &(m_policy_shmem_in->plugin), sizeof(plugin));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            uint64_t seq_end = __atomic_load_n(&(m_policy_shmem_in->seq), __ATOMIC_RELAXED);
+            is_torn = (seq_end != seq_begin);
+            seq_begin = seq_end;
+        }
+        plugin.tree_decider[NAME_MAX - 1] = '\0';
+        plugin.leaf_decider[NAME_MAX - 1] = '\0';
+        plugin.platform[NAME_MAX - 1] = '\0';
+        m_mode = policy.mode;
+        m_power_budget_watts = policy.power_budget;
+        m_flags.flags(policy.flags);
+        m_tree_decider = plugin.tree_decider;
+        m_leaf_decider = plugin.leaf_decider;
+        m_platform = plugin.platform;
+        m_shm_seq = seq_begin;
     }
 
     void GlobalPolicy::write()
@@ -934,10 +1016,15 @@ namespace geopm
 
     void GlobalPolicy::write_shm(void)
     {
-        int err = pthread_mutex_lock(&(m_policy_shmem_out->lock));
-        if (err) {
-            throw Exception("GlobalPolicy: Could not lock shared memory region for resource manager", errno, __FILE__, __LINE__);
-        }
+        // Take the sequence count from even to odd to mark the write
+        // in progress, this also serializes concurrent writers.
+        uint64_t seq = __atomic_load_n(&(m_policy_shmem_out->seq), __ATOMIC_RELAXED);
+        while ((seq & 1) ||
+               !__atomic_compare_exchange_n(&(m_policy_shmem_out->seq), &seq, seq + 1, false,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            seq = __atomic_load_n(&(m_policy_shmem_out->seq), __ATOMIC_RELAXED);
+        }
+        __atomic_thread_fence(__ATOMIC_RELEASE);
         m_policy_shmem_out->policy.mode = m_mode;
         m_policy_shmem_out->policy.power_budget = m_power_budget_watts;
         m_policy_shmem_out->policy.flags = m_flags.flags();
@@ -947,10 +1034,7 @@ namespace geopm
         strncpy(m_policy_shmem_out->plugin.leaf_decider, m_leaf_decider.c_str(), NAME_MAX - 1);
         m_policy_shmem_out->plugin.platform[NAME_MAX - 1] = '\0';
         strncpy(m_policy_shmem_out->plugin.platform, m_platform.c_str(), NAME_MAX - 1);
-        err = pthread_mutex_unlock(&(m_policy_shmem_in->lock));
-        if (err) {
-            throw Exception("GlobalPolicy: Could not unlock shared memory region for resource manager", errno, __FILE__, __LINE__);
-        }
+        __atomic_store_n(&(m_policy_shmem_out->seq), seq + 2, __ATOMIC_RELEASE);
     }
 
     void GlobalPolicy::affinity_string(int value, std::string &name)
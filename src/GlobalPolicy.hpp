@@ -33,6 +33,7 @@
 #ifndef GLOBALPOLICY_HPP_INCLUDE
 #define GLOBALPOLICY_HPP_INCLUDE
 
+#include <stdint.h>
 #include <string>
 #include <fstream>
 #include <json-c/json.h>
@@ -104,7 +105,10 @@ namespace geopm
             /// @return String reference containing the description
             ///         of the requested platform
             const std::string &platform() const;
-            /// @brief Get a policy message from the policy object
+            /// @brief Get a policy message from the policy object.
+            ///        When reading from shared memory the policy is
+            ///        read again only if it has been written since the
+            ///        last read.
             /// @param [out] policy_message structure to be filled in
             void policy_message(struct geopm_policy_message_s &policy_message);
             /// @brief Set the policy power mode
@@ -156,6 +160,12 @@ namespace geopm
             /// GEOPM_MODE_FREQ_UNIFORM_STATIC, or
             /// GEOPM_MODE_FREQ_HYBRID_STATIC
             void enforce_static_mode();
+            /// @brief Watch the json input file with inotify so that
+            ///        policy_message() reads it again when it is
+            ///        rewritten or replaced.  A new policy that fails
+            ///        to parse or validate is discarded.  Has no
+            ///        effect when reading from shared memory.
+            void watch(void);
         protected:
             /// @brief Structure intended to be shared between
             /// the resource manager and the geopm
@@ -165,9 +175,14 @@ namespace geopm
                 /// @brief Enables the geopm runtime to know when the resource
                 ///        manager has initialized the power policy.
                 int is_init;
-                /// @brief Lock to ensure read/write consistency between the
-                ///        resource manager and the geopm runtime.
-                pthread_mutex_t lock;
+                /// @brief Sequence counter to ensure read/write
+                ///        consistency between the resource manager and
+                ///        the geopm runtime.  It is odd while a write
+                ///        is in progress and advances by two for each
+                ///        write, so it also serves as the generation
+                ///        of the policy.  Readers retry on a torn read
+                ///        and never block the writer.
+                uint64_t seq;
                 /// @brief Holds the job power policy as given by the resource
                 ///        manager.
                 struct geopm_policy_message_s policy;
@@ -180,6 +195,12 @@ namespace geopm
             void affinity_string(int value, std::string &name);
             void read_shm(void);
             void read_json(void);
+            /// @brief Read the json input file again, keeping the
+            ///        current policy if the new one is not valid.
+            void reload_json(void);
+            /// @brief Drain the inotify events without blocking.
+            /// @return True if the json input file has changed.
+            bool is_watch_changed(void);
             void read_json_mode(json_object *mode_obj);
             void read_json_options(json_object *option_obj);
             void write_shm(void);
@@ -214,6 +235,16 @@ namespace geopm
             struct m_policy_shmem_s *m_policy_shmem_in;
             /// @brief structure to use if writing out to shared memory
             struct m_policy_shmem_s *m_policy_shmem_out;
+            /// @brief sequence count of the last policy copied from
+            ///        shared memory, odd (never a stored count) until
+            ///        the first read.
+            uint64_t m_shm_seq;
+            /// @brief inotify file descriptor watching the directory
+            ///        of the json input file, or -1.
+            int m_watch_fd;
+            /// @brief file name of the json input file within the
+            ///        watched directory.
+            std::string m_watch_name;
     };
 
 }
@@ -52,6 +52,8 @@ namespace geopm
         , m_max_pp0_watts(100)
         , m_min_dram_watts(1)
         , m_max_dram_watts(100)
+        , m_min_freq(0.0)
+        , m_max_freq(0.0)
         , m_signal_msr_offset(M_L2_MISSES)
         , m_control_msr_pair(M_NUM_CONTROL)
         , M_KNL_MODEL_NAME("Knights Landing")
@@ -70,6 +72,9 @@ namespace geopm
         , M_UMASK_1(M_L2_PREFETCH_UMASK)
         , M_PKG_POWER_LIMIT_MASK(0x1800000018000ul)
         , M_DRAM_POWER_LIMIT_MASK(0x18000)
+        , M_COUNTER_MASK_32(0xffffffffULL)
+        , M_COUNTER_MASK_40(0xffffffffffULL)
+        , M_COUNTER_MASK_48(0xffffffffffffULL)
         , M_EXTRA_SIGNAL(1)
         , M_PLATFORM_ID(0x657)
     {
@@ -118,7 +123,8 @@ namespace geopm
                 lower_bound = m_min_dram_watts;
                 break;
             case GEOPM_TELEMETRY_TYPE_FREQUENCY:
-                throw Exception("KNLPlatformImp::bound(GEOPM_TELEMETRY_TYPE_FREQUENCY)", GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+                upper_bound = m_max_freq;
+                lower_bound = m_min_freq;
                 break;
             default:
                 throw geopm::Exception("KNLPlatformImp::bound(): Invalid control type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -219,7 +225,11 @@ namespace geopm
                     m_batch.numops = num_signal;
                     m_batch.ops = (struct m_msr_batch_op*)realloc(m_batch.ops, m_batch.numops * sizeof(struct m_msr_batch_op));
                 }
+                m_batch_overflow_idx.resize(num_signal);
+                m_batch_counter_mask.resize(num_signal);
+                m_batch_value.resize(num_signal);
 
+                int counter_idx = m_num_package * m_num_energy_signal;
                 for (auto it = signal_desc.begin(); it != signal_desc.end(); ++it) {
                     m_batch.ops[index].isrdmsr = 1;
                     m_batch.ops[index].err = 0;
@@ -242,27 +252,43 @@ namespace geopm
                     switch ((*it).signal_type) {
                         case GEOPM_TELEMETRY_TYPE_PKG_ENERGY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_RAPL_PKG_STATUS];
+                            m_batch_overflow_idx[index] = (*it).device_index * m_num_energy_signal + M_PKG_STATUS_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_32;
                             break;
                         case GEOPM_TELEMETRY_TYPE_DRAM_ENERGY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_RAPL_DRAM_STATUS];
+                            m_batch_overflow_idx[index] = (*it).device_index * m_num_energy_signal + M_DRAM_STATUS_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_32;
                             break;
                         case GEOPM_TELEMETRY_TYPE_FREQUENCY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_IA32_PERF_STATUS];
+                            m_batch_overflow_idx[index] = -1;
+                            m_batch_counter_mask[index] = ~0ULL;
                             break;
                         case GEOPM_TELEMETRY_TYPE_INST_RETIRED:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_INST_RETIRED];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_INST_RETIRED_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_CLK_UNHALTED_CORE];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_CORE_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_REF:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_CLK_UNHALTED_REF];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_REF_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_L2_MISSES + 2 * (m_batch.ops[index].cpu / cpu_per_tile)];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_L2_MISSES_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_48;
                             ++index;
                             m_batch.ops[index] = m_batch.ops[index - 1];
                             m_batch.ops[index].msr = m_signal_msr_offset[M_HW_L2_PREFETCH + 2 * (m_batch.ops[index].cpu / cpu_per_tile)];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_HW_L2_PREFETCH_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_48;
                             break;
                         default:
                             throw geopm::Exception("KNLPlatformImp::batch_read_signal: Invalid signal type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -273,50 +299,31 @@ namespace geopm
             }
 
             batch_msr_read();
+            batch_msr_overflow();
 
             signal_index = 0;
-            int offset_idx;
             for (auto it = signal_desc.begin(); it != signal_desc.end(); ++it) {
                 switch ((*it).signal_type) {
                     case GEOPM_TELEMETRY_TYPE_PKG_ENERGY:
-                        offset_idx = (*it).device_index * m_num_energy_signal + M_PKG_STATUS_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 32,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        (*it).value *= m_energy_units;
+                        (*it).value = (double)m_batch_value[signal_index++] * m_energy_units;
                         break;
                     case GEOPM_TELEMETRY_TYPE_DRAM_ENERGY:
-                        offset_idx = (*it).device_index * m_num_energy_signal + M_DRAM_STATUS_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 32,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        (*it).value *= m_dram_energy_units;
+                        (*it).value = (double)m_batch_value[signal_index++] * m_dram_energy_units;
                         break;
                     case GEOPM_TELEMETRY_TYPE_FREQUENCY:
-                        (*it).value = (double)((m_batch.ops[signal_index++].msrdata >> 8) & 0x0FF);
+                        (*it).value = (double)((m_batch_value[signal_index++] >> 8) & 0x0FF);
                         //convert to MHZ
                         (*it).value *= 0.1;
                         break;
                     case GEOPM_TELEMETRY_TYPE_INST_RETIRED:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_INST_RETIRED_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        break;
                     case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_CORE_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        break;
                     case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_REF:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_REF_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
+                        (*it).value = (double)m_batch_value[signal_index++];
                         break;
                     case GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_L2_MISSES_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 48,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_HW_L2_PREFETCH_OVERFLOW;
-                        (*it).value += msr_overflow(offset_idx, 48,
-                                                    m_batch.ops[signal_index++].msrdata);
+                        // Sum the L2 misses and hardware prefetches as integers
+                        (*it).value = (double)(m_batch_value[signal_index] + m_batch_value[signal_index + 1]);
+                        signal_index += 2;
                         break;
                     default:
                         throw geopm::Exception("KNLPlatformImp::read_signal: Invalid signal type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -372,6 +379,27 @@ namespace geopm
         }
     }
 
+    void KNLPlatformImp::batch_write_control(const std::vector<struct geopm_signal_descriptor> &control_desc)
+    {
+        std::vector<struct m_msr_access_s> access;
+        access.reserve(control_desc.size());
+        for (auto it = control_desc.begin(); it != control_desc.end(); ++it) {
+            if ((*it).signal_type == GEOPM_TELEMETRY_TYPE_FREQUENCY) {
+                // Gather P-state requests so they are written in one batch
+                struct m_msr_access_s curr;
+                curr.cpu = msr_cpu((*it).device_type, (*it).device_index);
+                curr.offset = m_control_msr_pair[M_IA32_PERF_CTL].first;
+                curr.mask = m_control_msr_pair[M_IA32_PERF_CTL].second;
+                curr.value = ((uint64_t)((*it).value * 10)) << 8;
+                access.push_back(curr);
+            }
+            else {
+                write_control((*it).device_type, (*it).device_index, (*it).signal_type, (*it).value);
+            }
+        }
+        batch_msr_write(access);
+    }
+
     void KNLPlatformImp::msr_initialize()
     {
         rapl_init();
@@ -384,29 +412,29 @@ namespace geopm
         size_t num_signal = m_num_energy_signal * m_num_package + (m_num_counter_signal + M_EXTRA_SIGNAL)  * m_num_tile;
         m_msr_value_last.resize(num_signal);
         m_msr_overflow_offset.resize(num_signal);
-        std::fill(m_msr_value_last.begin(), m_msr_value_last.end(), 0.0);
-        std::fill(m_msr_overflow_offset.begin(), m_msr_overflow_offset.end(), 0.0);
+        std::fill(m_msr_value_last.begin(), m_msr_value_last.end(), 0);
+        std::fill(m_msr_overflow_offset.begin(), m_msr_overflow_offset.end(), 0);
 
         //Save off the msr offsets for the signals we want to read to avoid a map lookup
         for (int i = 0; i < M_L2_MISSES; ++i) {
             switch (i) {
                 case M_RAPL_PKG_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("PKG_ENERGY_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PKG_ENERGY_STATUS).offset;
                     break;
                 case M_RAPL_DRAM_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("DRAM_ENERGY_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_DRAM_ENERGY_STATUS).offset;
                     break;
                 case M_IA32_PERF_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("IA32_PERF_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_IA32_PERF_STATUS).offset;
                     break;
                 case M_INST_RETIRED:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR0");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR0).offset;
                     break;
                 case M_CLK_UNHALTED_CORE:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR1");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR1).offset;
                     break;
                 case M_CLK_UNHALTED_REF:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR2");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR2).offset;
                     break;
                 default:
                     throw Exception("KNLPlatformImp: Index not enumerated",
@@ -415,16 +443,19 @@ namespace geopm
             }
         }
         for (int i = 0; i < m_num_tile; i++) {
-            std::string msr_name("C" + std::to_string(i) + "_MSR_PMON_CTR0");
-            m_signal_msr_offset[M_L2_MISSES + 2 * i] = msr_offset(msr_name);
-            msr_name = "C" + std::to_string(i) + "_MSR_PMON_CTR1";
-            m_signal_msr_offset[M_HW_L2_PREFETCH + 2 * i] = msr_offset(msr_name);
+            m_signal_msr_offset[M_L2_MISSES + 2 * i] = cbo_msr_handle(i, M_CBO_CTR0).offset;
+            m_signal_msr_offset[M_HW_L2_PREFETCH + 2 * i] = cbo_msr_handle(i, M_CBO_CTR1).offset;
         }
 
         //Save off the msr offsets and masks for the controls we want to write to avoid a map lookup
-        m_control_msr_pair[M_RAPL_PKG_LIMIT] = std::make_pair(msr_offset("PKG_POWER_LIMIT"), msr_mask("PKG_POWER_LIMIT") );
-        m_control_msr_pair[M_RAPL_DRAM_LIMIT] = std::make_pair(msr_offset("DRAM_POWER_LIMIT"), msr_mask("DRAM_POWER_LIMIT") );
-        m_control_msr_pair[M_IA32_PERF_CTL] = std::make_pair(msr_offset("IA32_PERF_CTL"), msr_mask("IA32_PERF_CTL") );
+        m_control_msr_pair[M_RAPL_PKG_LIMIT] = std::make_pair(msr_handle(M_MSR_PKG_POWER_LIMIT).offset, msr_handle(M_MSR_PKG_POWER_LIMIT).mask);
+        m_control_msr_pair[M_RAPL_DRAM_LIMIT] = std::make_pair(msr_handle(M_MSR_DRAM_POWER_LIMIT).offset, msr_handle(M_MSR_DRAM_POWER_LIMIT).mask);
+        m_control_msr_pair[M_IA32_PERF_CTL] = std::make_pair(msr_handle(M_MSR_IA32_PERF_CTL).offset, msr_handle(M_MSR_IA32_PERF_CTL).mask);
+
+        //Frequency bounds in units of 100 MHz ratios, turbo ratios are not included
+        uint64_t tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, msr_handle(M_MSR_PLATFORM_INFO));
+        m_max_freq = ((tmp >> 8) & 0xFF) * 0.1;
+        m_min_freq = ((tmp >> 40) & 0xFF) * 0.1;
     }
 
     void KNLPlatformImp::msr_reset()
@@ -439,12 +470,12 @@ namespace geopm
         uint64_t tmp;
 
         //Make sure units are consistent between packages
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "RAPL_POWER_UNIT");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_RAPL_POWER_UNIT]);
         m_energy_units = pow(0.5, (double)((tmp >> 8)  & 0x1F));
         m_power_units = pow(2, (double)(tmp & 0xF));
 
         for (int i = 1; i < m_num_package; i++) {
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "RAPL_POWER_UNIT");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_RAPL_POWER_UNIT]);
             double energy = pow(0.5, (double)((tmp >> 8) & 0x1F00));
             double power = pow(2, (double)((tmp >> 0) & 0xF));
             if (energy != m_energy_units || power != m_power_units) {
@@ -453,12 +484,12 @@ namespace geopm
         }
 
         //Make sure bounds are consistent between packages
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "PKG_POWER_INFO");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_PKG_POWER_INFO]);
         m_tdp_pkg_watts = ((double)(tmp & 0x7fff)) / m_power_units;
         m_min_pkg_watts = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
         m_max_pkg_watts = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
 
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "DRAM_POWER_INFO");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_DRAM_POWER_INFO]);
         m_min_dram_watts = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
         m_max_dram_watts = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
 
@@ -468,13 +499,13 @@ namespace geopm
         m_pkg_time_window = (uint64_t)(log(m_control_latency_ms)/log(2)) << 49;
 
         for (int i = 1; i < m_num_package; i++) {
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "PKG_POWER_INFO");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_PKG_POWER_INFO]);
             double pkg_min = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
             double pkg_max = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
             if (pkg_min != m_min_pkg_watts || pkg_max != m_max_pkg_watts) {
                 throw Exception("detected inconsistent power pkg bounds among packages", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
             }
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "DRAM_POWER_INFO");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_DRAM_POWER_INFO]);
             double dram_min = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
             double dram_max = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
             if (dram_min != m_min_dram_watts || dram_max != m_max_dram_watts) {
@@ -490,54 +521,45 @@ namespace geopm
     void KNLPlatformImp::cbo_counters_init()
     {
         for (int i = 0; i < m_num_tile; i++) {
-            std::string ctl1_msr_name("_MSR_PMON_CTL0");
-            std::string ctl2_msr_name("_MSR_PMON_CTL1");
-            std::string box_msr_name("_MSR_PMON_BOX_CTL");
-            std::string filter_msr_name("_MSR_PMON_BOX_FILTER");
-            box_msr_name.insert(0, std::to_string(i));
-            box_msr_name.insert(0, "C");
-            ctl1_msr_name.insert(0, std::to_string(i));
-            ctl1_msr_name.insert(0, "C");
-            ctl2_msr_name.insert(0, std::to_string(i));
-            ctl2_msr_name.insert(0, "C");
-            filter_msr_name.insert(0, std::to_string(i));
-            filter_msr_name.insert(0, "C");
+            const struct m_msr_handle_s &ctl1_msr = cbo_msr_handle(i, M_CBO_CTL0);
+            const struct m_msr_handle_s &ctl2_msr = cbo_msr_handle(i, M_CBO_CTL1);
+            const struct m_msr_handle_s &box_msr = cbo_msr_handle(i, M_CBO_BOX_CTL);
 
             // enable freeze
-            msr_write(GEOPM_DOMAIN_TILE, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       | M_BOX_FRZ_EN);
             // freeze box
-            msr_write(GEOPM_DOMAIN_TILE, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       | M_BOX_FRZ);
             // enable counter 0
-            msr_write(GEOPM_DOMAIN_TILE, i, ctl1_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, ctl1_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, ctl1_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, ctl1_msr)
                       | M_CTR_EN);
             // enable counter 1
-            msr_write(GEOPM_DOMAIN_TILE, i, ctl2_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, ctl2_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, ctl2_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, ctl2_msr)
                       | M_CTR_EN);
             // l2 misses
-            msr_write(GEOPM_DOMAIN_TILE, i, ctl1_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, ctl1_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, ctl1_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, ctl1_msr)
                       | M_EVENT_SEL_0 | M_UMASK_0);
             // l2 prefetches
-            msr_write(GEOPM_DOMAIN_TILE, i, ctl2_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, ctl2_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, ctl2_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, ctl2_msr)
                       | M_EVENT_SEL_1 | M_UMASK_1);
             // reset counters
-            msr_write(GEOPM_DOMAIN_TILE, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       | M_RST_CTRS);
             // disable freeze
-            msr_write(GEOPM_DOMAIN_TILE, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       | M_BOX_FRZ);
             // unfreeze box
-            msr_write(GEOPM_DOMAIN_TILE, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       & ~M_BOX_FRZ_EN);
         }
     }
@@ -545,9 +567,9 @@ namespace geopm
     void KNLPlatformImp::fixed_counters_init()
     {
         for (int tile = 0; tile < m_num_tile; tile++) {
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_FIXED_CTR_CTRL", 0x0333);
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_GLOBAL_CTRL", 0x700000003);
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_GLOBAL_OVF_CTRL", 0x0);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_FIXED_CTR_CTRL], 0x0333);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_GLOBAL_CTRL], 0x700000003);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_GLOBAL_OVF_CTRL], 0x0);
         }
     }
 
@@ -558,20 +580,18 @@ namespace geopm
         for (int i = 1; i < m_num_package; i++) {
             msr_val = (uint64_t)(m_max_pkg_watts * m_power_units);
             msr_val = msr_val | (msr_val << 32) | M_PKG_POWER_LIMIT_MASK | m_pkg_time_window;
-            msr_write(GEOPM_DOMAIN_PACKAGE, i, "PKG_POWER_LIMIT", msr_val);
-            msr_write(GEOPM_DOMAIN_PACKAGE, i, "DRAM_POWER_LIMIT", 0x0);
+            msr_write(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_PKG_POWER_LIMIT], msr_val);
+            msr_write(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_DRAM_POWER_LIMIT], 0x0);
         }
     }
 
     void KNLPlatformImp::cbo_counters_reset()
     {
         for (int i = 0; i < m_num_tile; i++) {
-            std::string msr_name("_MSR_PMON_BOX_CTL");
-            msr_name.insert(0, std::to_string(i));
-            msr_name.insert(0, "C");
+            const struct m_msr_handle_s &box_msr = cbo_msr_handle(i, M_CBO_BOX_CTL);
             // reset counters
-            msr_write(GEOPM_DOMAIN_TILE, i, msr_name,
-                      msr_read(GEOPM_DOMAIN_TILE, i, msr_name)
+            msr_write(GEOPM_DOMAIN_TILE, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_TILE, i, box_msr)
                       | M_RST_CTRS);
         }
     }
@@ -579,9 +599,9 @@ namespace geopm
     void KNLPlatformImp::fixed_counters_reset()
     {
         for (int tile = 0; tile < m_num_tile; tile++) {
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_FIXED_CTR0", 0x0);
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_FIXED_CTR1", 0x0);
-            msr_write(GEOPM_DOMAIN_TILE, tile, "PERF_FIXED_CTR2", 0x0);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_FIXED_CTR0], 0x0);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_FIXED_CTR1], 0x0);
+            msr_write(GEOPM_DOMAIN_TILE, tile, m_msr_handle[M_MSR_PERF_FIXED_CTR2], 0x0);
         }
     }
 
@@ -590,6 +610,7 @@ namespace geopm
         static const std::map<std::string, std::pair<off_t, unsigned long> > msr_map({
             {"IA32_PERF_STATUS",        {0x0198, 0x0000000000000000}},
             {"IA32_PERF_CTL",           {0x0199, 0x000000010000ffff}},
+            {"PLATFORM_INFO",           {0x00CE, 0x0000000000000000}},
             {"RAPL_POWER_UNIT",         {0x0606, 0x0000000000000000}},
             {"PKG_POWER_LIMIT",         {0x0610, 0x00ffffff00ffffff}},
             {"PKG_ENERGY_STATUS",       {0x0611, 0x0000000000000000}},
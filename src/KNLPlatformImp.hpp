@@ -66,6 +66,7 @@ namespace geopm
             virtual double read_signal(int device_type, int device_index, int signal_type);
             virtual void batch_read_signal(std::vector<struct geopm_signal_descriptor> &signal_desc, bool is_changed);
             virtual void write_control(int device_type, int device_index, int signal_type, double value);
+            virtual void batch_write_control(const std::vector<struct geopm_signal_descriptor> &control_desc);
             virtual void msr_initialize();
             virtual void msr_reset();
             virtual int power_control_domain(void) const;
@@ -106,6 +107,10 @@ namespace geopm
             double m_min_dram_watts;
             /// @brief Maximum value for DRAM power read from RAPL.
             double m_max_dram_watts;
+            /// @brief Minimum (maximum efficiency) frequency in GHz.
+            double m_min_freq;
+            /// @brief Maximum non-turbo frequency in GHz.
+            double m_max_freq;
             /// @brief Vector of MSR offsets for reading.
             std::vector<off_t> m_signal_msr_offset;
             ///@brief Vector of MSR data containing pairs of offsets and write masks.
@@ -128,6 +133,9 @@ namespace geopm
             const unsigned int M_UMASK_1;
             const uint64_t M_PKG_POWER_LIMIT_MASK;
             const uint64_t M_DRAM_POWER_LIMIT_MASK;
+            const uint64_t M_COUNTER_MASK_32;
+            const uint64_t M_COUNTER_MASK_40;
+            const uint64_t M_COUNTER_MASK_48;
             const unsigned int M_EXTRA_SIGNAL;
             const int M_PLATFORM_ID;
 
@@ -38,6 +38,8 @@
 #include <fstream>
 #include <math.h>
 #include <stdexcept>
+#include <algorithm>
+#include <float.h>
 
 #include "Exception.hpp"
 #include "Platform.hpp"
@@ -103,6 +105,7 @@ namespace geopm
         , m_control_domain_type(GEOPM_CONTROL_DOMAIN_POWER)
         , m_num_energy_domain(0)
         , m_num_counter_domain(0)
+        , m_num_rank(0)
     {
 
     }
@@ -149,39 +152,42 @@ namespace geopm
     {
         const int NUM_RANK_SIGNAL = 2;
         int num_package = m_imp->num_package();
-        int num_cpu = m_imp->num_logical_cpu();
         int num_platform_signal = m_imp->num_energy_signal() + m_imp->num_counter_signal();
         /// @todo assumes domain of control is the package
-        std::vector<double> runtime(num_package);
-        std::vector<double> min_progress(num_package);
-        std::vector<double> max_progress(num_package);
-
-        std::fill(runtime.begin(), runtime.end(), -DBL_MAX);
-        std::fill(min_progress.begin(), min_progress.end(), DBL_MAX);
-        std::fill(max_progress.begin(), max_progress.end(), -DBL_MAX);
-
-        int num_cpu_per_package = num_cpu / num_package;
         if (m_imp->power_control_domain() == GEOPM_DOMAIN_PACKAGE) {
             int rank_offset = num_package * num_platform_signal;
-            int rank_id = 0;
-            for (size_t i = rank_offset;  i < aligned_data.size(); i += NUM_RANK_SIGNAL)  {
-                for (auto it = m_rank_cpu[rank_id].begin(); it != m_rank_cpu[rank_id].end(); ++it) {
-                    if (aligned_data[i + 1] != -1.0) {
-                        // Find minimum progress for any rank on the package
-                        if (aligned_data[i] < min_progress[(*it) / num_cpu_per_package]) {
-                            min_progress[(*it) / num_cpu_per_package] = aligned_data[i];
-                        }
-                        // Find maximum progress for any rank on the package
-                        if (aligned_data[i] > max_progress[(*it) / num_cpu_per_package]) {
-                            max_progress[(*it) / num_cpu_per_package] = aligned_data[i];
-                        }
-                        // Find maximum runtime for any rank on the package
-                        if (aligned_data[i + 1] > runtime[(*it) / num_cpu_per_package]) {
-                            runtime[(*it) / num_cpu_per_package] = aligned_data[i + 1];
-                        }
-                    }
+            int num_rank = ((int)aligned_data.size() - rank_offset) / NUM_RANK_SIGNAL;
+            if (num_rank > m_num_rank ||
+                (int)m_domain_runtime.size() != num_package) {
+                throw Exception("Platform::transform_rank_data(): init_transform() has not been called for this data", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            std::fill(m_domain_runtime.begin(), m_domain_runtime.end(), -DBL_MAX);
+            std::fill(m_domain_min_progress.begin(), m_domain_min_progress.end(), DBL_MAX);
+            std::fill(m_domain_max_progress.begin(), m_domain_max_progress.end(), -DBL_MAX);
+
+            const double *rank_data = aligned_data.data() + rank_offset;
+            const int *rank_domain = m_rank_domain.data();
+            double *domain_runtime = m_domain_runtime.data();
+            double *domain_min_progress = m_domain_min_progress.data();
+            double *domain_max_progress = m_domain_max_progress.data();
+            for (int rank_idx = 0; rank_idx < num_rank; ++rank_idx) {
+                double progress = rank_data[rank_idx * NUM_RANK_SIGNAL];
+                double runtime = rank_data[rank_idx * NUM_RANK_SIGNAL + 1];
+                // Ranks with invalid runtime contribute the identity of each reduction.
+                bool is_valid = (runtime != -1.0);
+                double min_progress = is_valid ? progress : DBL_MAX;
+                double max_progress = is_valid ? progress : -DBL_MAX;
+                runtime = is_valid ? runtime : -DBL_MAX;
+                int domain_end = m_rank_domain_offset[rank_idx + 1];
+                for (int i = m_rank_domain_offset[rank_idx]; i < domain_end; ++i) {
+                    int domain_idx = rank_domain[i];
+                    // Find minimum progress for any rank on the package
+                    domain_min_progress[domain_idx] = std::min(domain_min_progress[domain_idx], min_progress);
+                    // Find maximum progress for any rank on the package
+                    domain_max_progress[domain_idx] = std::max(domain_max_progress[domain_idx], max_progress);
+                    // Find maximum runtime for any rank on the package
+                    domain_runtime[domain_idx] = std::max(domain_runtime[domain_idx], runtime);
                 }
-                ++rank_id;
             }
             // Insert platform signals
             for (int i = 0; i < rank_offset; ++i) {
@@ -190,17 +196,15 @@ namespace geopm
                 telemetry[domain_idx].signal[signal_idx] = aligned_data[domain_idx * num_platform_signal + signal_idx];
             }
             // Insert application signals
-            int domain_idx = 0;
-            for (int i = 0; i < num_package * NUM_RANK_SIGNAL; i += NUM_RANK_SIGNAL) {
+            for (int domain_idx = 0; domain_idx < num_package; ++domain_idx) {
                 // Do not drop a region exit
-                if (max_progress[domain_idx] == 1.0) {
+                if (domain_max_progress[domain_idx] == 1.0) {
                     telemetry[domain_idx].signal[num_platform_signal] = 1.0;
                 }
                 else {
-                    telemetry[domain_idx].signal[num_platform_signal] = min_progress[domain_idx] == DBL_MAX ? 0.0 : min_progress[domain_idx];
+                    telemetry[domain_idx].signal[num_platform_signal] = domain_min_progress[domain_idx] == DBL_MAX ? 0.0 : domain_min_progress[domain_idx];
                 }
-                telemetry[domain_idx].signal[num_platform_signal + 1] = runtime[domain_idx] == -DBL_MAX ? -1.0 : runtime[domain_idx];
-                ++domain_idx;
+                telemetry[domain_idx].signal[num_platform_signal + 1] = domain_runtime[domain_idx] == -DBL_MAX ? -1.0 : domain_runtime[domain_idx];
             }
             // Insert region and timestamp
             for (int i = 0; i < num_package; ++i) {
@@ -227,6 +231,24 @@ namespace geopm
         for (i = 0; i < (int)cpu_rank.size(); ++i) {
             m_rank_cpu[rank_map.find(cpu_rank[i])->second].push_back(i);
         }
+
+        // Precompute the unique control domains that each rank runs on.
+        int num_package = m_imp->num_package();
+        int num_cpu_per_package = m_imp->num_logical_cpu() / num_package;
+        m_rank_domain_offset.resize(m_num_rank + 1);
+        m_rank_domain.clear();
+        for (int rank_idx = 0; rank_idx < m_num_rank; ++rank_idx) {
+            m_rank_domain_offset[rank_idx] = m_rank_domain.size();
+            std::set<int> domain_set;
+            for (auto it = m_rank_cpu[rank_idx].begin(); it != m_rank_cpu[rank_idx].end(); ++it) {
+                domain_set.insert((*it) / num_cpu_per_package);
+            }
+            m_rank_domain.insert(m_rank_domain.end(), domain_set.begin(), domain_set.end());
+        }
+        m_rank_domain_offset[m_num_rank] = m_rank_domain.size();
+        m_domain_runtime.resize(num_package);
+        m_domain_min_progress.resize(num_package);
+        m_domain_max_progress.resize(num_package);
     }
 
     int Platform::num_control_domain(void) const
@@ -250,6 +272,7 @@ namespace geopm
         //Set the frequency for each cpu
         int64_t freq_perc;
         bool small = false;
+        invalidate_control();
         int num_logical_cpus = m_imp->num_logical_cpu();
         int num_real_cpus = m_imp->num_hw_cpu();
         int packages = m_imp->num_package();
@@ -291,6 +314,7 @@ namespace geopm
 
     void Platform::restore_msr_state(const char *path) const
     {
+        invalidate_control();
         m_imp->restore_msr_state(path);
     }
 
@@ -305,9 +329,15 @@ namespace geopm
 
     void Platform::revert_msr_state(void) const
     {
+        invalidate_control();
         m_imp->revert_msr_state();
     }
 
+    void Platform::invalidate_control(void) const
+    {
+
+    }
+
     double Platform::control_latency_ms(void) const
     {
         return m_imp->control_latency_ms();
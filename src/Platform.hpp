@@ -155,6 +155,10 @@ namespace geopm
                                      const std::vector<double> &aligned_data,
                                      std::vector<struct geopm_telemetry_message_s> &telemetry);
         protected:
+            /// @brief Called before the controls are written outside
+            /// of enforce_policy(), so that a platform which skips
+            /// unchanged writes forgets what it last wrote.
+            virtual void invalidate_control(void) const;
             /// @brief Pointer to a PlatformImp object that supports the target
             /// hardware platform.
             PlatformImp *m_imp;
@@ -169,6 +173,18 @@ namespace geopm
             /// per-cpu, and per-rank signals into the domain of control.
             std::vector<std::vector<int> > m_rank_cpu;
             int m_num_rank;
+            /// @brief Offset into m_rank_domain of the first control
+            /// domain for each rank, with a final entry holding the
+            /// total size (compressed sparse row layout).
+            std::vector<int> m_rank_domain_offset;
+            /// @brief Unique control domain indices that each rank
+            /// runs on, indexed through m_rank_domain_offset.
+            std::vector<int> m_rank_domain;
+            /// @brief Per control domain reduction buffers reused by
+            /// transform_rank_data().
+            std::vector<double> m_domain_runtime;
+            std::vector<double> m_domain_min_progress;
+            std::vector<double> m_domain_max_progress;
     };
 }
 
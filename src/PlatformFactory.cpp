@@ -31,6 +31,8 @@
  */
 
 #include <string>
+#include <vector>
+#include <functional>
 #include <inttypes.h>
 #include <cpuid.h>
 
@@ -38,6 +40,7 @@
 #include "Exception.hpp"
 #include "PlatformFactory.hpp"
 #include "RAPLPlatform.hpp"
+#include "FrequencyPlatform.hpp"
 #include "XeonPlatformImp.hpp"
 #include "KNLPlatformImp.hpp"
 #include "config.h"
@@ -97,20 +100,17 @@ namespace geopm
 {
 
     PlatformFactory::PlatformFactory()
+        : m_is_builtin_enabled(true)
     {
-        // register all the platforms we know about
+        // register the plugin platforms, the built in platforms are
+        // only created by platform() when no plugin matches
         geopm_plugin_load(GEOPM_PLUGIN_TYPE_PLATFORM, (struct geopm_factory_c *)this);
         geopm_plugin_load(GEOPM_PLUGIN_TYPE_PLATFORM_IMP, (struct geopm_factory_c *)this);
-        register_platform(std::unique_ptr<Platform>(new RAPLPlatform()));
-        register_platform(std::unique_ptr<PlatformImp>(new SNBPlatformImp()));
-        register_platform(std::unique_ptr<PlatformImp>(new IVTPlatformImp()));
-        register_platform(std::unique_ptr<PlatformImp>(new HSXPlatformImp()));
-        register_platform(std::unique_ptr<PlatformImp>(new BDXPlatformImp()));
-        register_platform(std::unique_ptr<PlatformImp>(new KNLPlatformImp()));
     }
 
     PlatformFactory::PlatformFactory(std::unique_ptr<Platform> platform,
                                      std::unique_ptr<PlatformImp> platform_imp)
+        : m_is_builtin_enabled(false)
     {
         register_platform(std::move(platform));
         register_platform(std::move(platform_imp));
@@ -129,8 +129,8 @@ namespace geopm
     Platform* PlatformFactory::platform(const std::string &description)
     {
         int platform_id;
-        bool is_found = false;
         Platform *result = NULL;
+        PlatformImp *result_imp = NULL;
         platform_id = read_cpuid();
         for (auto it = platforms.begin(); it != platforms.end(); ++it) {
             if ((*it) != NULL && (*it)->model_supported(platform_id, description)) {
@@ -138,22 +138,65 @@ namespace geopm
                 break;
             }
         }
-        for (auto it = platform_imps.begin(); it != platform_imps.end(); ++it) {
-            if ((*it) != NULL && result != NULL &&
-                (*it)->model_supported(platform_id)) {
-                result->set_implementation((*it));
-                is_found = true;
-                break;
-            }
+        if (!result && m_is_builtin_enabled) {
+            result = builtin_platform(platform_id, description);
         }
-        if (!is_found) {
-            result = NULL;
+        if (result) {
+            for (auto it = platform_imps.begin(); it != platform_imps.end(); ++it) {
+                if ((*it) != NULL && (*it)->model_supported(platform_id)) {
+                    result_imp = (*it);
+                    break;
+                }
+            }
+            if (!result_imp && m_is_builtin_enabled) {
+                result_imp = builtin_platform_imp(platform_id);
+            }
         }
-        if (!result) {
+        if (!result_imp) {
             // If we get here, no acceptable platform was found
             throw Exception("cpuid: " + std::to_string(platform_id), GEOPM_ERROR_PLATFORM_UNSUPPORTED, __FILE__, __LINE__);
         }
+        result->set_implementation(result_imp);
+
+        return result;
+    }
+
+    Platform *PlatformFactory::builtin_platform(int platform_id, const std::string &description)
+    {
+        std::unique_ptr<Platform> candidate;
+        if (description == "rapl") {
+            candidate = std::unique_ptr<Platform>(new RAPLPlatform());
+        }
+        else if (description == "frequency") {
+            candidate = std::unique_ptr<Platform>(new FrequencyPlatform());
+        }
+        Platform *result = NULL;
+        if (candidate && candidate->model_supported(platform_id, description)) {
+            result = candidate.get();
+            register_platform(std::move(candidate));
+        }
+        return result;
+    }
 
+    PlatformImp *PlatformFactory::builtin_platform_imp(int platform_id)
+    {
+        // Each model is constructed in turn and asked whether it
+        // supports the cpuid, only the match is kept
+        const std::vector<std::function<PlatformImp *(void)> > builtin {
+            []() -> PlatformImp * {return new SNBPlatformImp();},
+            []() -> PlatformImp * {return new IVTPlatformImp();},
+            []() -> PlatformImp * {return new HSXPlatformImp();},
+            []() -> PlatformImp * {return new BDXPlatformImp();},
+            []() -> PlatformImp * {return new KNLPlatformImp();},
+        };
+        PlatformImp *result = NULL;
+        for (auto it = builtin.begin(); it != builtin.end() && !result; ++it) {
+            std::unique_ptr<PlatformImp> candidate((*it)());
+            if (candidate->model_supported(platform_id)) {
+                result = candidate.get();
+                register_platform(std::move(candidate));
+            }
+        }
         return result;
     }
 
@@ -45,7 +45,8 @@ namespace geopm
     /// @brief Provides a factory abstraction for creating Platform/PlatformImp pairs
     /// suitable for the specific hardware the runtime is operating on. The
     /// factory also loads plugins at creation to provide extensibility to
-    /// other platforms.
+    /// other platforms.  Built in platforms are only instantiated when
+    /// requested and matching the cpuid and description.
     class PlatformFactory
     {
         public:
@@ -95,6 +96,21 @@ namespace geopm
             /// @brief Uses the cpuid asm instruction to identify the hardware
             /// it is being run on.
             virtual int read_cpuid(void);
+            /// @brief Create and register the built in Platform
+            /// matching the description, only called when no
+            /// registered Platform is supported.
+            /// @return The registered Platform, or NULL if none
+            ///         matches.
+            Platform *builtin_platform(int platform_id, const std::string &description);
+            /// @brief Create and register the built in PlatformImp
+            /// for the cpuid, only called when no registered
+            /// PlatformImp is supported.
+            /// @return The registered PlatformImp, or NULL if none
+            ///         matches.
+            PlatformImp *builtin_platform_imp(int platform_id);
+            /// @brief False for the testing constructor, which only
+            ///        uses the objects it is given.
+            bool m_is_builtin_enabled;
 
             // @brief Holds all registered concrete Platform instances.
             std::vector<Platform *> platforms;
@@ -48,13 +48,27 @@
 
 #include "Exception.hpp"
 #include "PlatformImp.hpp"
+#include "geopm_hash.h"
 #include "config.h"
 
 namespace geopm
 {
+    /// @brief Header of the binary MSR save file.
+    struct geopm_msr_save_header_s {
+        uint64_t magic;
+        uint64_t version;
+        uint64_t num_package;
+        uint64_t num_hw_cpu;
+        uint64_t num_record;
+        uint64_t checksum;
+    };
+
+    static const uint64_t M_MSR_SAVE_MAGIC = 0x47454f504d4d5352ULL; // "GEOPMMSR"
+    static const uint64_t M_MSR_SAVE_VERSION = 1;
 
     PlatformImp::PlatformImp()
-        : m_num_logical_cpu(0)
+        : m_msr_map_ptr(NULL)
+        , m_num_logical_cpu(0)
         , m_num_hw_cpu(0)
         , m_num_tile(0)
         , m_num_tile_group(0)
@@ -65,9 +79,10 @@ namespace geopm
         , m_msr_batch_desc(-1)
         , m_is_batch_enabled(false)
         , m_batch({0, NULL})
+        , m_num_cbo(0)
         , M_MSR_SAVE_FILE_PATH("/tmp/geopm-msr-initial-vals-XXXXXX")
     {
-
+        msr_handle_init();
     }
 
     PlatformImp::PlatformImp(int num_energy_signal, int num_counter_signal, double control_latency, const std::map<std::string, std::pair<off_t, unsigned long> > *msr_map_ptr)
@@ -85,9 +100,10 @@ namespace geopm
         , m_msr_batch_desc(-1)
         , m_is_batch_enabled(false)
         , m_batch({0, NULL})
+        , m_num_cbo(0)
         , M_MSR_SAVE_FILE_PATH("/tmp/geopm-msr-initial-vals-XXXXXX")
     {
-
+        msr_handle_init();
     }
 
     PlatformImp::~PlatformImp()
@@ -197,9 +213,15 @@ namespace geopm
 
     void PlatformImp::msr_write(int device_type, int device_index, const std::string &msr_name, uint64_t value)
     {
-        off_t offset = msr_offset(msr_name);
-        unsigned long mask = msr_mask(msr_name);
-        msr_write(device_type, device_index, offset, mask, value);
+        msr_write(device_type, device_index, msr_handle(msr_name), value);
+    }
+
+    void PlatformImp::msr_write(int device_type, int device_index, const struct m_msr_handle_s &handle, uint64_t value)
+    {
+        if (handle.offset < 0) {
+            throw Exception("MSR string not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        msr_write(device_type, device_index, handle.offset, handle.mask, value);
     }
 
     void PlatformImp::msr_write(int device_type, int device_index, off_t msr_offset, unsigned long msr_mask, uint64_t value)
@@ -238,8 +260,15 @@ namespace geopm
 
     uint64_t PlatformImp::msr_read(int device_type, int device_index, const std::string &msr_name)
     {
-        off_t offset = msr_offset(msr_name);
-        return msr_read(device_type, device_index, offset);
+        return msr_read(device_type, device_index, msr_handle(msr_name));
+    }
+
+    uint64_t PlatformImp::msr_read(int device_type, int device_index, const struct m_msr_handle_s &handle)
+    {
+        if (handle.offset < 0) {
+            throw Exception("MSR string not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return msr_read(device_type, device_index, handle.offset);
     }
 
     uint64_t PlatformImp::msr_read(int device_type, int device_index, off_t msr_offset)
@@ -263,6 +292,13 @@ namespace geopm
         return value;
     }
 
+    void PlatformImp::batch_write_control(const std::vector<struct geopm_signal_descriptor> &control_desc)
+    {
+        for (auto it = control_desc.begin(); it != control_desc.end(); ++it) {
+            write_control((*it).device_type, (*it).device_index, (*it).signal_type, (*it).value);
+        }
+    }
+
     void PlatformImp::batch_msr_read(void)
     {
         int rv = ioctl(m_msr_batch_desc, X86_IOC_MSR_BATCH, &m_batch);
@@ -272,22 +308,83 @@ namespace geopm
         }
     }
 
-    off_t PlatformImp::msr_offset(std::string msr_name)
+    struct PlatformImp::m_msr_handle_s PlatformImp::msr_handle(const std::string &msr_name) const
     {
-        auto it = m_msr_map_ptr->find(msr_name);
-        if (it == m_msr_map_ptr->end()) {
-            throw Exception("MSR string not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        struct m_msr_handle_s result = {-1, 0};
+        if (m_msr_map_ptr) {
+            auto it = m_msr_map_ptr->find(msr_name);
+            if (it != m_msr_map_ptr->end()) {
+                result.offset = (*it).second.first;
+                result.mask = (*it).second.second;
+            }
         }
-        return (*it).second.first;
+        return result;
     }
 
-    unsigned long PlatformImp::msr_mask(std::string msr_name)
+    const struct PlatformImp::m_msr_handle_s &PlatformImp::msr_handle(int msr_handle) const
     {
-        auto it = m_msr_map_ptr->find(msr_name);
-        if (it == m_msr_map_ptr->end()) {
-            throw Exception("MSR string not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        if (msr_handle < 0 || (size_t)msr_handle >= m_msr_handle.size() ||
+            m_msr_handle[msr_handle].offset < 0) {
+            throw Exception("PlatformImp::msr_handle(): MSR not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_msr_handle[msr_handle];
+    }
+
+    const struct PlatformImp::m_msr_handle_s &PlatformImp::cbo_msr_handle(int box, int cbo_msr) const
+    {
+        if (box < 0 || box >= m_num_cbo) {
+            throw Exception("PlatformImp::cbo_msr_handle(): uncore box not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const struct m_msr_handle_s &result = m_cbo_msr_handle[box * M_NUM_CBO_MSR + cbo_msr];
+        if (result.offset < 0) {
+            throw Exception("PlatformImp::cbo_msr_handle(): MSR not found in offset map", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    void PlatformImp::msr_handle_init(void)
+    {
+        static const std::string msr_name[M_NUM_MSR_HANDLE] = {
+            "PKG_POWER_LIMIT",
+            "PP0_POWER_LIMIT",
+            "DRAM_POWER_LIMIT",
+            "PERF_FIXED_CTR_CTRL",
+            "PERF_GLOBAL_CTRL",
+            "PERF_GLOBAL_OVF_CTRL",
+            "IA32_PERF_CTL",
+            "IA32_PERF_STATUS",
+            "PLATFORM_INFO",
+            "RAPL_POWER_UNIT",
+            "PKG_POWER_INFO",
+            "DRAM_POWER_INFO",
+            "PKG_ENERGY_STATUS",
+            "DRAM_ENERGY_STATUS",
+            "PERF_FIXED_CTR0",
+            "PERF_FIXED_CTR1",
+            "PERF_FIXED_CTR2",
+        };
+        static const std::string cbo_msr_name[M_NUM_CBO_MSR] = {
+            "_MSR_PMON_BOX_CTL",
+            "_MSR_PMON_BOX_FILTER",
+            "_MSR_PMON_CTL0",
+            "_MSR_PMON_CTL1",
+            "_MSR_PMON_CTR0",
+            "_MSR_PMON_CTR1",
+        };
+
+        m_msr_handle.resize(M_NUM_MSR_HANDLE);
+        for (int i = 0; i < M_NUM_MSR_HANDLE; ++i) {
+            m_msr_handle[i] = msr_handle(msr_name[i]);
+        }
+
+        // Boxes are numbered contiguously from C0 in the MSR map.
+        m_cbo_msr_handle.clear();
+        for (m_num_cbo = 0; msr_handle("C" + std::to_string(m_num_cbo) + cbo_msr_name[M_CBO_BOX_CTL]).offset >= 0; ++m_num_cbo) {
+            std::string prefix("C" + std::to_string(m_num_cbo));
+            for (int i = 0; i < M_NUM_CBO_MSR; ++i) {
+                m_cbo_msr_handle.push_back(msr_handle(prefix + cbo_msr_name[i]));
+            }
         }
-        return (*it).second.second;
     }
 
     void PlatformImp::msr_path(int cpu_num)
@@ -382,82 +479,242 @@ namespace geopm
         value &= ((~0ULL) >> (64 - msr_size));
         // Deal with register overflow
         if (value < m_msr_value_last[signal_idx]) {
-            m_msr_overflow_offset[signal_idx] += pow(2, msr_size);
+            m_msr_overflow_offset[signal_idx] += 1ULL << msr_size;
         }
         m_msr_value_last[signal_idx] = value;
-        return value + m_msr_overflow_offset[signal_idx];
+        return (double)(value + m_msr_overflow_offset[signal_idx]);
+    }
+
+    void PlatformImp::batch_msr_overflow(void)
+    {
+        size_t num_op = m_batch_overflow_idx.size();
+        const int *overflow_idx = m_batch_overflow_idx.data();
+        const uint64_t *counter_mask = m_batch_counter_mask.data();
+        uint64_t *result = m_batch_value.data();
+        uint64_t *value_last = m_msr_value_last.data();
+        uint64_t *overflow_offset = m_msr_overflow_offset.data();
+
+        for (size_t i = 0; i < num_op; ++i) {
+            uint64_t value = m_batch.ops[i].msrdata & counter_mask[i];
+            int idx = overflow_idx[i];
+            if (idx >= 0) {
+                // A counter that went backwards wrapped once, add its period
+                overflow_offset[idx] += (uint64_t)(value < value_last[idx]) * (counter_mask[i] + 1);
+                value_last[idx] = value;
+                value += overflow_offset[idx];
+            }
+            result[i] = value;
+        }
     }
 
     void PlatformImp::save_msr_state(const char *path)
     {
-        int niter = m_num_package;
-        std::ofstream save_file;
+        std::vector<struct m_msr_access_s> record;
 
         if (path == NULL) {
             throw Exception("PlatformImp(): MSR save file path is NULL", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
 
-        save_file.open(path);
+        build_msr_save_list(record);
+        std::vector<uint64_t> value(record.size());
+        batch_msr_read(record, value);
+        for (size_t i = 0; i < record.size(); ++i) {
+            record[i].value = value[i] & record[i].mask;
+        }
 
+        struct geopm_msr_save_header_s header;
+        header.magic = M_MSR_SAVE_MAGIC;
+        header.version = M_MSR_SAVE_VERSION;
+        header.num_package = m_num_package;
+        header.num_hw_cpu = m_num_hw_cpu;
+        header.num_record = record.size();
+        header.checksum = msr_save_checksum(header, record);
+
+        std::ofstream save_file(path, std::ios::out | std::ios::binary | std::ios::trunc);
         if (!save_file.good()) {
             throw Exception("PlatformImp(): MSR save_file stream is bad", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        save_file.write((const char *)&header, sizeof(header));
+        save_file.write((const char *)record.data(), record.size() * sizeof(struct m_msr_access_s));
+        save_file.close();
+        if (save_file.fail()) {
+            throw Exception("PlatformImp(): error writing MSR save file", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void PlatformImp::build_msr_save_list(std::vector<struct m_msr_access_s> &record)
+    {
+        int niter = m_num_package;
 
+        record.clear();
         //per package state
         for (int i = 0; i < niter; i++) {
-            build_msr_save_string(save_file, GEOPM_DOMAIN_PACKAGE, i, "PKG_POWER_LIMIT");
-            build_msr_save_string(save_file, GEOPM_DOMAIN_PACKAGE, i, "PP0_POWER_LIMIT");
-            build_msr_save_string(save_file, GEOPM_DOMAIN_PACKAGE, i, "DRAM_POWER_LIMIT");
+            build_msr_save_record(record, GEOPM_DOMAIN_PACKAGE, i, M_MSR_PKG_POWER_LIMIT);
+            build_msr_save_record(record, GEOPM_DOMAIN_PACKAGE, i, M_MSR_PP0_POWER_LIMIT);
+            build_msr_save_record(record, GEOPM_DOMAIN_PACKAGE, i, M_MSR_DRAM_POWER_LIMIT);
         }
 
         niter = m_num_hw_cpu;
 
         //per cpu state
         for (int i = 0; i < niter; i++) {
-            build_msr_save_string(save_file, GEOPM_DOMAIN_CPU, i, "PERF_FIXED_CTR_CTRL");
-            build_msr_save_string(save_file, GEOPM_DOMAIN_CPU, i, "PERF_GLOBAL_CTRL");
-            build_msr_save_string(save_file, GEOPM_DOMAIN_CPU, i, "PERF_GLOBAL_OVF_CTRL");
-            build_msr_save_string(save_file, GEOPM_DOMAIN_CPU, i, "IA32_PERF_CTL");
+            build_msr_save_record(record, GEOPM_DOMAIN_CPU, i, M_MSR_PERF_FIXED_CTR_CTRL);
+            build_msr_save_record(record, GEOPM_DOMAIN_CPU, i, M_MSR_PERF_GLOBAL_CTRL);
+            build_msr_save_record(record, GEOPM_DOMAIN_CPU, i, M_MSR_PERF_GLOBAL_OVF_CTRL);
+            build_msr_save_record(record, GEOPM_DOMAIN_CPU, i, M_MSR_IA32_PERF_CTL);
         }
-
-        save_file.close();
     }
 
-    void PlatformImp::build_msr_save_string(std::ofstream &save_file, int device_type, int device_index, std::string name)
+    void PlatformImp::build_msr_save_record(std::vector<struct m_msr_access_s> &record, int device_type, int device_index, int msr_handle)
     {
-        uint64_t msr_val = msr_read(device_type, device_index, name);
-        unsigned long mask = msr_mask(name);
-        msr_val &= mask;
-        save_file << device_type << ":" << device_index << ":" << msr_offset(name) << ":" << msr_mask(name) << ":" << msr_val << std::endl;
+        const struct m_msr_handle_s &handle = PlatformImp::msr_handle(msr_handle);
+        struct m_msr_access_s curr;
+        curr.cpu = msr_cpu(device_type, device_index);
+        curr.offset = handle.offset;
+        curr.mask = handle.mask;
+        curr.value = 0;
+        record.push_back(curr);
     }
 
-    void PlatformImp::restore_msr_state(const char *path)
+    void PlatformImp::batch_msr_read(const std::vector<struct m_msr_access_s> &access, std::vector<uint64_t> &value)
     {
-        std::ifstream restore_file;
-        std::string line;
-        std::vector<uint64_t> vals;
-        std::string item;
+        value.resize(access.size());
+        if (m_is_batch_enabled && access.size()) {
+            std::vector<struct m_msr_batch_op> op(access.size());
+            for (size_t i = 0; i < access.size(); ++i) {
+                op[i].cpu = access[i].cpu;
+                op[i].isrdmsr = 1;
+                op[i].err = 0;
+                op[i].msr = access[i].offset;
+                op[i].msrdata = 0;
+                op[i].wmask = 0x0;
+            }
+            struct m_msr_batch_array batch = {(uint32_t)op.size(), op.data()};
+            int rv = ioctl(m_msr_batch_desc, X86_IOC_MSR_BATCH, &batch);
+            if (rv) {
+                throw Exception("read from /dev/cpu/msr_batch failed", GEOPM_ERROR_MSR_READ, __FILE__, __LINE__);
+            }
+            for (size_t i = 0; i < access.size(); ++i) {
+                value[i] = op[i].msrdata;
+            }
+        }
+        else {
+            for (size_t i = 0; i < access.size(); ++i) {
+                value[i] = msr_read(GEOPM_DOMAIN_CPU, access[i].cpu, (off_t)access[i].offset);
+            }
+        }
+    }
 
-        if (path == NULL) {
-            throw Exception("PlatformImp(): file path is NULL", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    int PlatformImp::msr_cpu(int device_type, int device_index) const
+    {
+        // Use the same CPU that msr_write() uses for the domain.
+        int result = device_index;
+        if (device_type == GEOPM_DOMAIN_PACKAGE) {
+            result = (m_num_hw_cpu / m_num_package) * device_index;
         }
+        else if (device_type == GEOPM_DOMAIN_TILE) {
+            result = (m_num_hw_cpu / m_num_tile) * device_index;
+        }
+        return result;
+    }
 
-        restore_file.open(path, std::ios_base::in);
+    void PlatformImp::batch_msr_write(const std::vector<struct m_msr_access_s> &access)
+    {
+        std::vector<uint64_t> value;
+        batch_msr_read(access, value);
 
-        while (std::getline(restore_file,line)) {
-            std::stringstream ss(line);
-            while (std::getline(ss, item, ':')) {
-                vals.push_back((uint64_t)strtoul(item.c_str(), NULL, 0));
+        std::vector<struct m_msr_batch_op> op;
+        op.reserve(access.size());
+        for (size_t i = 0; i < access.size(); ++i) {
+            if (access[i].value & ~access[i].mask) {
+                std::ostringstream message;
+                message << "MSR value to be written was modified by the mask! Desired = 0x" << std::hex << access[i].value
+                        << " After mask = 0x" << std::hex << (access[i].value & access[i].mask);
+                throw Exception(message.str(), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
             }
-            if (vals.size() == 5) {
-                msr_write(vals[0], vals[1], vals[2], vals[3], vals[4]);
+            uint64_t write_value = (value[i] & ~access[i].mask) | access[i].value;
+            // Skip registers that already hold the requested value
+            if (write_value != value[i]) {
+                struct m_msr_batch_op curr = {(uint16_t)access[i].cpu, 0, 0, (uint32_t)access[i].offset, write_value, 0x0};
+                op.push_back(curr);
             }
-            else {
-                throw Exception("error detected in restore file. Could not restore msr states", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+
+        if (m_is_batch_enabled && op.size()) {
+            struct m_msr_batch_array batch = {(uint32_t)op.size(), op.data()};
+            int rv = ioctl(m_msr_batch_desc, X86_IOC_MSR_BATCH, &batch);
+            if (rv) {
+                throw Exception("write to /dev/cpu/msr_batch failed", GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
             }
-            vals.clear();
+        }
+        else {
+            for (auto it = op.begin(); it != op.end(); ++it) {
+                if (m_cpu_file_desc.size() <= (*it).cpu) {
+                    throw Exception("no file descriptor found for cpu device", GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
+                }
+                int rv = pwrite(m_cpu_file_desc[(*it).cpu], &((*it).msrdata), sizeof(uint64_t), (*it).msr);
+                if (rv != sizeof(uint64_t)) {
+                    throw Exception(std::to_string((*it).msr) + " value: " + std::to_string((*it).msrdata), GEOPM_ERROR_MSR_WRITE, __FILE__, __LINE__);
+                }
+            }
+        }
+    }
+
+    uint64_t PlatformImp::msr_save_checksum(const struct geopm_msr_save_header_s &header, const std::vector<struct m_msr_access_s> &record)
+    {
+        // Every header field but the checksum itself is covered
+        uint64_t result = geopm_crc32_u64(0, header.magic);
+        result = geopm_crc32_u64(result, header.version);
+        result = geopm_crc32_u64(result, header.num_package);
+        result = geopm_crc32_u64(result, header.num_hw_cpu);
+        result = geopm_crc32_u64(result, header.num_record);
+        for (auto it = record.begin(); it != record.end(); ++it) {
+            result = geopm_crc32_u64(result, (*it).cpu);
+            result = geopm_crc32_u64(result, (*it).offset);
+            result = geopm_crc32_u64(result, (*it).mask);
+            result = geopm_crc32_u64(result, (*it).value);
+        }
+        return result;
+    }
+
+    void PlatformImp::restore_msr_state(const char *path)
+    {
+        struct geopm_msr_save_header_s header;
+        std::vector<struct m_msr_access_s> record;
+
+        if (path == NULL) {
+            throw Exception("PlatformImp(): file path is NULL", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+
+        std::ifstream restore_file(path, std::ios::in | std::ios::binary | std::ios::ate);
+        std::streamoff file_size = restore_file.tellg();
+        restore_file.seekg(0, std::ios::beg);
+        restore_file.read((char *)&header, sizeof(header));
+        if (!restore_file.good() ||
+            header.magic != M_MSR_SAVE_MAGIC ||
+            header.version != M_MSR_SAVE_VERSION) {
+            throw Exception("PlatformImp::restore_msr_state(): MSR save file is not a valid snapshot", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (header.num_package != (uint64_t)m_num_package ||
+            header.num_hw_cpu != (uint64_t)m_num_hw_cpu) {
+            throw Exception("PlatformImp::restore_msr_state(): MSR save file was created on a different topology", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Check the record count before it is used to size anything
+        build_msr_save_list(record);
+        if (header.num_record != record.size() ||
+            file_size != (std::streamoff)(sizeof(header) + record.size() * sizeof(struct m_msr_access_s))) {
+            throw Exception("PlatformImp::restore_msr_state(): MSR save file is truncated or corrupt, could not restore msr states", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        restore_file.read((char *)record.data(), record.size() * sizeof(struct m_msr_access_s));
+        if ((size_t)restore_file.gcount() != record.size() * sizeof(struct m_msr_access_s) ||
+            restore_file.peek() != std::ifstream::traits_type::eof() ||
+            msr_save_checksum(header, record) != header.checksum) {
+            throw Exception("PlatformImp::restore_msr_state(): MSR save file is truncated or corrupt, could not restore msr states", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
         restore_file.close();
+
+        // Only registers whose masked bits differ from the snapshot are written.
+        batch_msr_write(record);
         remove(path);
     }
 
@@ -60,6 +60,8 @@ namespace geopm
         double value;
     };
 
+    struct geopm_msr_save_header_s;
+
     /* Platform IDs
     ((family << 8) + model)
     0x62A - Sandy Bridge
@@ -147,12 +149,16 @@ namespace geopm
             /// @brief Initialize the topology and hardware counters.
             virtual void initialize(void);
             /// @brief Write to a file the current state of RAPL, per-CPU counters,
-            /// and free running counters.
+            /// and free running counters.  The file is a compact binary
+            /// snapshot with a header that records the topology and a
+            /// checksum of the saved registers.
             /// @param [in] path The path of the file to write.
             virtual void save_msr_state(const char *path);
             /// @brief Read in MSR state for RAPL, per-CPU counters,
             /// and free running counters and set them to that
-            /// state.
+            /// state.  The snapshot is validated before it is
+            /// applied, and only registers whose current value
+            /// differs from the saved value are written.
             /// @param [in] path The path of the file to read in.
             void restore_msr_state(const char *path);
             /// @brief Revert the MSR values to their initial state.
@@ -201,6 +207,12 @@ namespace geopm
             ///        The control type to write to.
             /// @param [in] value The value to be transformed and written.
             virtual void write_control(int device_type, int device_index, int signal_type, double value) = 0;
+            /// @brief Transform and write multiple control values.
+            /// The default implementation calls write_control() for
+            /// each descriptor.
+            /// @param [in] control_desc A vector of descriptors for each write
+            ///        operation, the value field holds the control value.
+            virtual void batch_write_control(const std::vector<struct geopm_signal_descriptor> &control_desc);
             /// @brief Reset MSRs to a default state.
             virtual void msr_reset(void) = 0;
             /// @brief Retrieve the domain of control for power.
@@ -246,16 +258,76 @@ namespace geopm
             /// @param [in] msr_offset Address offset of the requested MSR.
             /// @return Value read from the specified MSR.
             uint64_t msr_read(int device_type, int device_index, off_t msr_offset);
+            /// @brief Address offset and write mask of a Model Specific
+            ///        Register resolved from its name once, so that
+            ///        accessing the MSR does not search the MSR map.
+            struct m_msr_handle_s {
+                off_t offset;        /// @brief Address offset of the MSR, negative if not in the MSR map.
+                unsigned long mask;  /// @brief Write mask of the MSR.
+            };
+            /// @brief Write a value to a Model Specific Register.
+            /// @param [in] device_type enum device type can be
+            ///        one of GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_CPU,
+            ///        GEOPM_DOMAIN_TILE, or GEOPM_DOMAIN_BOARD_MEMORY.
+            /// @param [in] device_index Numbered index of the specified type.
+            /// @param [in] handle Resolved handle of the requested MSR.
+            /// @param [in] value Value to write to the specified MSR.
+            void msr_write(int device_type, int device_index, const struct m_msr_handle_s &handle, uint64_t value);
+            /// @brief Read a value from a Model Specific Register.
+            /// @param [in] device_type enum device type can be
+            ///        one of GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_CPU,
+            ///        GEOPM_DOMAIN_TILE, or GEOPM_DOMAIN_BOARD_MEMORY.
+            /// @param [in] device_index Numbered index of the specified type.
+            /// @param [in] handle Resolved handle of the requested MSR.
+            /// @return Value read from the specified MSR.
+            uint64_t msr_read(int device_type, int device_index, const struct m_msr_handle_s &handle);
             /// @brief Batch read values from multiple Model Specific Registers.
             void batch_msr_read(void);
-            /// @brief Retrieve the address offset of a Model Specific Register.
-            /// @param [in] msr_name String name of the requested MSR.
-            /// @return Address offset of the requested MSR.
-            off_t msr_offset(std::string msr_name);
-            /// @brief Retrieve the write mask of a Model Specific Register.
+            /// @brief Register access used by the batched MSR read and
+            ///        write methods and by the MSR save file.
+            struct m_msr_access_s {
+                uint64_t cpu;     /// @brief Logical CPU to access.
+                uint64_t offset;  /// @brief Address offset of the MSR.
+                uint64_t mask;    /// @brief Write mask of the MSR.
+                uint64_t value;   /// @brief Value of the bits within the mask.
+            };
+            /// @brief Retrieve the logical CPU used to access an MSR
+            ///        of a device.
+            /// @param [in] device_type enum device type can be
+            ///        one of GEOPM_DOMAIN_PACKAGE, GEOPM_DOMAIN_CPU,
+            ///        or GEOPM_DOMAIN_TILE.
+            /// @param [in] device_index Numbered index of the specified type.
+            /// @return Logical CPU index.
+            int msr_cpu(int device_type, int device_index) const;
+            /// @brief Read the current value of each register in the
+            ///        access list, through the msr_safe batch
+            ///        interface when it is available.
+            /// @param [in] access List of registers to read.
+            /// @param [out] value Value read from each register.
+            void batch_msr_read(const std::vector<struct m_msr_access_s> &access, std::vector<uint64_t> &value);
+            /// @brief Write the masked bits of each register in the
+            ///        access list.  The registers are read first and
+            ///        only those whose value changes are written,
+            ///        through the msr_safe batch interface when it is
+            ///        available.
+            /// @param [in] access List of registers and values to write.
+            void batch_msr_write(const std::vector<struct m_msr_access_s> &access);
+            /// @brief Resolve the handle of a Model Specific Register.
             /// @param [in] msr_name String name of the requested MSR.
-            /// @return Write mask of the requested MSR.
-            unsigned long msr_mask(std::string msr_name);
+            /// @return Handle of the requested MSR, with a negative
+            ///         offset if the MSR is not in the MSR map.
+            struct m_msr_handle_s msr_handle(const std::string &msr_name) const;
+            /// @brief Retrieve a handle resolved by msr_handle_init().
+            ///        Throws if the MSR is not in the MSR map.
+            /// @param [in] msr_handle enum m_msr_handle_e MSR to look up.
+            /// @return Handle of the requested MSR.
+            const struct m_msr_handle_s &msr_handle(int msr_handle) const;
+            /// @brief Retrieve the handle of an uncore box MSR.
+            /// @param [in] box Index of the CBo box.
+            /// @param [in] cbo_msr enum m_cbo_msr_e MSR of the box.
+            /// @return Handle of the requested MSR.  Throws if the
+            ///         MSR is not in the MSR map.
+            const struct m_msr_handle_s &cbo_msr_handle(int box, int cbo_msr) const;
             /// @brief Set the path to the MSR special file. In Linux this path
             /// is /dev/msr/cpu_num.
             /// @param [in] cpu_num Logical cpu number to set the path for.
@@ -278,6 +350,14 @@ namespace geopm
             /// @param [in] The value read from the counter.
             /// @return The value corrected for overflow.
             double msr_overflow(int signal_idx, uint32_t msr_size, uint64_t value);
+            /// @brief Handles the overflow of all counters read by the
+            /// last call to batch_msr_read(void) in a single pass.
+            /// Each batch operation is masked with
+            /// m_batch_counter_mask and, unless its entry in
+            /// m_batch_overflow_idx is negative, corrected for
+            /// overflow with the integer accumulator of that signal.
+            /// The results are stored in m_batch_value.
+            void batch_msr_overflow(void);
 
             struct m_msr_batch_op {
                 uint16_t cpu;      /// @brief In: CPU to execute {rd/wr}msr ins.
@@ -328,14 +408,69 @@ namespace geopm
             /// @brief The last values read from all counters.
             std::vector<uint64_t> m_msr_value_last;
             /// @brief The current aggregated overflow for all the counters.
-            std::vector<double> m_msr_overflow_offset;
+            std::vector<uint64_t> m_msr_overflow_offset;
+            /// @brief Overflow offset index of each batch operation, or
+            ///        -1 if the value read is not a counter.
+            std::vector<int> m_batch_overflow_idx;
+            /// @brief Mask of the counter bits of each batch operation.
+            std::vector<uint64_t> m_batch_counter_mask;
+            /// @brief Value of each batch operation corrected for overflow.
+            std::vector<uint64_t> m_batch_value;
             int m_msr_batch_desc;
             bool m_is_batch_enabled;
             struct m_msr_batch_array m_batch;
+            /// @brief Handles of the MSRs shared by all platforms,
+            ///        indexed by m_msr_handle_e.
+            std::vector<struct m_msr_handle_s> m_msr_handle;
+            /// @brief Handles of the uncore box MSRs, indexed by
+            ///        box * M_NUM_CBO_MSR + m_cbo_msr_e.
+            std::vector<struct m_msr_handle_s> m_cbo_msr_handle;
+            /// @brief Number of uncore boxes found in the MSR map.
+            int m_num_cbo;
+
+            enum m_msr_handle_e {
+                M_MSR_PKG_POWER_LIMIT,
+                M_MSR_PP0_POWER_LIMIT,
+                M_MSR_DRAM_POWER_LIMIT,
+                M_MSR_PERF_FIXED_CTR_CTRL,
+                M_MSR_PERF_GLOBAL_CTRL,
+                M_MSR_PERF_GLOBAL_OVF_CTRL,
+                M_MSR_IA32_PERF_CTL,
+                M_MSR_IA32_PERF_STATUS,
+                M_MSR_PLATFORM_INFO,
+                M_MSR_RAPL_POWER_UNIT,
+                M_MSR_PKG_POWER_INFO,
+                M_MSR_DRAM_POWER_INFO,
+                M_MSR_PKG_ENERGY_STATUS,
+                M_MSR_DRAM_ENERGY_STATUS,
+                M_MSR_PERF_FIXED_CTR0,
+                M_MSR_PERF_FIXED_CTR1,
+                M_MSR_PERF_FIXED_CTR2,
+                M_NUM_MSR_HANDLE,
+            };
+            enum m_cbo_msr_e {
+                M_CBO_BOX_CTL,
+                M_CBO_BOX_FILTER,
+                M_CBO_CTL0,
+                M_CBO_CTL1,
+                M_CBO_CTR0,
+                M_CBO_CTR1,
+                M_NUM_CBO_MSR,
+            };
 
         private:
+            /// @brief Resolve the handles of all MSRs used by the
+            ///        platform implementations from the MSR map.
+            void msr_handle_init(void);
             void build_msr_save_file_path(void);
-            void build_msr_save_string(std::ofstream &save_file, int device_type, int device_index, std::string name);
+            /// @brief Append an access for an MSR on a device to the list.
+            void build_msr_save_record(std::vector<struct m_msr_access_s> &record, int device_type, int device_index, int msr_handle);
+            /// @brief Build the list of registers held in the MSR
+            ///        save file, with zero values.
+            void build_msr_save_list(std::vector<struct m_msr_access_s> &record);
+            /// @brief Compute the checksum of the save file header
+            ///        and its list of records.
+            uint64_t msr_save_checksum(const struct geopm_msr_save_header_s &header, const std::vector<struct m_msr_access_s> &record);
 
             std::string m_msr_save_file_path;
 
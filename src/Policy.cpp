@@ -207,6 +207,35 @@ namespace geopm
         return region_policy(region_id)->is_converged();
     }
 
+    void Policy::seed(uint64_t region_id, double power_budget, const std::vector<double> &target, bool is_converged)
+    {
+        if ((int)target.size() != m_num_domain) {
+            throw Exception("Policy::seed(): target vector not properly sized", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (power_budget <= 0.0) {
+            throw Exception("Policy::seed(): power budget must be positive", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        struct m_seed_s &seed = m_seed[region_id];
+        seed.power_budget = power_budget;
+        seed.target = target;
+        seed.is_converged = is_converged;
+    }
+
+    bool Policy::seed_target(uint64_t region_id, double power_budget, std::vector<double> &target, bool &is_converged) const
+    {
+        auto it = m_seed.find(region_id);
+        if (it == m_seed.end()) {
+            return false;
+        }
+        double scale = power_budget / (*it).second.power_budget;
+        target = (*it).second.target;
+        is_converged = (*it).second.is_converged;
+        for (auto target_it = target.begin(); target_it != target.end(); ++target_it) {
+            *target_it *= scale;
+        }
+        return true;
+    }
+
     RegionPolicy::RegionPolicy(int num_domain)
         : m_invalid_target(-DBL_MAX)
         , m_num_domain(num_domain)
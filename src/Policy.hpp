@@ -105,6 +105,37 @@ namespace geopm
             /// acceptance state.
             /// @return true if converged else false.
             bool is_converged(uint64_t region_id);
+            /// @brief Seed a region with targets learned in an
+            ///        earlier run.
+            ///
+            /// The targets are held aside and do not change the
+            /// region policy until a decider asks for them with
+            /// seed_target().
+            ///
+            /// @param [in] region_id Identifier of the region.
+            ///
+            /// @param [in] power_budget Power budget the targets
+            ///        were learned under.
+            ///
+            /// @param [in] target Per domain targets.
+            ///
+            /// @param [in] is_converged Whether the decider had
+            ///        converged on the targets.
+            void seed(uint64_t region_id, double power_budget, const std::vector<double> &target, bool is_converged);
+            /// @brief Get the seeded targets for a region scaled to
+            ///        the current power budget.
+            ///
+            /// @param [in] region_id Identifier of the region.
+            ///
+            /// @param [in] power_budget Power budget now in effect.
+            ///
+            /// @param [out] target Per domain targets.
+            ///
+            /// @param [out] is_converged Whether the decider had
+            ///        converged on the targets.
+            ///
+            /// @return true if the region was seeded, else false.
+            bool seed_target(uint64_t region_id, double power_budget, std::vector<double> &target, bool &is_converged) const;
         protected:
             PolicyFlags m_policy_flags;
             RegionPolicy *region_policy(uint64_t region_id);
@@ -112,6 +143,12 @@ namespace geopm
             int m_mode;
             int m_num_sample;
             std::map<uint64_t, RegionPolicy *> m_region_policy;
+            struct m_seed_s {
+                double power_budget;
+                std::vector<double> target;
+                bool is_converged;
+            };
+            std::map<uint64_t, struct m_seed_s> m_seed;
     };
 }
 
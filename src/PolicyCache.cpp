@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <errno.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "geopm_message.h"
+#include "Exception.hpp"
+#include "Policy.hpp"
+#include "PolicyCache.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    PolicyCache::PolicyCache(uint64_t profile_key, int num_node)
+        : m_profile_key(profile_key)
+        , m_num_node(num_node)
+    {
+
+    }
+
+    PolicyCache::~PolicyCache()
+    {
+
+    }
+
+    bool PolicyCache::parse(const std::string &line, uint64_t &profile_key, int &num_node, std::tuple<int, int, uint64_t> &key, struct m_entry_s &entry) const
+    {
+        size_t begin = line.find_first_not_of(" \t");
+        if (begin == std::string::npos || line[begin] == '#') {
+            return false;
+        }
+        std::istringstream line_stream(line);
+        int node;
+        int level;
+        uint64_t region_id;
+        int is_converged;
+        double target;
+        line_stream >> std::hex >> profile_key >> std::dec >> num_node >> node >> level
+                    >> std::hex >> region_id >> std::dec >> entry.power_budget >> is_converged;
+        if (line_stream.fail() || num_node <= 0 || node < 0 || node >= num_node ||
+            level < 0 || entry.power_budget <= 0.0 || (is_converged != 0 && is_converged != 1)) {
+            throw Exception("PolicyCache::read(): malformed entry: \"" + line + "\"", GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        entry.is_converged = is_converged;
+        entry.target.clear();
+        while (line_stream >> target) {
+            entry.target.push_back(target);
+        }
+        if (!line_stream.eof() || !entry.target.size()) {
+            throw Exception("PolicyCache::read(): malformed entry: \"" + line + "\"", GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        key = std::make_tuple(node, level, region_id);
+        return true;
+    }
+
+    void PolicyCache::read(std::istream &stream)
+    {
+        std::string line;
+        uint64_t profile_key;
+        int num_node;
+        std::tuple<int, int, uint64_t> key;
+        struct m_entry_s entry;
+        while (std::getline(stream, line)) {
+            if (parse(line, profile_key, num_node, key, entry) &&
+                profile_key == m_profile_key &&
+                num_node == m_num_node) {
+                m_entry[key] = entry;
+            }
+        }
+    }
+
+    void PolicyCache::read(const std::string &path)
+    {
+        errno = 0;
+        std::ifstream cache_file(path);
+        if (!cache_file.is_open()) {
+            if (errno != ENOENT) {
+                throw Exception("PolicyCache::read(): could not open cache file \"" + path + "\"", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            }
+            return;
+        }
+        read(cache_file);
+    }
+
+    void PolicyCache::write(std::ostream &stream) const
+    {
+        std::ios_base::fmtflags flags = stream.flags();
+        std::streamsize precision = stream.precision(17);
+        for (auto it = m_entry.begin(); it != m_entry.end(); ++it) {
+            stream << std::hex << m_profile_key << std::dec
+                   << " " << m_num_node
+                   << " " << std::get<0>((*it).first)
+                   << " " << std::get<1>((*it).first)
+                   << " " << std::hex << std::get<2>((*it).first) << std::dec
+                   << " " << (*it).second.power_budget
+                   << " " << ((*it).second.is_converged ? 1 : 0);
+            for (auto target_it = (*it).second.target.begin(); target_it != (*it).second.target.end(); ++target_it) {
+                stream << " " << *target_it;
+            }
+            stream << "\n";
+        }
+        stream.precision(precision);
+        stream.flags(flags);
+    }
+
+    void PolicyCache::write(const std::string &path) const
+    {
+        std::string tmp_path(path + ".tmp");
+        errno = 0;
+        std::ofstream tmp_file(tmp_path, std::ios::out | std::ios::trunc);
+        if (!tmp_file.good()) {
+            throw Exception("PolicyCache::write(): could not open \"" + tmp_path + "\"", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        // Keep the entries for other applications and tree sizes.
+        std::ifstream cache_file(path);
+        std::string line;
+        uint64_t profile_key;
+        int num_node;
+        std::tuple<int, int, uint64_t> key;
+        struct m_entry_s entry;
+        while (std::getline(cache_file, line)) {
+            bool is_entry = false;
+            try {
+                is_entry = parse(line, profile_key, num_node, key, entry);
+            }
+            catch (Exception ex) {
+                if (ex.err_value() != GEOPM_ERROR_FILE_PARSE) {
+                    throw ex;
+                }
+                // Malformed lines are dropped.
+                continue;
+            }
+            if (!is_entry || profile_key != m_profile_key || num_node != m_num_node) {
+                tmp_file << line << "\n";
+            }
+        }
+        write(tmp_file);
+        tmp_file.close();
+        if (tmp_file.fail()) {
+            (void)remove(tmp_path.c_str());
+            throw Exception("PolicyCache::write(): error writing \"" + tmp_path + "\"", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (rename(tmp_path.c_str(), path.c_str())) {
+            int err = errno;
+            (void)remove(tmp_path.c_str());
+            throw Exception("PolicyCache::write(): could not rename \"" + tmp_path + "\"", err, __FILE__, __LINE__);
+        }
+    }
+
+    void PolicyCache::insert(int node, int level, Policy &policy)
+    {
+        int num_domain = policy.num_domain();
+        std::map<int, double> valid;
+        policy.target_valid(GEOPM_REGION_ID_OUTER, valid);
+        if ((int)valid.size() != num_domain) {
+            return;
+        }
+        // The outer region targets split the whole budget of the level.
+        double power_budget = 0.0;
+        for (auto it = valid.begin(); it != valid.end(); ++it) {
+            power_budget += (*it).second;
+        }
+        if (power_budget <= 0.0) {
+            return;
+        }
+        std::vector<uint64_t> region_id;
+        policy.region_id(region_id);
+        for (auto it = region_id.begin(); it != region_id.end(); ++it) {
+            policy.target_valid(*it, valid);
+            if ((int)valid.size() == num_domain) {
+                // Targets that had not converged still give a warm
+                // start, the deciders only trust converged ones.
+                struct m_entry_s entry;
+                entry.power_budget = power_budget;
+                entry.is_converged = policy.is_converged(*it);
+                entry.target.resize(num_domain);
+                for (auto valid_it = valid.begin(); valid_it != valid.end(); ++valid_it) {
+                    entry.target[(*valid_it).first] = (*valid_it).second;
+                }
+                m_entry[std::make_tuple(node, level, *it)] = entry;
+            }
+        }
+    }
+
+    void PolicyCache::seed(int node, int level, Policy &policy) const
+    {
+        auto it = m_entry.lower_bound(std::make_tuple(node, level, (uint64_t)0));
+        for (; it != m_entry.end() &&
+               std::get<0>((*it).first) == node &&
+               std::get<1>((*it).first) == level; ++it) {
+            if ((int)(*it).second.target.size() == policy.num_domain()) {
+                policy.seed(std::get<2>((*it).first), (*it).second.power_budget, (*it).second.target, (*it).second.is_converged);
+            }
+        }
+    }
+
+    size_t PolicyCache::size(void) const
+    {
+        return m_entry.size();
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef POLICYCACHE_HPP_INCLUDE
+#define POLICYCACHE_HPP_INCLUDE
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+
+namespace geopm
+{
+    class Policy;
+
+    /// @brief PolicyCache class holds the per region targets that the
+    ///        deciders converged to so that a later run of the same
+    ///        application can start from them.
+    ///
+    /// Entries are keyed by the hash of the application profile name,
+    /// the number of nodes in the control tree, the node index (rank
+    /// in the per-node communicator), the tree level and the region
+    /// identifier.  Each entry records the per domain targets, the
+    /// power budget they were learned under so that they can be scaled
+    /// when the budget changes, and whether the decider had converged
+    /// on them.  The text format has one entry per line:
+    ///
+    ///     profile_key num_node node level region_id power_budget is_converged target_0 ... target_n
+    ///
+    /// where profile_key and region_id are written in hexadecimal and
+    /// is_converged is 0 or 1.  Lines starting with '#' are ignored.
+    class PolicyCache
+    {
+        public:
+            /// @brief PolicyCache constructor.
+            ///
+            /// @param [in] profile_key Hash of the application
+            ///        profile name, see geopm_crc32_str().
+            ///
+            /// @param [in] num_node Number of nodes in the control
+            ///        tree.  Entries written by a run with a different
+            ///        number of nodes are ignored.
+            PolicyCache(uint64_t profile_key, int num_node);
+            /// @brief PolicyCache destructor, virtual.
+            virtual ~PolicyCache();
+            /// @brief Parse entries from a stream, keeping those that
+            ///        match the profile key and number of nodes.
+            ///
+            /// Entries parsed replace any held with the same node,
+            /// level and region.
+            void read(std::istream &stream);
+            /// @brief Parse entries from a file.  A missing file is
+            ///        treated as an empty cache.
+            void read(const std::string &path);
+            /// @brief Write the entries held to a stream.
+            void write(std::ostream &stream) const;
+            /// @brief Write the entries held to a file.
+            ///
+            /// Entries in the file for other profiles or tree sizes
+            /// are retained, those for this profile are replaced.
+            /// The file is written to a temporary path and renamed
+            /// so that readers never see it partially written.
+            void write(const std::string &path) const;
+            /// @brief Record the targets and convergence state of
+            ///        every region of a policy that has a target for
+            ///        each domain.
+            ///
+            /// @param [in] node Index of the node.
+            ///
+            /// @param [in] level Level of the control tree the policy
+            ///        belongs to.
+            ///
+            /// @param [in] policy Policy to record.
+            void insert(int node, int level, Policy &policy);
+            /// @brief Seed a policy with the entries held for a node
+            ///        and level, see Policy::seed().
+            ///
+            /// Entries with a different number of domains than the
+            /// policy are ignored.
+            void seed(int node, int level, Policy &policy) const;
+            /// @brief Number of entries held.
+            size_t size(void) const;
+        protected:
+            struct m_entry_s {
+                double power_budget;
+                bool is_converged;
+                std::vector<double> target;
+            };
+            bool parse(const std::string &line, uint64_t &profile_key, int &num_node, std::tuple<int, int, uint64_t> &key, struct m_entry_s &entry) const;
+            const uint64_t m_profile_key;
+            const int m_num_node;
+            /// Entries keyed by node, level and region identifier.
+            std::map<std::tuple<int, int, uint64_t>, struct m_entry_s> m_entry;
+    };
+}
+
+#endif
@@ -52,6 +52,8 @@ const char *program_invocation_name = "geopm_profile";
 #include "ProfileThread.hpp"
 #include "Exception.hpp"
 #include "geopm_env.h"
+#include "geopm_comm.h"
+#include "geopm_hash.h"
 #include "LockingHashTable.hpp"
 #include "config.h"
 
@@ -232,7 +234,7 @@ namespace geopm
         int shm_num_rank = 0;
 
         MPI_Comm_rank(comm, &m_rank);
-        geopm_comm_split_shared(comm, "prof", &m_shm_comm);
+        geopm_comm_shared_cached(comm, &m_shm_comm);
         PMPI_Comm_rank(m_shm_comm, &m_shm_rank);
         PMPI_Comm_size(m_shm_comm, &shm_num_rank);
         PMPI_Barrier(m_shm_comm);
@@ -263,6 +265,7 @@ namespace geopm
 
         PMPI_Barrier(m_shm_comm);
         if (!m_shm_rank) {
+            m_ctl_msg->profile_key = geopm_crc32_str(0, m_prof_name.c_str());
             m_ctl_msg->app_status = GEOPM_STATUS_MAP_BEGIN;
         }
         while (m_ctl_msg->ctl_status != GEOPM_STATUS_MAP_BEGIN) {
@@ -368,11 +371,18 @@ namespace geopm
 
     uint64_t Profile::region(const std::string region_name, long policy_hint)
     {
+        // The hint is checked even without a controller so that a
+        // bad value is caught however the application is run.
+        if (policy_hint < GEOPM_POLICY_HINT_UNKNOWN ||
+            policy_hint > GEOPM_POLICY_HINT_NETWORK) {
+            throw Exception("Profile::region(): invalid policy hint", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
         if (!m_is_enabled) {
             return 0;
         }
-        return m_table->key(region_name);
-        /// @todo Record policy hint when registering a region.
+        // The hint travels to the controller with every sample in
+        // the upper bits of the region id.
+        return geopm_region_id_set_hint(policy_hint, m_table->key(region_name));
     }
 
     void Profile::enter(uint64_t region_id)
@@ -598,6 +608,7 @@ namespace geopm
 
     ProfileSampler::ProfileSampler(size_t table_size)
         : m_table_size(table_size)
+        , m_profile_key(0)
         , m_do_report(false)
     {
         std::string key(geopm_env_shmkey());
@@ -638,6 +649,7 @@ namespace geopm
             m_rank_sampler.push_front(new ProfileRankSampler(shm_key, m_table_size));
         }
         rank_per_node = rank_set.size();
+        m_profile_key = m_ctl_msg->profile_key;
         m_ctl_msg->ctl_status = GEOPM_STATUS_MAP_END;
         while (m_ctl_msg->app_status != GEOPM_STATUS_SAMPLE_BEGIN) {
             geopm_signal_handler_check();
@@ -762,6 +774,11 @@ namespace geopm
         prof_str = m_profile_name;
     }
 
+    uint64_t ProfileSampler::profile_key(void) const
+    {
+        return m_profile_key;
+    }
+
     ProfileRankSampler::ProfileRankSampler(const std::string shm_key, size_t table_size)
         : m_table_shmem(SharedMemory(shm_key, table_size))
         , m_table(ProfileTable(m_table_shmem.size(), m_table_shmem.pointer()))
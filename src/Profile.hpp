@@ -76,6 +76,9 @@ struct geopm_ctl_message_s {
     /// @brief Holds affinities of all application ranks
     /// on the local compute node.
     int cpu_rank[GEOPM_MAX_NUM_CPU];
+    /// @brief Hash of the application profile name, see
+    /// geopm_crc32_str().
+    uint64_t profile_key;
 };
 
 namespace geopm
@@ -176,7 +179,9 @@ namespace geopm
             ///        has been profiled.
             ///
             /// @return Returns the region_id which is a unique
-            ///         identifier derived from the region_name.  This
+            ///         identifier derived from the region_name and
+            ///         the policy_hint, see
+            ///         geopm_region_id_set_hint().  This
             ///         value is passed to Profile::enter(),
             ///         Profile::exit(), Profile::progress and
             ///         Profile::sample() to associate these calls with
@@ -397,6 +402,14 @@ namespace geopm
             bool name_fill(std::set<std::string> &name_set);
             void report_name(std::string &report_str);
             void profile_name(std::string &prof_str);
+            /// @brief Hash of the application profile name.
+            ///
+            /// Unlike profile_name() which is only known once the
+            /// application is shutting down, the key is available
+            /// as soon as initialize() returns.
+            ///
+            /// @return The geopm_crc32_str() of the profile name.
+            uint64_t profile_key(void) const;
         protected:
             /// Holds the shared memory region used for sampling from the
             /// application process.
@@ -496,6 +509,14 @@ namespace geopm
             void name_set(std::set<std::string> &region_name);
             void report_name(std::string &report_str);
             void profile_name(std::string &prof_str);
+            /// @brief Hash of the application profile name.
+            ///
+            /// Unlike profile_name() which is only known once the
+            /// application is shutting down, the key is available
+            /// as soon as initialize() returns.
+            ///
+            /// @return The geopm_crc32_str() of the profile name.
+            uint64_t profile_key(void) const;
         protected:
             /// Holds the shared memory region used for application coordination
             /// and control.
@@ -512,6 +533,7 @@ namespace geopm
             std::set<std::string> m_name_set;
             std::string m_report_name;
             std::string m_profile_name;
+            uint64_t m_profile_key;
             bool m_do_report;
     };
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <float.h>
+#include <algorithm>
+
+#include "QuantileSketch.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    QuantileSketch::QuantileSketch(double relative_accuracy, int max_num_bucket)
+        : m_gamma((1.0 + relative_accuracy) / (1.0 - relative_accuracy))
+        , m_log_gamma(log(m_gamma))
+        , m_bucket(max_num_bucket > 0 ? max_num_bucket : 0)
+    {
+        if (relative_accuracy <= 0.0 || relative_accuracy >= 1.0) {
+            throw Exception("QuantileSketch::QuantileSketch(): relative accuracy must be between 0 and 1", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (max_num_bucket <= 0) {
+            throw Exception("QuantileSketch::QuantileSketch(): number of buckets must be positive", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        clear();
+    }
+
+    QuantileSketch::~QuantileSketch()
+    {
+
+    }
+
+    void QuantileSketch::insert(double value)
+    {
+        if (std::isnan(value)) {
+            return;
+        }
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+        if (value > DBL_MIN) {
+            add((int)ceil(log(value) / m_log_gamma), 1);
+        }
+        else {
+            ++m_zero_count;
+        }
+    }
+
+    void QuantileSketch::merge(const QuantileSketch &other)
+    {
+        if (other.m_gamma != m_gamma || other.m_bucket.size() != m_bucket.size()) {
+            throw Exception("QuantileSketch::merge(): sketches were constructed with different parameters", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (other.m_bucket_count) {
+            // Adding from the highest key down lets the window settle
+            // on the upper range before any low keys are collapsed
+            for (int key = other.m_max_key; key >= other.m_min_key; --key) {
+                uint64_t count = other.m_bucket[key - other.m_offset];
+                if (count) {
+                    add(key, count);
+                }
+            }
+        }
+        m_zero_count += other.m_zero_count;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    void QuantileSketch::clear(void)
+    {
+        std::fill(m_bucket.begin(), m_bucket.end(), 0);
+        m_offset = 0;
+        m_min_key = 0;
+        m_max_key = 0;
+        m_bucket_count = 0;
+        m_zero_count = 0;
+        m_min = DBL_MAX;
+        m_max = -DBL_MAX;
+    }
+
+    uint64_t QuantileSketch::count(void) const
+    {
+        return m_bucket_count + m_zero_count;
+    }
+
+    double QuantileSketch::quantile(double quantile) const
+    {
+        if (quantile < 0.0 || quantile > 1.0) {
+            throw Exception("QuantileSketch::quantile(): quantile must be between 0 and 1", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        uint64_t total = count();
+        if (!total) {
+            return NAN;
+        }
+        if (quantile == 0.0) {
+            return m_min;
+        }
+        if (quantile == 1.0) {
+            return m_max;
+        }
+        double rank = quantile * (total - 1);
+        double result = 0.0;
+        uint64_t cumulative = m_zero_count;
+        if (rank >= cumulative) {
+            for (int key = m_min_key; key <= m_max_key; ++key) {
+                cumulative += m_bucket[key - m_offset];
+                if (cumulative > rank) {
+                    result = value(key);
+                    break;
+                }
+            }
+        }
+        return std::max(m_min, std::min(m_max, result));
+    }
+
+    void QuantileSketch::add(int key, uint64_t count)
+    {
+        int num_bucket = m_bucket.size();
+        if (!m_bucket_count) {
+            // Center the window on the first key
+            m_offset = key - num_bucket / 2;
+            m_min_key = key;
+            m_max_key = key;
+        }
+        else if (key < m_offset) {
+            if (m_max_key - key < num_bucket) {
+                shift(key);
+            }
+            else {
+                // No room below, collapse into the lowest bucket
+                key = m_offset;
+            }
+        }
+        else if (key >= m_offset + num_bucket) {
+            shift(key - num_bucket + 1);
+        }
+        m_bucket[key - m_offset] += count;
+        m_bucket_count += count;
+        m_min_key = std::min(m_min_key, key);
+        m_max_key = std::max(m_max_key, key);
+    }
+
+    void QuantileSketch::shift(int new_offset)
+    {
+        int num_bucket = m_bucket.size();
+        int delta = new_offset - m_offset;
+        if (delta > 0) {
+            uint64_t collapsed = 0;
+            for (int i = 0; i < std::min(delta, num_bucket); ++i) {
+                collapsed += m_bucket[i];
+            }
+            if (delta < num_bucket) {
+                std::copy(m_bucket.begin() + delta, m_bucket.end(), m_bucket.begin());
+                std::fill(m_bucket.end() - delta, m_bucket.end(), 0);
+            }
+            else {
+                std::fill(m_bucket.begin(), m_bucket.end(), 0);
+            }
+            m_bucket[0] += collapsed;
+            m_min_key = std::max(m_min_key, new_offset);
+            m_max_key = std::max(m_max_key, new_offset);
+        }
+        else if (delta < 0) {
+            std::copy_backward(m_bucket.begin(), m_bucket.end() + delta, m_bucket.end());
+            std::fill(m_bucket.begin(), m_bucket.begin() - delta, 0);
+        }
+        m_offset = new_offset;
+    }
+
+    double QuantileSketch::value(int key) const
+    {
+        // Midpoint of the bucket (gamma^(key-1), gamma^key] in
+        // relative terms
+        return 2.0 * pow(m_gamma, key) / (m_gamma + 1.0);
+    }
+}
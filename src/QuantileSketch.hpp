@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUANTILESKETCH_HPP_INCLUDE
+#define QUANTILESKETCH_HPP_INCLUDE
+
+#include <stdint.h>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Constant memory, mergeable quantile estimator.
+    ///
+    /// The QuantileSketch maps each positive value to a bucket on a
+    /// logarithmic scale so that any quantile returned is within a
+    /// fixed relative error of the true value (the DDSketch
+    /// approach).  Buckets are stored in a dense array of fixed
+    /// length.  When the values span more buckets than are
+    /// available, the lowest buckets are collapsed together so that
+    /// the accuracy of the upper quantiles is preserved.  Values
+    /// that are zero or negative are counted together and reported
+    /// as zero.  Two sketches with the same parameters can be merged
+    /// and the result is the same as if all values had been inserted
+    /// into one sketch.
+    class QuantileSketch
+    {
+        public:
+            /// @brief QuantileSketch constructor.
+            ///
+            /// @param [in] relative_accuracy Bound on the relative
+            ///        error of the returned quantiles, e.g. 0.02 for
+            ///        two percent.
+            ///
+            /// @param [in] max_num_bucket Number of buckets
+            ///        allocated, determines the ratio between the
+            ///        largest and smallest values that can be
+            ///        tracked without collapsing.
+            QuantileSketch(double relative_accuracy, int max_num_bucket);
+            /// @brief QuantileSketch destructor, virtual.
+            virtual ~QuantileSketch();
+            /// @brief Add a value to the sketch.
+            ///
+            /// @param [in] value The value to be added.
+            void insert(double value);
+            /// @brief Add all of the values summarized by another
+            ///        sketch to this one.
+            ///
+            /// @param [in] other Sketch constructed with the same
+            ///        parameters as this one.
+            void merge(const QuantileSketch &other);
+            /// @brief Remove all values from the sketch.
+            void clear(void);
+            /// @brief Number of values summarized by the sketch.
+            ///
+            /// @return Number of values inserted or merged.
+            uint64_t count(void) const;
+            /// @brief Estimate a quantile of the values.
+            ///
+            /// @param [in] quantile Value between 0.0 and 1.0,
+            ///        e.g. 0.99 for the 99th percentile.
+            ///
+            /// @return Estimate of the quantile, NAN if the sketch
+            ///         is empty.  The 0.0 and 1.0 quantiles are
+            ///         the exact minimum and maximum.
+            double quantile(double quantile) const;
+        protected:
+            /// @brief Add a count to the bucket with the given key,
+            ///        moving the window of buckets if required.
+            void add(int key, uint64_t count);
+            /// @brief Move the lowest bucket key to new_offset,
+            ///        collapsing any buckets that fall below it.
+            void shift(int new_offset);
+            /// @brief Representative value for the bucket key.
+            double value(int key) const;
+            /// @brief Base of the logarithmic bucket scale.
+            double m_gamma;
+            /// @brief Natural log of m_gamma.
+            double m_log_gamma;
+            /// @brief Bucket counts, m_bucket[i] counts the values
+            ///        with key m_offset + i.
+            std::vector<uint64_t> m_bucket;
+            /// @brief Key of m_bucket[0].
+            int m_offset;
+            /// @brief Smallest and largest keys with a non-zero count.
+            int m_min_key;
+            int m_max_key;
+            /// @brief Number of values in m_bucket.
+            uint64_t m_bucket_count;
+            /// @brief Number of values that were zero or negative.
+            uint64_t m_zero_count;
+            /// @brief Smallest and largest values inserted, used to
+            ///        bound the estimates.
+            double m_min;
+            double m_max;
+    };
+}
+
+#endif
@@ -50,6 +50,18 @@ namespace geopm
 
     }
 
+    RAPLPlatform::RAPLPlatform(int control_domain_type, const std::string &description)
+        : Platform(control_domain_type)
+        , m_description(description)
+        , M_HSX_ID(0x63F)
+        , M_IVT_ID(0x63E)
+        , M_SNB_ID(0x62D)
+        , M_BDX_ID(0x64F)
+        , M_KNL_ID(0x657)
+    {
+
+    }
+
     RAPLPlatform::~RAPLPlatform()
     {
 
@@ -57,6 +57,14 @@ namespace geopm
             virtual void enforce_policy(uint64_t region_id, Policy &policy) const;
             virtual void bound(double &upper_bound, double &lower_bound);
         protected:
+            /// @brief Constructor for derived platforms that gather
+            /// telemetry like the RAPLPlatform but use a different
+            /// domain of control.
+            /// @param [in] control_domain_type enum geopm_control_domain_type_e
+            ///        describing the domain of control.
+            /// @param [in] description Platform description string matched
+            ///        by model_supported().
+            RAPLPlatform(int control_domain_type, const std::string &description);
             /// @brief structure to hold buffer indicies for platform signals.
             struct m_buffer_index_s {
                 int package0_pkg_energy;
@@ -31,6 +31,7 @@
  */
 
 #include <string.h>
+#include <cmath>
 #include <algorithm>
 #include <iostream>
 #include <fstream>
@@ -46,30 +47,52 @@ namespace geopm
         , m_num_domain(num_domain)
         , m_level(level)
         , m_num_signal(m_level == 0 ? (int)GEOPM_NUM_TELEMETRY_TYPE : (int)GEOPM_NUM_SAMPLE_TYPE)
-        , m_signal_matrix(m_num_signal * m_num_domain)
         , m_entry_telemetry(m_num_domain)
         , m_domain_sample(m_num_domain)
         , m_curr_sample({m_identifier, {0.0, 0.0, 0.0}})
         , m_domain_buffer(M_NUM_SAMPLE_HISTORY)
         , m_time_buffer(M_NUM_SAMPLE_HISTORY)
-        , m_valid_entries(m_num_signal * m_num_domain)
-        , m_min(m_num_signal * m_num_domain)
-        , m_max(m_num_signal * m_num_domain)
-        , m_sum(m_num_signal * m_num_domain)
-        , m_sum_squares(m_num_signal * m_num_domain)
+        , m_valid_buffer(M_NUM_SAMPLE_HISTORY)
+        , m_is_known_valid(m_num_signal)
+        , m_stat_count(m_num_signal * m_num_domain)
+        , m_stat_mean(m_num_signal * m_num_domain)
+        , m_stat_m2(m_num_signal * m_num_domain)
+        , m_order_stats(m_num_signal * m_num_domain * M_NUM_SAMPLE_HISTORY)
+        , m_num_order_stats(m_num_signal * m_num_domain)
+        , m_integral(m_num_signal * m_num_domain)
+        , m_integral_time(m_num_signal * m_num_domain)
+        , m_integral_last_value(m_num_signal * m_num_domain)
+        , m_integral_last_time(m_num_signal * m_num_domain)
+        , m_is_integral_start(m_num_signal * m_num_domain, true)
         , m_agg_stats({m_identifier, {0.0, 0.0, 0.0}})
+        , m_runtime_sketch(M_SKETCH_ACCURACY_PERCENT / 100.0, M_NUM_SKETCH_BUCKET)
+        , m_energy_sketch(M_SKETCH_ACCURACY_PERCENT / 100.0, M_NUM_SKETCH_BUCKET)
         , m_num_entry(0)
+        , m_num_complete(0)
         , m_is_entered(m_num_domain)
+        , m_sample_age(m_num_domain, 0)
     {
         std::fill(m_domain_sample.begin(), m_domain_sample.end(), m_curr_sample);
-        std::fill(m_min.begin(), m_min.end(), DBL_MAX);
-        std::fill(m_max.begin(), m_max.end(), -DBL_MAX);
-        std::fill(m_sum.begin(), m_sum.end(), 0.0);
-        std::fill(m_sum_squares.begin(), m_sum_squares.end(), 0.0);
-        std::fill(m_valid_entries.begin(), m_valid_entries.end(), 0);
+        // At the leaf only progress and runtime can be invalid, at
+        // the tree every signal of a reused child sample is invalid
+        std::fill(m_is_known_valid.begin(), m_is_known_valid.end(), m_level ? 0.0 : 1.0);
+        if (!m_level) {
+            m_is_known_valid[GEOPM_TELEMETRY_TYPE_PROGRESS] = 0.0;
+            m_is_known_valid[GEOPM_TELEMETRY_TYPE_RUNTIME] = 0.0;
+        }
         struct geopm_telemetry_message_s invalid_telemetry = {0, {{0, 0}}, {0}};
         std::fill(m_entry_telemetry.begin(), m_entry_telemetry.end(), invalid_telemetry);
         std::fill(m_is_entered.begin(), m_is_entered.end(), false);
+        clear_integral();
+        // Allocate every history entry up front, insertions reuse them
+        for (int i = 0; i < m_domain_buffer.capacity(); ++i) {
+            m_domain_buffer.slot().resize(m_num_signal * m_num_domain);
+            m_domain_buffer.advance();
+            m_valid_buffer.slot().resize(m_num_domain);
+            m_valid_buffer.advance();
+        }
+        m_domain_buffer.clear();
+        m_valid_buffer.clear();
     }
 
     Region::~Region()
@@ -99,12 +122,17 @@ namespace geopm
                 throw Exception("Region::insert(): input telemetry vector wrong region id", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
             }
 #endif
+            bool was_entered = m_is_entered[domain_idx];
             update_domain_sample(*it, domain_idx);
-            update_signal_matrix((*it).signal, domain_idx);
-            update_valid_entries(*it, domain_idx);
+            update_integral(*it, domain_idx, was_entered);
             update_stats((*it).signal, domain_idx);
+            update_order_stats((*it).signal, domain_idx);
+            // Written last, the slot may hold the oldest entry used above
+            m_valid_buffer.slot()[domain_idx] = is_domain_valid((*it).signal, domain_idx);
+            update_signal_matrix((*it).signal, domain_idx);
         }
-        m_domain_buffer.insert(m_signal_matrix);
+        m_domain_buffer.advance();
+        m_valid_buffer.advance();
         // If all ranks have exited the region update current sample
         for (domain_idx = 0;
              domain_idx != m_num_domain &&
@@ -119,31 +147,30 @@ namespace geopm
 
     void Region::insert(const std::vector<struct geopm_sample_message_s> &sample)
     {
-        std::copy(sample.begin(), sample.end(), m_domain_sample.begin());
-        update_curr_sample();
-        // Calculate the number of entries *after* we insert the new data: size() + 1 or capacity
-        int num_entries = m_domain_buffer.size() + 1 < m_domain_buffer.capacity() ?
-                          m_domain_buffer.size() + 1 : m_domain_buffer.capacity();
-        // This insert is called above leaf level, so all entries are valid
-        std::fill(m_valid_entries.begin(), m_valid_entries.end(), num_entries);
+        std::fill(m_sample_age.begin(), m_sample_age.end(), 0);
+        insert_sample(sample);
+    }
 
-        int domain_idx = 0;
-        for (auto it = sample.begin(); it != sample.end(); ++it, ++domain_idx) {
-            update_signal_matrix((*it).signal, domain_idx);
-            update_stats((*it).signal, domain_idx);
+    void Region::insert(const std::vector<struct geopm_sample_message_s> &sample,
+                        const std::vector<int> &age)
+    {
+        if (age.size() < m_num_domain) {
+            throw Exception("Region::insert(): age not properly sized", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        m_domain_buffer.insert(m_signal_matrix);
+        std::copy(age.begin(), age.begin() + m_num_domain, m_sample_age.begin());
+        insert_sample(sample);
     }
 
     void Region::clear(void)
     {
         m_time_buffer.clear();
         m_domain_buffer.clear();
-        std::fill(m_min.begin(), m_min.end(), DBL_MAX);
-        std::fill(m_max.begin(), m_max.end(), -DBL_MAX);
-        std::fill(m_sum.begin(), m_sum.end(), 0.0);
-        std::fill(m_sum_squares.begin(), m_sum_squares.end(), 0.0);
-        std::fill(m_valid_entries.begin(), m_valid_entries.end(), 0);
+        m_valid_buffer.clear();
+        std::fill(m_stat_count.begin(), m_stat_count.end(), 0.0);
+        std::fill(m_stat_mean.begin(), m_stat_mean.end(), 0.0);
+        std::fill(m_stat_m2.begin(), m_stat_m2.end(), 0.0);
+        std::fill(m_num_order_stats.begin(), m_num_order_stats.end(), 0);
+        clear_integral();
     }
 
     uint64_t Region::identifier(void) const
@@ -161,6 +188,22 @@ namespace geopm
         sample = m_curr_sample;
     }
 
+    uint64_t Region::num_complete(void) const
+    {
+        return m_num_complete;
+    }
+
+    void Region::domain_sample_message(int domain_idx, struct geopm_sample_message_s &sample) const
+    {
+        check_bounds(domain_idx, 0, __FILE__, __LINE__);
+        sample = m_domain_sample[domain_idx];
+    }
+
+    void Region::aggregate_sample_message(struct geopm_sample_message_s &sample) const
+    {
+        sample = m_agg_stats;
+    }
+
     double Region::signal(int domain_idx, int signal_type)
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
@@ -180,56 +223,69 @@ namespace geopm
         return result;
     }
 
+    int Region::sample_age(int domain_idx) const
+    {
+        check_bounds(domain_idx, 0, __FILE__, __LINE__);
+        return m_sample_age[domain_idx];
+    }
+
     int Region::num_sample(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return m_valid_entries[domain_idx * m_num_signal + signal_type];
+        return (int)m_stat_count[domain_idx * m_num_signal + signal_type];
     }
 
     double Region::mean(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return  m_sum[domain_idx * m_num_signal + signal_type] /
-                num_sample(domain_idx, signal_type);
+        int offset = domain_idx * m_num_signal + signal_type;
+        return m_stat_count[offset] ? m_stat_mean[offset] : NAN;
     }
 
     double Region::median(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        std::vector<double> median_sort(num_sample(domain_idx, signal_type));
-        int idx = 0;
-        bool is_known_valid = true;
-        if (!m_level) {
-            is_known_valid = signal_type != GEOPM_TELEMETRY_TYPE_PROGRESS && signal_type != GEOPM_TELEMETRY_TYPE_RUNTIME;
-        }
-        for (int i = 0; i < m_domain_buffer.size(); ++i) {
-            if (is_known_valid ||
-                m_domain_buffer.value(i)[m_num_signal * domain_idx + GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0) {
-                median_sort[idx++] = m_domain_buffer.value(i)[m_num_signal * domain_idx + signal_type];
-            }
+        int offset = domain_idx * m_num_signal + signal_type;
+        int num_value = m_num_order_stats[offset];
+        double result = NAN;
+        if (num_value) {
+            result = m_order_stats[offset * M_NUM_SAMPLE_HISTORY + num_value / 2];
         }
-        std::sort(median_sort.begin(), median_sort.begin() + num_sample(domain_idx, signal_type));
-        return median_sort[num_sample(domain_idx, signal_type) / 2];
+        return result;
     }
 
     double Region::std_deviation(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return sqrt((m_sum_squares[domain_idx * m_num_signal + signal_type] /
-                     num_sample(domain_idx, signal_type)) -
-                    pow(mean(domain_idx, signal_type), 2));
+        int offset = domain_idx * m_num_signal + signal_type;
+        double result = NAN;
+        if (m_stat_count[offset]) {
+            // Rounding can leave a tiny negative residual when all values are equal
+            result = sqrt(std::max(m_stat_m2[offset] / m_stat_count[offset], 0.0));
+        }
+        return result;
     }
 
     double Region::min(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return m_min[domain_idx * m_num_signal + signal_type];
+        int offset = domain_idx * m_num_signal + signal_type;
+        double result = NAN;
+        if (m_num_order_stats[offset]) {
+            result = m_order_stats[offset * M_NUM_SAMPLE_HISTORY];
+        }
+        return result;
     }
 
     double Region::max(int domain_idx, int signal_type) const
     {
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return m_max[domain_idx * m_num_signal + signal_type];
+        int offset = domain_idx * m_num_signal + signal_type;
+        double result = NAN;
+        if (m_num_order_stats[offset]) {
+            result = m_order_stats[offset * M_NUM_SAMPLE_HISTORY + m_num_order_stats[offset] - 1];
+        }
+        return result;
     }
 
     double Region::derivative(int domain_idx, int signal_type) const
@@ -254,16 +310,27 @@ namespace geopm
 
     double Region::integral(int domain_idx, int signal_type, double &delta_time, double &integral) const
     {
-        throw Exception("Region::integrate_time()", GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
         check_bounds(domain_idx, signal_type, __FILE__, __LINE__);
-        return 0.0;
+        if (m_level) {
+            throw Exception("Region::integral(): Not implemented for non-leaf", GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+        }
+        int offset = domain_idx * m_num_signal + signal_type;
+        delta_time = m_integral_time[offset];
+        integral = m_integral[offset];
+        return delta_time != 0.0 ? integral / delta_time : NAN;
     }
 
     void Region::report(std::ofstream &file_stream, const std::string &name, int num_rank_per_node) const
     {
         file_stream << "Region " + name + ":" << std::endl;
         file_stream << "\truntime (sec): " << m_agg_stats.signal[GEOPM_SAMPLE_TYPE_RUNTIME] << std::endl;
+        report_quantile(file_stream, "runtime", "sec", m_runtime_sketch);
         file_stream << "\tenergy (joules): " << m_agg_stats.signal[GEOPM_SAMPLE_TYPE_ENERGY] << std::endl;
+        report_quantile(file_stream, "energy", "joules", m_energy_sketch);
+        file_stream << "\tpower (watts): " << (m_agg_stats.signal[GEOPM_SAMPLE_TYPE_RUNTIME] ?
+                                               m_agg_stats.signal[GEOPM_SAMPLE_TYPE_ENERGY] /
+                                               m_agg_stats.signal[GEOPM_SAMPLE_TYPE_RUNTIME] :
+                                               0.0) << std::endl;
         file_stream << "\tfrequency (%): " << (m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] ? 100 *
                                                m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER] /
                                                m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] :
@@ -279,6 +346,16 @@ namespace geopm
 
     // Protected function definitions
 
+    void Region::report_quantile(std::ofstream &file_stream, const std::string &name, const std::string &units, const QuantileSketch &sketch) const
+    {
+        // Quantiles of the per entry values, zero if never completed
+        const int percentile[] = {50, 90, 99};
+        for (auto pct : percentile) {
+            file_stream << "\t" << name << " p" << pct << " (" << units << "): "
+                        << (sketch.count() ? sketch.quantile(pct / 100.0) : 0.0) << std::endl;
+        }
+    }
+
     void Region::check_bounds(int domain_idx, int signal_type, const char *file, int line) const
     {
         if (domain_idx < 0 || domain_idx > (int)m_num_domain) {
@@ -355,111 +432,192 @@ namespace geopm
         }
     }
 
-    void Region::update_signal_matrix(const double *signal, int domain_idx)
+    void Region::update_integral(const struct geopm_telemetry_message_s &telemetry, int domain_idx, bool was_entered)
     {
-        memcpy(m_signal_matrix.data() + domain_idx * m_num_signal, signal, m_num_signal * sizeof(double));
+        bool is_entered = m_is_entered[domain_idx];
+        if (!was_entered && !is_entered) {
+            // Outside of the region, keep the integral of the last visit
+            return;
+        }
+        int offset = domain_idx * m_num_signal;
+        if (!was_entered) {
+            // Region entry starts a new interval at the first valid
+            // sample of each signal, even if that is a later one
+            std::fill(m_integral.begin() + offset, m_integral.begin() + offset + m_num_signal, 0.0);
+            std::fill(m_integral_time.begin() + offset, m_integral_time.begin() + offset + m_num_signal, 0.0);
+            std::fill(m_is_integral_start.begin() + offset, m_is_integral_start.begin() + offset + m_num_signal, true);
+        }
+        bool is_signal_valid = telemetry.signal[GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
+        for (int i = 0; i < m_num_signal; ++i) {
+            if (!is_signal_valid && !m_is_known_valid[i]) {
+                // Bridge over invalid progress and runtime samples
+                continue;
+            }
+            if (m_is_integral_start[offset + i]) {
+                m_is_integral_start[offset + i] = false;
+            }
+            else {
+                // Trapezoid between the last valid sample and this one
+                double delta_time = geopm_time_diff(&(m_integral_last_time[offset + i]), &(telemetry.timestamp));
+                m_integral[offset + i] += 0.5 * delta_time * (m_integral_last_value[offset + i] + telemetry.signal[i]);
+                m_integral_time[offset + i] += delta_time;
+            }
+            m_integral_last_value[offset + i] = telemetry.signal[i];
+            m_integral_last_time[offset + i] = telemetry.timestamp;
+        }
     }
 
-    void Region::update_valid_entries(const struct geopm_telemetry_message_s &telemetry, int domain_idx)
+    void Region::clear_integral(void)
     {
-        int offset = domain_idx * m_num_signal;
-        // Calculate the number of entries *after* we insert the new data: size() + 1 or capacity
-        int num_entries = m_domain_buffer.size() + 1 < m_domain_buffer.capacity() ?
-                          m_domain_buffer.size() + 1 : m_domain_buffer.capacity();
-        // Fill in the number of valid entries for other signals which are always valid
-        std::fill(m_valid_entries.begin() + offset, m_valid_entries.begin() + offset + GEOPM_TELEMETRY_TYPE_PROGRESS, num_entries);
-
-        // Account for invalid progress or runtime being inserted or dropped off the end of the buffer
-        bool is_oldest_valid = m_domain_buffer.size() &&
-                               m_domain_buffer.value(0)[offset + GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
-        bool is_signal_valid = telemetry.signal[GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
-        bool is_full = m_domain_buffer.size() == m_domain_buffer.capacity();
+        struct geopm_time_s zero_time = {{0, 0}};
+        std::fill(m_integral.begin(), m_integral.end(), 0.0);
+        std::fill(m_integral_time.begin(), m_integral_time.end(), 0.0);
+        std::fill(m_integral_last_value.begin(), m_integral_last_value.end(), 0.0);
+        std::fill(m_integral_last_time.begin(), m_integral_last_time.end(), zero_time);
+        std::fill(m_is_integral_start.begin(), m_is_integral_start.end(), true);
+    }
 
-        if ((is_full && !is_oldest_valid && is_signal_valid) ||
-            (!is_full && is_signal_valid)) {
-            ++m_valid_entries[offset + GEOPM_TELEMETRY_TYPE_PROGRESS];
-            ++m_valid_entries[offset + GEOPM_TELEMETRY_TYPE_RUNTIME];
+    void Region::insert_sample(const std::vector<struct geopm_sample_message_s> &sample)
+    {
+        // A reused sample was already counted when it was new
+        if (std::find(m_sample_age.begin(), m_sample_age.end(), 0) == m_sample_age.end()) {
+            return;
+        }
+        for (unsigned domain_idx = 0; domain_idx != m_num_domain; ++domain_idx) {
+            if (!m_sample_age[domain_idx]) {
+                m_domain_sample[domain_idx] = sample[domain_idx];
+            }
         }
-        else if (is_full && is_oldest_valid && !is_signal_valid) {
-            --m_valid_entries[offset + GEOPM_TELEMETRY_TYPE_PROGRESS];
-            --m_valid_entries[offset + GEOPM_TELEMETRY_TYPE_RUNTIME];
+        update_curr_sample();
+        int domain_idx = 0;
+        for (auto it = sample.begin(); it != sample.end(); ++it, ++domain_idx) {
+            update_stats((*it).signal, domain_idx);
+            update_order_stats((*it).signal, domain_idx);
+            m_valid_buffer.slot()[domain_idx] = is_domain_valid((*it).signal, domain_idx);
+            update_signal_matrix((*it).signal, domain_idx);
         }
+        m_domain_buffer.advance();
+        m_valid_buffer.advance();
+    }
+
+    void Region::update_signal_matrix(const double *signal, int domain_idx)
+    {
+        memcpy(m_domain_buffer.slot().data() + domain_idx * m_num_signal, signal, m_num_signal * sizeof(double));
     }
 
     void Region::update_stats(const double *signal, int domain_idx)
     {
         int offset = domain_idx * m_num_signal;
-        bool is_full = m_domain_buffer.size() == m_domain_buffer.capacity();
+        const double *is_known_valid = m_is_known_valid.data();
+        double *count = m_stat_count.data() + offset;
+        double *mean = m_stat_mean.data() + offset;
+        double *m2 = m_stat_m2.data() + offset;
+        // Validity is decided once per domain and applied to every
+        // signal as a 0.0/1.0 weight so that the loops are branch free.
+        if (m_domain_buffer.size() == m_domain_buffer.capacity()) {
+            // Remove the value about to be evicted from the history
+            const double *oldest = m_domain_buffer.value(0).data() + offset;
+            double is_oldest_valid = m_valid_buffer.value(0)[domain_idx];
+            for (int i = 0; i < m_num_signal; ++i) {
+                double weight = std::max(is_known_valid[i], is_oldest_valid);
+                double num = count[i] - weight;
+                double delta = oldest[i] - mean[i];
+                double new_mean = mean[i] - weight * delta / std::max(num, 1.0);
+                double new_m2 = m2[i] - weight * delta * (oldest[i] - new_mean);
+                mean[i] = num > 0.0 ? new_mean : 0.0;
+                m2[i] = num > 0.0 ? new_m2 : 0.0;
+                count[i] = num;
+            }
+        }
+        double is_valid = is_domain_valid(signal, domain_idx);
         for (int i = 0; i < m_num_signal; ++i) {
-            bool is_signal_valid = m_level ? true : signal[GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
+            double weight = std::max(is_known_valid[i], is_valid);
+            double num = count[i] + weight;
+            double delta = signal[i] - mean[i];
+            mean[i] += weight * delta / std::max(num, 1.0);
+            m2[i] += weight * delta * (signal[i] - mean[i]);
+            count[i] = num;
+        }
+    }
 
-            // CALCULATE THE MIN
-            if (is_signal_valid && signal[i] < m_min[offset + i]) {
-                m_min[offset + i] = signal[i];
-            }
-            else if (is_full && m_min[offset + i] == m_domain_buffer.value(0)[offset + i]) {
-                // We are about to throw out the current min
-                // Find the new one
-                m_min[offset + i] = is_signal_valid ? signal[i] : DBL_MAX;
-                for (int entry = 1; entry < m_domain_buffer.size(); ++entry) {
-                    bool is_old_value_valid = m_level ? true : m_domain_buffer.value(entry)[offset + GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
-                    if (is_old_value_valid &&
-                        m_domain_buffer.value(entry)[offset + i] < m_min[offset + i]) {
-                        m_min[offset + i] = m_domain_buffer.value(entry)[offset + i];
-                    }
+    void Region::update_order_stats(const double *signal, int domain_idx)
+    {
+        int offset = domain_idx * m_num_signal;
+        bool is_full = m_domain_buffer.size() == m_domain_buffer.capacity();
+        bool is_valid = is_domain_valid(signal, domain_idx);
+        bool is_oldest_valid = is_full && m_valid_buffer.value(0)[domain_idx];
+        for (int i = 0; i < m_num_signal; ++i) {
+            bool is_known_valid = m_is_known_valid[i];
+            double *sorted_begin = m_order_stats.data() + (offset + i) * M_NUM_SAMPLE_HISTORY;
+            double *sorted_end = sorted_begin + m_num_order_stats[offset + i];
+            // NAN has no place in the sorted order so it is never stored
+            if (is_full && (is_known_valid || is_oldest_valid) &&
+                !std::isnan(m_domain_buffer.value(0)[offset + i])) {
+                // Remove the value about to be evicted from the history
+                double old_value = m_domain_buffer.value(0)[offset + i];
+                double *pos = std::lower_bound(sorted_begin, sorted_end, old_value);
+                if (pos != sorted_end && *pos == old_value) {
+                    std::copy(pos + 1, sorted_end, pos);
+                    --sorted_end;
                 }
             }
-
-            // CALCULATE THE MAX
-            if (is_signal_valid && signal[i] > m_max[offset + i]) {
-                m_max[offset + i] = signal[i];
-            }
-            else if (is_full && m_max[offset + i] == m_domain_buffer.value(0)[offset + i]) {
-                // We are about to throw out the current max
-                // Find the new one
-                m_max[offset + i] = is_signal_valid ? signal[i] : -DBL_MAX;
-                for (int entry = 1; entry < m_domain_buffer.size(); ++entry) {
-                    bool is_old_value_valid = m_level ? true : m_domain_buffer.value(entry)[offset + GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
-                    if (is_old_value_valid &&
-                        m_domain_buffer.value(entry)[offset + i] > m_max[offset + i]) {
-                        m_max[offset +i] = m_domain_buffer.value(entry)[offset + i];
-                    }
-                }
+            if ((is_known_valid || is_valid) && !std::isnan(signal[i]) &&
+                sorted_end - sorted_begin < M_NUM_SAMPLE_HISTORY) {
+                // Shift larger values up to insert in sorted order
+                double *pos = std::upper_bound(sorted_begin, sorted_end, signal[i]);
+                std::copy_backward(pos, sorted_end, sorted_end + 1);
+                *pos = signal[i];
+                ++sorted_end;
             }
+            m_num_order_stats[offset + i] = sorted_end - sorted_begin;
+        }
+    }
 
-            // CALCULATE SUM AND SUM OF SQUARES
-            bool is_oldest_valid = m_level || (m_domain_buffer.size() &&
-                                               m_domain_buffer.value(0)[offset + GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0);
+    bool Region::is_domain_valid(const double *signal, int domain_idx) const
+    {
+        // A tree level sample is valid unless it was reused from an
+        // earlier insert, a leaf sample unless the runtime is unknown
+        return m_level ? m_sample_age[domain_idx] == 0 :
+                         signal[GEOPM_TELEMETRY_TYPE_RUNTIME] != -1.0;
+    }
 
-            if (is_signal_valid) {
-                // sum the values
-                m_sum[offset + i] += signal[i];
-                // sum the square of the values
-                m_sum_squares[offset + i] += signal[i] * signal[i];
-            }
-            if (is_full && is_oldest_valid) {
-                // We need to subtract the value of the signal we are removing
-                m_sum[offset + i] -= m_domain_buffer.value(0)[offset + i];
-                m_sum_squares[offset + i] -= m_domain_buffer.value(0)[offset + i] * m_domain_buffer.value(0)[offset + i];
+    void Region::combine_domain_sample(bool is_new_only, struct geopm_sample_message_s &sample) const
+    {
+        bool is_first = true;
+        std::fill(sample.signal, sample.signal + GEOPM_NUM_SAMPLE_TYPE, 0.0);
+        for (unsigned domain_idx = 0; domain_idx != m_num_domain; ++domain_idx) {
+            if (is_new_only && m_sample_age[domain_idx]) {
+                continue;
             }
+            sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] =
+                m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_RUNTIME] > sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] ?
+                m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_RUNTIME] : sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+            sample.signal[GEOPM_SAMPLE_TYPE_ENERGY] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_ENERGY];
+            sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER];
+            sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM];
+            // The domain on the critical path waits the least in MPI
+            sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] =
+                is_first || m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] < sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] ?
+                m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] : sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME];
+            is_first = false;
         }
     }
 
     void Region::update_curr_sample(void)
     {
-        std::fill(m_curr_sample.signal, m_curr_sample.signal + GEOPM_NUM_SAMPLE_TYPE, 0.0);
-        for (unsigned domain_idx = 0; domain_idx != m_num_domain; ++domain_idx) {
-            m_curr_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] =
-                m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_RUNTIME] > m_curr_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME] ?
-                m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_RUNTIME] : m_curr_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
-            m_curr_sample.signal[GEOPM_SAMPLE_TYPE_ENERGY] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_ENERGY];
-            m_curr_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER];
-            m_curr_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] += m_domain_sample[domain_idx].signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM];
-        }
-        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_RUNTIME] += m_curr_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
-        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_ENERGY] += m_curr_sample.signal[GEOPM_SAMPLE_TYPE_ENERGY];
-        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER] += m_curr_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER];
-        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] += m_curr_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM];
+        // The current sample combines the latest sample of every
+        // domain, the aggregate only counts the samples that are new
+        struct geopm_sample_message_s new_sample = {m_identifier, {0.0}};
+        combine_domain_sample(false, m_curr_sample);
+        combine_domain_sample(true, new_sample);
+        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_RUNTIME] += new_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME];
+        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_ENERGY] += new_sample.signal[GEOPM_SAMPLE_TYPE_ENERGY];
+        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER] += new_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER];
+        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM] += new_sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM];
+        m_agg_stats.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] += new_sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME];
+        m_runtime_sketch.insert(new_sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME]);
+        m_energy_sketch.insert(new_sample.signal[GEOPM_SAMPLE_TYPE_ENERGY]);
+        ++m_num_complete;
     }
 
 }
@@ -39,6 +39,7 @@
 
 #include "Policy.hpp"
 #include "CircularBuffer.hpp"
+#include "QuantileSketch.hpp"
 
 namespace geopm
 {
@@ -49,6 +50,8 @@ namespace geopm
         public:
             enum m_const_e {
                 M_NUM_SAMPLE_HISTORY = 8,
+                M_SKETCH_ACCURACY_PERCENT = 2,
+                M_NUM_SKETCH_BUCKET = 256,
             };
             /// @brief Default constructor.
             /// @param [in] identifier Unique 64 bit region identifier.
@@ -75,6 +78,20 @@ namespace geopm
             ///
             /// @param [in] A vector of sample messages to be inserted.
             void insert(const std::vector<struct geopm_sample_message_s> &sample);
+            /// @brief Insert signal data and its staleness into
+            ///        internal buffers
+            ///
+            /// Inserts aggregated sample messages as above along with
+            /// the number of times the sample from each child was
+            /// reused because no new one had arrived.  Only children
+            /// with an age of zero update the statistics and the
+            /// aggregate, for the others just the age is recorded.
+            ///
+            /// @param [in] A vector of sample messages to be inserted.
+            ///
+            /// @param [in] A vector of sample ages, one per child.
+            void insert(const std::vector<struct geopm_sample_message_s> &sample,
+                        const std::vector<int> &age);
             /// @brief Clear data from internal buffers
             ///
             /// Clears aggregated data from the internal buffers.
@@ -91,8 +108,37 @@ namespace geopm
             /// up to the next level of the tree.
             /// @param [out] Sample message structure to fill in.
             void sample_message(struct geopm_sample_message_s &sample);
+            /// @brief Number of samples recorded for completed
+            ///        entries into the region.
+            ///
+            /// At the leaf this is incremented each time all domains
+            /// have exited the region, at tree levels each time an
+            /// insert carries at least one new child sample.  A change in the value tells a
+            /// decider that sample_message() holds a new sample and
+            /// that the region has just been exited.
+            /// @return Number of completed samples.
+            uint64_t num_complete(void) const;
+            /// @brief Return the last sample inserted for a domain
+            ///        by a tree level.
+            /// @param [in] domain_idx The index of the child.
+            /// @param [out] Sample message structure to fill in.
+            void domain_sample_message(int domain_idx, struct geopm_sample_message_s &sample) const;
+            /// @brief Return the sum of every sample that has been
+            ///        sent up the tree for the region.
+            /// @param [out] Sample message structure to fill in.
+            void aggregate_sample_message(struct geopm_sample_message_s &sample) const;
             /// Returns the latest value
             double signal(int domain_idx, int signal_type);
+            /// @brief Retrieve the age of the last sample inserted
+            ///        for a domain of control.
+            ///
+            /// @param [in] domain_idx The index to the domain of
+            ///        control as ordered in the Platform and the
+            ///        Policy.
+            ///
+            /// @return Zero if the sample was new, otherwise the
+            ///         number of consecutive inserts that reused it.
+            int sample_age(int domain_idx) const;
             /// @brief Retrieve the number of valid samples for a domain of control.
             ///
             /// Get the number of valid samples  for a given domain of control and
@@ -210,9 +256,14 @@ namespace geopm
             /// @brief Integrate a signal over time.
             ///
             /// Computes the integral of the signal over the interval
-            /// of time spanned by the samples stored in the region
-            /// which where gathered since the applications most
-            /// recent entry into the region.
+            /// of time spanned by the samples which where gathered
+            /// since the applications most recent entry into the
+            /// region.  If the application has since exited the
+            /// region the interval ends at the exit sample.  The
+            /// integral is accumulated with the trapezoidal rule as
+            /// each sample is inserted, so the cost does not depend
+            /// on the length of the interval.  Only implemented for
+            /// the leaf.
             ///
             /// @param [in] domain_idx The index to the domain of
             ///        control as ordered in the Platform and the
@@ -222,6 +273,14 @@ namespace geopm
             ///        enumerated in geopm_signal_type_e in
             ///        geopm_message.h.
             ///
+            /// @param [out] delta_time Length of the interval in
+            ///        seconds.
+            ///
+            /// @param [out] integral Integral of the signal over the
+            ///        interval.
+            ///
+            /// @return The time weighted average of the signal over
+            ///         the interval, NAN if the interval is empty.
             double integral(int domain_idx, int signal_type, double &delta_time, double &integral) const;
             void report(std::ofstream &file_stream, const std::string &name, int rank_per_node) const;
         protected:
@@ -251,9 +310,68 @@ namespace geopm
             bool is_telemetry_exit(const struct geopm_telemetry_message_s &telemetry, int domain_idx);
             void update_domain_sample(const struct geopm_telemetry_message_s &telemetry, int domain_idx);
             void update_signal_matrix(const double *signal, int domain_idx);
-            void update_valid_entries(const struct geopm_telemetry_message_s &telemetry, int domain_idx);
+            /// @brief Add the trapezoid between the previous sample
+            ///        and this one to the integral of each signal.
+            ///
+            /// Must be called after update_domain_sample() so that
+            /// m_is_entered reflects this sample.
+            ///
+            /// @param [in] telemetry Sample for the domain.
+            ///
+            /// @param [in] domain_idx The index to the domain of
+            ///        control as ordered in the Platform and the
+            ///        Policy.
+            ///
+            /// @param [in] was_entered Value of m_is_entered for the
+            ///        domain before the sample was processed.
+            void update_integral(const struct geopm_telemetry_message_s &telemetry, int domain_idx, bool was_entered);
+            void clear_integral(void);
+            /// @brief Update the sample count, mean and sum of
+            ///        squared deviations of each signal for a domain
+            ///        with the signal about to be inserted.
+            ///
+            /// Uses Welford's update for both the insertion and the
+            /// eviction so the variance does not suffer from the
+            /// cancellation of a sum of squares.  Must be called
+            /// before the signal matrix is inserted into
+            /// m_domain_buffer.
+            ///
+            /// @param [in] signal Signal values for the domain.
+            ///
+            /// @param [in] domain_idx The index to the domain of
+            ///        control as ordered in the Platform and the
+            ///        Policy.
             void update_stats(const double *signal, int domain_idx);
+            /// @brief Update the sorted history of each signal for a
+            ///        domain with the signal about to be inserted.
+            ///
+            /// Must be called before the signal matrix is inserted
+            /// into m_domain_buffer so that the oldest entry which
+            /// is about to be evicted can be removed.
+            ///
+            /// @param [in] signal Signal values for the domain.
+            ///
+            /// @param [in] domain_idx The index to the domain of
+            ///        control as ordered in the Platform and the
+            ///        Policy.
+            void update_order_stats(const double *signal, int domain_idx);
+            /// @brief Insert tree level samples for the domains
+            ///        whose age in m_sample_age is zero.
+            void insert_sample(const std::vector<struct geopm_sample_message_s> &sample);
+            /// @brief Whether a domain's sample is counted in the
+            ///        statistics.
+            /// @return True unless the leaf runtime is invalid or
+            ///         the tree level sample was reused.
+            bool is_domain_valid(const double *signal, int domain_idx) const;
+            /// @brief Combine the per domain samples into one sample.
+            /// @param [in] is_new_only Skip domains with a reused sample.
+            /// @param [out] sample Maximum runtime, total energy and
+            ///        frequency counts and minimum MPI runtime.
+            void combine_domain_sample(bool is_new_only, struct geopm_sample_message_s &sample) const;
             void update_curr_sample(void);
+            /// @brief Write the p50, p90 and p99 lines for a sketch
+            ///        to the report.
+            void report_quantile(std::ofstream &file_stream, const std::string &name, const std::string &units, const QuantileSketch &sketch) const;
             /// @brief Holds a unique 64 bit region identifier.
             const uint64_t m_identifier;
             /// @brief Holds the compute characteristic hint for this region.
@@ -264,8 +382,6 @@ namespace geopm
             const unsigned m_level;
             /// @brief The number of distinct signal in a single domain.
             int m_num_signal;
-            /// @brief Temporary signal matrix storeage used before insertion.
-            std::vector<double> m_signal_matrix;
             /// @brief Holder for telemerty state on region entry.
             std::vector<struct geopm_telemetry_message_s> m_entry_telemetry;
             /// @brief Holder for sample data calculated after a domain exits a region.
@@ -273,22 +389,59 @@ namespace geopm
             /// @brief the current sample message to be sent up the tree.
             struct geopm_sample_message_s m_curr_sample;
             /// @brief Circular buffer is over time, vector is indexed over both domains and signals.
+            ///        The vectors are allocated once and new samples are written in place.
             CircularBuffer<std::vector<double> > m_domain_buffer;
             /// @brief time stamp for each entry in the m_domain_buffer.
             CircularBuffer<struct geopm_time_s> m_time_buffer;
-            /// @brief the number of valid samples per domain and signal type.
-            std::vector<int> m_valid_entries;
-            /// @brief the current minimum signal value per domain and signal type.
-            std::vector<double> m_min;
-            /// @brief the current maximum signal value per domain and signal type.
-            std::vector<double> m_max;
-            /// @brief the current sum of signal values per domain and signal type.
-            std::vector<double> m_sum;
-            /// @brief the current sum of squares of signal values per domain and signal type.
-            std::vector<double> m_sum_squares;
+            /// @brief 1.0 for each domain whose entry in
+            ///        m_domain_buffer was counted in the statistics,
+            ///        0.0 otherwise.
+            CircularBuffer<std::vector<double> > m_valid_buffer;
+            /// @brief 1.0 for signal types that are valid regardless
+            ///        of the runtime signal, 0.0 otherwise.
+            std::vector<double> m_is_known_valid;
+            /// @brief the number of valid samples per domain and
+            ///        signal type, stored as double so it can be
+            ///        updated in the same pass as the moments.
+            std::vector<double> m_stat_count;
+            /// @brief the running mean of valid signal values per domain and signal type.
+            std::vector<double> m_stat_mean;
+            /// @brief the running sum of squared deviations from the
+            ///        mean per domain and signal type.
+            std::vector<double> m_stat_m2;
+            /// @brief valid signal values in the history sorted in
+            ///        ascending order, M_NUM_SAMPLE_HISTORY values are
+            ///        reserved per domain and signal type.
+            std::vector<double> m_order_stats;
+            /// @brief the number of values in m_order_stats per domain and signal type.
+            std::vector<int> m_num_order_stats;
+            /// @brief integral of each signal since the most recent
+            ///        region entry per domain and signal type.
+            std::vector<double> m_integral;
+            /// @brief time spanned by m_integral per domain and signal type.
+            std::vector<double> m_integral_time;
+            /// @brief value of the last sample added to m_integral
+            ///        per domain and signal type.
+            std::vector<double> m_integral_last_value;
+            /// @brief time of the last sample added to m_integral
+            ///        per domain and signal type.
+            std::vector<struct geopm_time_s> m_integral_last_time;
+            /// @brief true until the first valid sample after a
+            ///        region entry starts the interval, per domain
+            ///        and signal type.
+            std::vector<bool> m_is_integral_start;
             struct geopm_sample_message_s m_agg_stats;
+            /// @brief distribution of runtime for each completed
+            ///        entry into the region.
+            QuantileSketch m_runtime_sketch;
+            /// @brief distribution of energy for each completed
+            ///        entry into the region.
+            QuantileSketch m_energy_sketch;
             uint64_t m_num_entry;
+            uint64_t m_num_complete;
             std::vector<bool> m_is_entered;
+            /// @brief age of the last sample inserted per domain.
+            std::vector<int> m_sample_age;
     };
 }
 
@@ -37,7 +37,10 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/inotify.h>
+#include <poll.h>
 #include <string.h>
+#include <algorithm>
 #include <iostream>
 
 #include "geopm_time.h"
@@ -47,6 +50,81 @@
 
 namespace geopm
 {
+    /// Upper bound in seconds on the wait between attempts to open
+    /// the region when no inotify event has been received.
+    static const double M_SHM_WAIT_POLL_INTERVAL = 0.05;
+
+    int shm_open_wait(const std::string &shm_key, size_t min_size, double timeout, size_t &size)
+    {
+        int shm_id = -1;
+        int open_errno = 0;
+        int inotify_fd = -1;
+        bool is_watch_tried = false;
+        struct stat stat_struct;
+        struct geopm_time_s begin_time;
+        struct geopm_time_s curr_time;
+        char event_buffer[4096];
+
+        size = 0;
+        min_size = std::max(min_size, (size_t)1);
+        geopm_time(&begin_time);
+        while (true) {
+            if (shm_id < 0) {
+                shm_id = shm_open(shm_key.c_str(), O_RDWR, 0);
+                open_errno = errno;
+            }
+            if (shm_id >= 0 && !fstat(shm_id, &stat_struct)) {
+                size = stat_struct.st_size;
+            }
+            if (shm_id >= 0 && size >= min_size) {
+                break;
+            }
+            geopm_time(&curr_time);
+            double remaining = timeout - geopm_time_diff(&begin_time, &curr_time);
+            if (remaining <= 0.0) {
+                break;
+            }
+            if (!is_watch_tried) {
+                // Check again once the watch is in place so that an
+                // event between the first attempt and the watch is
+                // not lost.
+                is_watch_tried = true;
+                inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                if (inotify_fd >= 0 &&
+                    inotify_add_watch(inotify_fd, "/dev/shm", IN_CREATE | IN_MODIFY | IN_ATTRIB | IN_MOVED_TO) < 0) {
+                    (void) close(inotify_fd);
+                    inotify_fd = -1;
+                }
+                continue;
+            }
+            int wait_ms = 1 + (int)(1000.0 * std::min(remaining, M_SHM_WAIT_POLL_INTERVAL));
+            if (inotify_fd >= 0) {
+                struct pollfd poll_fd = {inotify_fd, POLLIN, 0};
+                if (poll(&poll_fd, 1, wait_ms) > 0) {
+                    while (read(inotify_fd, event_buffer, sizeof(event_buffer)) > 0) {
+                        // Drain events, the region is re-checked regardless of name.
+                    }
+                }
+            }
+            else {
+                (void) poll(NULL, 0, wait_ms);
+            }
+        }
+        if (inotify_fd >= 0) {
+            (void) close(inotify_fd);
+        }
+        if (shm_id < 0) {
+            throw Exception("shm_open_wait(): Could not open shared memory with key \"" + shm_key + "\"", open_errno ? open_errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (size < min_size) {
+            (void) close(shm_id);
+            throw Exception("shm_open_wait(): Opened shared memory region with key \"" + shm_key + "\", but it is " +
+                            (size ? "smaller than " + std::to_string(min_size) + " bytes" : std::string("zero length")),
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return shm_id;
+    }
+
     SharedMemory::SharedMemory(const std::string &shm_key, size_t size)
         : m_shm_key(shm_key)
         , m_size(size)
@@ -118,61 +196,13 @@ namespace geopm
         , m_size(0)
         , m_is_linked(false)
     {
-        int shm_id = -1;
-        struct stat stat_struct;
-        int err = 0;
-
-        if (!timeout) {
-            shm_id = shm_open(shm_key.c_str(), O_RDWR, 0);
-            if (shm_id < 0) {
-                throw Exception("SharedMemoryUser: Could not open shared memory with key \"" + shm_key + "\"", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-            err = fstat(shm_id, &stat_struct);
-            if (err) {
-                throw Exception("SharedMemoryUser: fstat() error on shared memory with key \"" + shm_key + "\"", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-            m_size = stat_struct.st_size;
-
-            m_ptr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_id, 0);
-            if (m_ptr == MAP_FAILED) {
-                (void) close(shm_id);
-                throw Exception("SharedMemoryUser: Could not mmap shared memory region", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-        }
-        else {
-            struct geopm_time_s begin_time;
-            struct geopm_time_s curr_time;
-
-            geopm_time(&begin_time);
-            curr_time = begin_time;
-            while (shm_id < 0 && geopm_time_diff(&begin_time, &curr_time) < (double)timeout) {
-                shm_id = shm_open(shm_key.c_str(), O_RDWR, 0);
-                geopm_time(&curr_time);
-            }
-            if (shm_id < 0) {
-                throw Exception("SharedMemoryUser: Could not open shared memory with key \"" + shm_key + "\"", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-
-            while (!m_size && geopm_time_diff(&begin_time, &curr_time) < (double)timeout) {
-                err = fstat(shm_id, &stat_struct);
-                if (!err) {
-                    m_size = stat_struct.st_size;
-                }
-                geopm_time(&curr_time);
-            }
-            if (!m_size) {
-                (void) close(shm_id);
-                throw Exception("SharedMemoryUser: Opened shared memory region, but it is zero length", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
-
-            m_ptr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_id, 0);
-            if (m_ptr == MAP_FAILED) {
-                (void) close(shm_id);
-                throw Exception("SharedMemoryUser: Could not mmap shared memory region", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
-            }
+        int shm_id = shm_open_wait(shm_key, 1, (double)timeout, m_size);
+        m_ptr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_id, 0);
+        if (m_ptr == MAP_FAILED) {
+            (void) close(shm_id);
+            throw Exception("SharedMemoryUser: Could not mmap shared memory region", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-
-        err = close(shm_id);
+        int err = close(shm_id);
         if (err) {
             throw Exception("SharedMemoryUser: Could not close shared memory file", errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
@@ -38,6 +38,24 @@
 
 namespace geopm
 {
+    /// @brief Open an inter-process shared memory region created by
+    ///        another process, waiting for it to be created and
+    ///        sized.
+    ///
+    /// Rather than spinning on shm_open() and fstat(), the wait
+    /// blocks on an inotify watch of /dev/shm for create and size
+    /// change events, re-checking at least every
+    /// M_SHM_WAIT_POLL_INTERVAL seconds in case an event is missed.
+    /// @param [in] shm_key Shared memory key of the region.
+    /// @param [in] min_size Minimum size in bytes the region must
+    ///        have before it is considered ready (at least one).
+    /// @param [in] timeout Length in seconds to wait for the region;
+    ///        with zero a single attempt is made.
+    /// @param [out] size Size in bytes of the region when opened.
+    /// @return File descriptor for the region opened read/write,
+    ///         which the caller must close.
+    int shm_open_wait(const std::string &shm_key, size_t min_size, double timeout, size_t &size);
+
     /// This class encapsulates the creation of inter-process shared memory.
     class SharedMemory
     {
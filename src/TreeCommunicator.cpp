@@ -39,8 +39,13 @@
 #include <stddef.h>
 #include <errno.h>
 #include <pthread.h>
+#include <time.h>
 #include <algorithm>
 #include <fstream>
+#include <sstream>
+#include <numeric>
+#include <regex>
+#include <tuple>
 #include <system_error>
 
 #include "Exception.hpp"
@@ -49,26 +54,42 @@
 #include "SharedMemory.hpp"
 #include "geopm_message.h"
 #include "geopm_env.h"
+#include "geopm_comm.h"
+#include "geopm_time.h"
 #include "config.h"
 
 extern "C"
 {
-    static int geopm_comm_split_imp(MPI_Comm comm, const char *tag, int *num_node, MPI_Comm *split_comm, int *is_ctl_comm);
+    /// Communicators derived from a parent communicator, cached as an
+    /// attribute of the parent so that they are created once per
+    /// process and freed along with the parent.
+    struct geopm_comm_cache_s {
+        MPI_Comm shm_comm;
+        MPI_Comm split_comm;
+        int is_shm_root;
+    };
 
-    int geopm_comm_split_ppn1(MPI_Comm comm, const char *tag, MPI_Comm *ppn1_comm)
+    static int g_geopm_comm_cache_keyval = MPI_KEYVAL_INVALID;
+
+    static int geopm_comm_cache_delete(MPI_Comm comm, int keyval, void *attr_val, void *extra_state)
     {
-        int num_node = 0;
-        int is_shm_root = 0;
-        int err = geopm_comm_split_imp(comm, tag, &num_node, ppn1_comm, &is_shm_root);
-        if (!err && !is_shm_root) {
-            err = MPI_Comm_free(ppn1_comm);
-            *ppn1_comm = MPI_COMM_NULL;
-        }
-        return err;
+        struct geopm_comm_cache_s *cache = (struct geopm_comm_cache_s *)attr_val;
+        int err = MPI_Comm_free(&(cache->shm_comm));
+        int tmp_err = MPI_Comm_free(&(cache->split_comm));
+        delete cache;
+        return err ? err : tmp_err;
     }
 
-    int geopm_comm_split_shared(MPI_Comm comm, const char *tag, MPI_Comm *split_comm)
+    static int geopm_comm_split_shared_imp(MPI_Comm comm, const char *tag, MPI_Comm *split_comm)
     {
+#if MPI_VERSION >= 3
+        int rank;
+        int err = MPI_Comm_rank(comm, &rank);
+        if (!err) {
+            err = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, split_comm);
+        }
+        return err;
+#else
         int err = 0;
         struct stat stat_struct;
         try {
@@ -115,61 +136,100 @@ extern "C"
             err = geopm::exception_handler(std::current_exception());
         }
         return err;
+#endif
     }
 
-    int geopm_comm_split(MPI_Comm comm, const char *tag, MPI_Comm *split_comm, int *is_ctl_comm)
+    static int geopm_comm_cache_get(MPI_Comm comm, const char *tag, struct geopm_comm_cache_s **cache)
     {
-        int num_node = 0;
-        return geopm_comm_split_imp(comm, tag, &num_node, split_comm, is_ctl_comm);
-    }
-
-    static int geopm_comm_split_imp(MPI_Comm comm, const char *tag, int *num_node, MPI_Comm *split_comm, int *is_shm_root)
-    {
-        int err, comm_size, comm_rank, shm_rank;
-        MPI_Comm shm_comm = MPI_COMM_NULL, tmp_comm = MPI_COMM_NULL;
-        MPI_Comm *split_comm_ptr;
-
-        *is_shm_root = 0;
-
-        if (split_comm) {
-            split_comm_ptr = split_comm;
-        }
-        else {
-            split_comm_ptr = &tmp_comm;
-        }
+        int err = 0;
+        int is_found = 0;
+        int rank, shm_rank;
+        struct geopm_comm_cache_s *result = NULL;
 
-        err = MPI_Comm_size(comm, &comm_size);
-        if (!err) {
-            err = MPI_Comm_rank(comm, &comm_rank);
-        }
-        if (!err) {
-            err = geopm_comm_split_shared(comm, tag, &shm_comm);
+        if (g_geopm_comm_cache_keyval == MPI_KEYVAL_INVALID) {
+            err = MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, geopm_comm_cache_delete, &g_geopm_comm_cache_keyval, NULL);
         }
         if (!err) {
-            err = MPI_Comm_rank(shm_comm, &shm_rank);
+            err = MPI_Comm_get_attr(comm, g_geopm_comm_cache_keyval, &result, &is_found);
         }
-        if (!err) {
-            if (!shm_rank) {
-                *is_shm_root = 1;
+        if (!err && !is_found) {
+            result = new geopm_comm_cache_s;
+            result->shm_comm = MPI_COMM_NULL;
+            result->split_comm = MPI_COMM_NULL;
+            result->is_shm_root = 0;
+            err = MPI_Comm_rank(comm, &rank);
+            if (!err) {
+                err = geopm_comm_split_shared_imp(comm, tag, &(result->shm_comm));
             }
-            else {
-                *is_shm_root = 0;
+            if (!err) {
+                err = MPI_Comm_rank(result->shm_comm, &shm_rank);
             }
-            err = MPI_Comm_split(comm, *is_shm_root, comm_rank, split_comm_ptr);
-        }
-        if (!err) {
-            if (*is_shm_root == 1) {
-                err = MPI_Comm_size(*split_comm_ptr, num_node);
+            if (!err) {
+                result->is_shm_root = !shm_rank;
+                err = MPI_Comm_split(comm, result->is_shm_root, rank, &(result->split_comm));
+            }
+            if (!err) {
+                err = MPI_Comm_set_attr(comm, g_geopm_comm_cache_keyval, result);
+            }
+            if (err) {
+                if (result->shm_comm != MPI_COMM_NULL) {
+                    (void) MPI_Comm_free(&(result->shm_comm));
+                }
+                if (result->split_comm != MPI_COMM_NULL) {
+                    (void) MPI_Comm_free(&(result->split_comm));
+                }
+                delete result;
+                result = NULL;
             }
         }
-        if (!err) {
-            err = MPI_Bcast(num_node, 1, MPI_INT, 0, shm_comm);
+        *cache = result;
+        return err;
+    }
+
+    int geopm_comm_shared_cached(MPI_Comm comm, MPI_Comm *shm_comm)
+    {
+        struct geopm_comm_cache_s *cache = NULL;
+        int err = geopm_comm_cache_get(comm, "shm", &cache);
+        *shm_comm = err ? MPI_COMM_NULL : cache->shm_comm;
+        return err;
+    }
+
+    int geopm_comm_ppn1_cached(MPI_Comm comm, MPI_Comm *ppn1_comm)
+    {
+        struct geopm_comm_cache_s *cache = NULL;
+        int err = geopm_comm_cache_get(comm, "ppn1", &cache);
+        *ppn1_comm = (err || !cache->is_shm_root) ? MPI_COMM_NULL : cache->split_comm;
+        return err;
+    }
+
+    int geopm_comm_split_ppn1(MPI_Comm comm, const char *tag, MPI_Comm *ppn1_comm)
+    {
+        struct geopm_comm_cache_s *cache = NULL;
+        int err = geopm_comm_cache_get(comm, tag, &cache);
+        *ppn1_comm = MPI_COMM_NULL;
+        if (!err && cache->is_shm_root) {
+            err = MPI_Comm_dup(cache->split_comm, ppn1_comm);
         }
-        if (shm_comm != MPI_COMM_NULL) {
-            MPI_Comm_free(&shm_comm);
+        return err;
+    }
+
+    int geopm_comm_split_shared(MPI_Comm comm, const char *tag, MPI_Comm *split_comm)
+    {
+        struct geopm_comm_cache_s *cache = NULL;
+        int err = geopm_comm_cache_get(comm, tag, &cache);
+        if (!err) {
+            err = MPI_Comm_dup(cache->shm_comm, split_comm);
         }
-        if (!split_comm) {
-            MPI_Comm_free(split_comm_ptr);
+        return err;
+    }
+
+    int geopm_comm_split(MPI_Comm comm, const char *tag, MPI_Comm *split_comm, int *is_ctl_comm)
+    {
+        struct geopm_comm_cache_s *cache = NULL;
+        int err = geopm_comm_cache_get(comm, tag, &cache);
+        if (!err) {
+            *is_ctl_comm = cache->is_shm_root;
+            err = MPI_Comm_dup(cache->split_comm, split_comm);
         }
         return err;
     }
@@ -186,6 +246,13 @@ namespace geopm
         GEOPM_POLICY_TAG,
     };
 
+    /// Seconds a level waits in close_recv() for its other members
+    /// before tearing down alone.
+    static const double M_CLOSE_TIMEOUT = 5.0;
+    /// Delay between tests of the close_recv() barrier so that a
+    /// waiting rank does not compete for the CPU with the others.
+    static const struct timespec M_CLOSE_POLL_DELAY = {0, 1000000};
+
     ///////////////////////////////
     // Helper for MPI exceptions //
     ///////////////////////////////
@@ -205,71 +272,217 @@ namespace geopm
 
     static MPI_Datatype create_sample_mpi_type(void);
     static MPI_Datatype create_policy_mpi_type(void);
+    static bool update_sample_age(const std::vector<bool> &is_fresh, int max_age, std::vector<int> &age);
+    static std::string topology_key(const std::string &topology);
 
     /////////////////////////////////
     // Internal class declarations //
     /////////////////////////////////
 
+    /// @brief TreeCommunicatorLevelBase class is the interface for
+    /// the per-level communication used by the TreeCommunicator.
+    class TreeCommunicatorLevelBase
+    {
+        public:
+            TreeCommunicatorLevelBase() {}
+            virtual ~TreeCommunicatorLevelBase() {}
+            virtual void get_sample(std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age, int max_age) = 0;
+            virtual void get_policy(struct geopm_policy_message_s &policy) = 0;
+            virtual void send_sample(const std::vector<struct geopm_sample_message_s> &sample) = 0;
+            virtual void send_policy(const std::vector<struct geopm_policy_message_s> &policy, size_t length) = 0;
+            virtual int level_rank(void) = 0;
+    };
+
     /// @brief TreeCommunicatorLevel class encapsulates communication functionality on
     /// a per-level basis.
-    class TreeCommunicatorLevel
+    ///
+    /// All messages use persistent requests that are created once
+    /// and restarted with MPI_Start().  Each mailbox is double
+    /// buffered, so the receive for the next message is started
+    /// before the last one is read.
+    class TreeCommunicatorLevel : public TreeCommunicatorLevelBase
     {
         public:
             TreeCommunicatorLevel(MPI_Comm comm, MPI_Datatype sample_mpi_type, MPI_Datatype policy_mpi_type);
-            ~TreeCommunicatorLevel();
-            /// Check sample mailbox for each child and if all are full copy
-            /// them into sample and post a new MPI_Irecv(), otherwise throw
+            virtual ~TreeCommunicatorLevel();
+            /// Check sample mailbox for each child with
+            /// MPI_Testsome(), restart the receive of any that are
+            /// full into their other mailbox and record the samples.
+            /// If every child has a new sample, or at least one has
+            /// and the others have been reused fewer than max_age
+            /// times, copy the last samples of each child into
+            /// sample, otherwise throw geopm::Exception with
+            /// err_value() of GEOPM_ERROR_SAMPLE_INCOMPLETE
+            void get_sample(std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age, int max_age);
+            /// Check policy mailbox and if full copy to m_policy and
+            /// restart the receive into the other mailbox. If mailbox
+            /// is empty set policy to last known policy.  If mailbox
+            /// is empty and no policy has been set throw a
             /// geopm::Exception with err_value() of
-            /// GEOPM_ERROR_SAMPLE_INCOMPLETE
-            void get_sample(std::vector<struct geopm_sample_message_s> &sample);
-            /// Check policy mailbox and if full copy to m_policy and post a
-            /// new MPI_Irecv(). If mailbox is empty set policy to last known
-            /// policy.  If mailbox is empty and no policy has been set throw
-            /// a geopm::Exception with err_value() of
             /// GEOPM_ERROR_POLICY_UNKNOWN.
             void get_policy(struct geopm_policy_message_s &policy);
-            /// Send sample via MPI_Isend() to root of level, skip if no
-            /// recieve has been posted.
-            void send_sample(const struct geopm_sample_message_s &sample);
-            /// Send policy via MPI_Isend() to all children, skip if no
-            /// recieve has been posted.
+            /// Start the persistent send of sample to root of level
+            /// from whichever outbox is free.  If both are still in
+            /// flight fall back to a one time MPI_Isend().
+            void send_sample(const std::vector<struct geopm_sample_message_s> &sample);
+            /// Start the persistent send of policy to each child
+            /// from whichever outbox is free.  If both are still in
+            /// flight fall back to a one time MPI_Isend().
             void send_policy(const std::vector<struct geopm_policy_message_s> &policy, size_t length);
             /// Returns the level rank of the calling process.
             int level_rank(void);
         protected:
+            enum m_const_e {
+                M_NUM_BUFFER = 2,
+            };
             void open_recv(void);
             void close_recv(void);
+            /// Returns true if the persistent request is not in
+            /// flight, completing it if it has finished.
+            bool is_request_free(MPI_Request &request, bool &is_active);
             MPI_Comm m_comm;
             MPI_Datatype m_sample_mpi_type; // MPI data type for sample message
             MPI_Datatype m_policy_mpi_type; // MPI data type for policy message
             int m_size;
             int m_rank;
+            /// M_NUM_BUFFER mailboxes for each child that each hold
+            /// M_MAX_NUM_SAMPLE_REGION samples
             std::vector <struct geopm_sample_message_s> m_sample_mailbox;
+            /// Persistent receive for each mailbox, child major
             std::vector<MPI_Request> m_sample_request;
-            struct geopm_policy_message_s m_policy_mailbox;
-            MPI_Request m_policy_request;
+            /// Mailbox of each child that is receiving
+            std::vector<int> m_sample_active;
+            /// Request of each child that is receiving, passed to
+            /// MPI_Testsome()
+            std::vector<MPI_Request> m_sample_active_request;
+            std::vector<int> m_sample_complete;
+            std::vector<MPI_Status> m_sample_status;
+            std::vector<MPI_Request> m_sample_restart;
+            /// Last samples received from each child
+            std::vector<std::vector<struct geopm_sample_message_s> > m_sample_last;
+            /// Sample of child received since the last get_sample()
+            std::vector<bool> m_is_sample_fresh;
+            /// Number of get_sample() calls that returned the last
+            /// sample of each child, -1 if none has been received
+            std::vector<int> m_sample_age;
+            /// M_NUM_BUFFER outboxes of M_MAX_NUM_SAMPLE_REGION
+            /// samples
+            std::vector<struct geopm_sample_message_s> m_sample_outbox;
+            /// Persistent send for each outbox and message length,
+            /// created on first use
+            std::vector<MPI_Request> m_sample_send_request;
+            /// Index into m_sample_send_request of the send in
+            /// flight from each outbox, -1 if none
+            std::vector<int> m_sample_send_active;
+            struct geopm_policy_message_s m_policy_mailbox[M_NUM_BUFFER];
+            MPI_Request m_policy_request[M_NUM_BUFFER];
+            int m_policy_active;
             struct geopm_policy_message_s m_policy;
+            /// M_NUM_BUFFER outboxes with a policy for each child,
+            /// child major
+            std::vector<struct geopm_policy_message_s> m_policy_outbox;
+            std::vector<MPI_Request> m_policy_send_request;
+            std::vector<bool> m_is_policy_send_active;
     };
 
+#ifdef GEOPM_ENABLE_MPI3
+    /// @brief RMATreeCommunicatorLevel class implements the per-level
+    /// communication with MPI-3 one-sided operations.
+    ///
+    /// The root of the level exposes a window with one sample slot
+    /// for each member of the level, and every member exposes a
+    /// window with a single policy slot.  Senders put their latest
+    /// message along with a sequence number into the slot of the
+    /// receiver.  A newer message replaces an older one that has not
+    /// been read, and no message is dropped because the receiver is
+    /// not ready.  The receiver copies its slots out under an
+    /// exclusive lock on its own window, which gives a consistent
+    /// snapshot without managing a request per sender.
+    class RMATreeCommunicatorLevel : public TreeCommunicatorLevelBase
+    {
+        public:
+            RMATreeCommunicatorLevel(MPI_Comm comm);
+            virtual ~RMATreeCommunicatorLevel();
+            /// Copy the sample slot of each child into sample if
+            /// every child has put a new sample since the last call,
+            /// or at least one has and the others have been reused
+            /// fewer than max_age times, otherwise throw
+            /// geopm::Exception with err_value() of
+            /// GEOPM_ERROR_SAMPLE_INCOMPLETE.
+            void get_sample(std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age, int max_age);
+            /// Read the policy slot and if the root has put a new
+            /// policy since the last call copy it to m_policy.  If
+            /// no policy has been put throw a geopm::Exception with
+            /// err_value() of GEOPM_ERROR_POLICY_UNKNOWN.
+            void get_policy(struct geopm_policy_message_s &policy);
+            /// Put samples into the slot for the calling process in
+            /// the window of the root of the level.
+            void send_sample(const std::vector<struct geopm_sample_message_s> &sample);
+            /// Put a policy into the window of each member of the
+            /// level.
+            void send_policy(const std::vector<struct geopm_policy_message_s> &policy, size_t length);
+            /// Returns the level rank of the calling process.
+            int level_rank(void);
+        protected:
+            struct m_sample_slot_s {
+                uint64_t sequence;
+                int num_sample;
+                struct geopm_sample_message_s sample[TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION];
+            };
+            struct m_policy_slot_s {
+                uint64_t sequence;
+                struct geopm_policy_message_s policy;
+            };
+            MPI_Comm m_comm;
+            int m_size;
+            int m_rank;
+            /// Window with m_size sample slots on the root, empty
+            /// on all other members.
+            MPI_Win m_sample_win;
+            struct m_sample_slot_s *m_sample_slot;
+            /// Copy of the sample slots taken by get_sample().
+            std::vector<struct m_sample_slot_s> m_sample_snapshot;
+            /// Sequence number of the last sample read from each
+            /// child.
+            std::vector<uint64_t> m_sample_sequence_read;
+            /// Slot of child written since the last get_sample()
+            std::vector<bool> m_is_sample_fresh;
+            /// Number of get_sample() calls that returned the current
+            /// slot of each child, -1 if it was never written
+            std::vector<int> m_sample_age;
+            /// Sequence number of the last sample sent.
+            uint64_t m_sample_sequence;
+            /// Window with one policy slot on every member.
+            MPI_Win m_policy_win;
+            struct m_policy_slot_s *m_policy_slot;
+            /// Sequence number of the last policy read.
+            uint64_t m_policy_sequence_read;
+            /// Sequence number of the last policy sent.
+            uint64_t m_policy_sequence;
+            struct geopm_policy_message_s m_policy;
+    };
+#endif
+
     /////////////////////////////////
     // Static function definitions //
     /////////////////////////////////
 
     static MPI_Datatype create_sample_mpi_type(void)
     {
-        int blocklength[4] = {1, 1, 1, 1};
-        MPI_Datatype mpi_type[5] = {MPI_INT,
-                                    MPI_DOUBLE,
-                                    MPI_DOUBLE,
+        int blocklength[2] = {1, GEOPM_NUM_SAMPLE_TYPE};
+        MPI_Datatype mpi_type[2] = {MPI_UINT64_T,
                                     MPI_DOUBLE
                                    };
-        MPI_Aint offset[4];
+        MPI_Aint offset[2];
+        MPI_Datatype tmp_type;
         MPI_Datatype result;
         offset[0] = offsetof(struct geopm_sample_message_s, region_id);
         offset[1] = offsetof(struct geopm_sample_message_s, signal);
-        offset[2] = offset[1] + sizeof(double);
-        offset[3] = offset[2] + sizeof(double);
-        check_mpi(MPI_Type_create_struct(4, blocklength, offset, mpi_type, &result));
+        check_mpi(MPI_Type_create_struct(2, blocklength, offset, mpi_type, &tmp_type));
+        // Extent must match the structure so that arrays of samples
+        // can be sent in one message
+        check_mpi(MPI_Type_create_resized(tmp_type, 0, sizeof(struct geopm_sample_message_s), &result));
+        check_mpi(MPI_Type_free(&tmp_type));
         check_mpi(MPI_Type_commit(&result));
         return result;
     }
@@ -295,16 +508,102 @@ namespace geopm
         return result;
     }
 
+    /// Samples from a level can be aggregated if at least one child
+    /// sample is fresh and the sample of every other child has been
+    /// returned fewer than max_age times.  If so age is advanced.
+    static bool update_sample_age(const std::vector<bool> &is_fresh, int max_age, std::vector<int> &age)
+    {
+        bool result = false;
+        for (size_t i = 0; i < is_fresh.size(); ++i) {
+            if (is_fresh[i]) {
+                result = true;
+            }
+            else if (age[i] < 0 || age[i] >= max_age) {
+                return false;
+            }
+        }
+        if (result) {
+            for (size_t i = 0; i < is_fresh.size(); ++i) {
+                age[i] = is_fresh[i] ? 0 : age[i] + 1;
+            }
+        }
+        return result;
+    }
+
+    /// Key that groups the calling host with its neighbors in the
+    /// network as described by the GEOPM_TREE_TOPOLOGY syntax.
+    static std::string topology_key(const std::string &topology)
+    {
+        char hostname[NAME_MAX];
+        std::string result;
+
+        int err = gethostname(hostname, NAME_MAX);
+        if (err) {
+            throw Exception("topology_key(): gethostname() failed", err, __FILE__, __LINE__);
+        }
+        hostname[NAME_MAX - 1] = '\0';
+        result = hostname;
+        if (topology.compare(0, strlen("hostname:"), "hostname:") == 0) {
+            std::smatch match;
+            std::regex pattern;
+            try {
+                pattern.assign(topology.substr(strlen("hostname:")));
+            }
+            catch (const std::regex_error &) {
+                throw Exception("topology_key(): invalid host name regular expression: " + topology, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            std::string host(hostname);
+            if (std::regex_search(host, match, pattern)) {
+                result = match.size() > 1 ? match[1].str() : match[0].str();
+            }
+        }
+        else if (topology.compare(0, strlen("file:"), "file:") == 0) {
+            std::string path(topology.substr(strlen("file:")));
+            std::ifstream topology_file(path);
+            if (!topology_file.is_open()) {
+                throw Exception("topology_key(): unable to open " + path, GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            std::string line;
+            while (std::getline(topology_file, line)) {
+                std::istringstream line_stream(line);
+                std::string host, group;
+                if ((line_stream >> host >> group) && host == result) {
+                    result = group;
+                    break;
+                }
+            }
+        }
+        else {
+            throw Exception("topology_key(): unknown topology description: " + topology, GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
     ///////////////////////////////////
     // TreeCommunicator public API's //
     ///////////////////////////////////
 
     TreeCommunicator::TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm)
+        : TreeCommunicator(fan_out, global_policy, comm, geopm_env_do_tree_rma())
+    {
+
+    }
+
+    TreeCommunicator::TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm, bool is_rma)
+        : TreeCommunicator(fan_out, global_policy, comm, is_rma, geopm_env_tree_topology())
+    {
+
+    }
+
+    TreeCommunicator::TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm, bool is_rma, const std::string &topology)
         : m_num_node(0)
         , m_fan_out(fan_out)
         , m_comm(fan_out.size())
         , m_global_policy(global_policy)
         , m_level(fan_out.size())
+        , m_is_rma(is_rma)
+        , m_topology(topology)
+        , m_max_sample_age(geopm_env_max_sample_age())
     {
         mpi_type_create();
         comm_create(comm);
@@ -344,10 +643,18 @@ namespace geopm
     }
 
     void TreeCommunicator::send_sample(int level, const struct geopm_sample_message_s &sample)
+    {
+        send_sample(level, std::vector<struct geopm_sample_message_s>(1, sample));
+    }
+
+    void TreeCommunicator::send_sample(int level, const std::vector<struct geopm_sample_message_s> &sample)
     {
         if (level < 0 || level >= num_level() || level == root_level()) {
             throw Exception("TreeCommunicator::send_sample()", GEOPM_ERROR_LEVEL_RANGE, __FILE__, __LINE__);
         }
+        if (sample.empty() || sample.size() > (size_t)M_MAX_NUM_SAMPLE_REGION) {
+            throw Exception("TreeCommunicator::send_sample(): number of region samples out of range", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
         m_level[level]->send_sample(sample);
     }
 
@@ -362,11 +669,37 @@ namespace geopm
     }
 
     void TreeCommunicator::get_sample(int level, std::vector<struct geopm_sample_message_s> &sample)
+    {
+        m_sample_age.resize(sample.size());
+        get_sample(level, sample, m_sample_age);
+    }
+
+    void TreeCommunicator::get_sample(int level, std::vector<struct geopm_sample_message_s> &sample, std::vector<int> &age)
+    {
+        m_sample_region.resize(sample.size());
+        get_sample(level, m_sample_region, age);
+        auto sample_it = sample.begin();
+        for (auto region_it = m_sample_region.begin(); region_it != m_sample_region.end(); ++region_it, ++sample_it) {
+            if (!(*region_it).empty()) {
+                *sample_it = (*region_it)[0];
+            }
+        }
+    }
+
+    void TreeCommunicator::get_sample(int level, std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age)
     {
         if (level <= 0 || level >= num_level()) {
             throw Exception("TreeCommunicator::get_sample()", GEOPM_ERROR_LEVEL_RANGE, __FILE__, __LINE__);
         }
-        m_level[level - 1]->get_sample(sample);
+        m_level[level - 1]->get_sample(sample, age, m_max_sample_age);
+    }
+
+    void TreeCommunicator::max_sample_age(int max_age)
+    {
+        if (max_age < 0) {
+            throw Exception("TreeCommunicator::max_sample_age(): age must be non-negative", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_max_sample_age = max_age;
     }
 
     void TreeCommunicator::get_policy(int level, struct geopm_policy_message_s &policy)
@@ -403,10 +736,19 @@ namespace geopm
         std::vector<int> flags(num_dim);
         std::vector<int> coords(num_dim);
         int rank_cart;
+        MPI_Comm topology_comm = MPI_COMM_NULL;
 
         memset(flags.data(), 0, sizeof(int)*num_dim);
         flags[0] = 1;
-        check_mpi(MPI_Cart_create(comm, num_dim, m_fan_out.data(), flags.data(), 1, &comm_cart));
+        if (m_topology.size()) {
+            // Ranks are already placed, so MPI may not reorder them
+            topology_comm_create(comm, topology_comm);
+            check_mpi(MPI_Cart_create(topology_comm, num_dim, m_fan_out.data(), flags.data(), 0, &comm_cart));
+            check_mpi(MPI_Comm_free(&topology_comm));
+        }
+        else {
+            check_mpi(MPI_Cart_create(comm, num_dim, m_fan_out.data(), flags.data(), 1, &comm_cart));
+        }
         check_mpi(MPI_Comm_rank(comm_cart, &rank_cart));
         check_mpi(MPI_Cart_coords(comm_cart, rank_cart, num_dim, coords.data()));
         check_mpi(MPI_Cart_sub(comm_cart, flags.data(), &(m_comm[0])));
@@ -444,6 +786,54 @@ namespace geopm
         }
     }
 
+    void TreeCommunicator::topology_comm_create(const MPI_Comm &comm, MPI_Comm &topology_comm)
+    {
+        struct m_topology_s {
+            char key[NAME_MAX];
+            int is_root;
+        } local, *all;
+        int rank, size;
+
+        check_mpi(MPI_Comm_rank(comm, &rank));
+        check_mpi(MPI_Comm_size(comm, &size));
+        std::string key(topology_key(m_topology));
+        strncpy(local.key, key.c_str(), NAME_MAX - 1);
+        local.key[NAME_MAX - 1] = '\0';
+        local.is_root = m_global_policy != NULL;
+        std::vector<struct m_topology_s> topology(size);
+        all = topology.data();
+        check_mpi(MPI_Allgather(&local, sizeof(local), MPI_BYTE, all, sizeof(local), MPI_BYTE, comm));
+
+        // The group of the root comes first with the root at its
+        // head, then the other groups, each ordered by rank.
+        std::string root_key;
+        for (auto it = topology.begin(); it != topology.end(); ++it) {
+            if ((*it).is_root) {
+                root_key = (*it).key;
+            }
+        }
+        std::vector<int> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&topology, &root_key](int a, int b) {
+            std::string key_a(topology[a].key);
+            std::string key_b(topology[b].key);
+            return std::make_tuple(key_a != root_key, key_a, !topology[a].is_root, a) <
+                   std::make_tuple(key_b != root_key, key_b, !topology[b].is_root, b);
+        });
+        int position = std::find(order.begin(), order.end(), rank) - order.begin();
+
+        // Fill the leaf groups of the Cartesian layout in order.
+        // Members of a leaf group differ only in the first
+        // coordinate, which varies slowest in rank order.
+        int num_tree = std::accumulate(m_fan_out.begin(), m_fan_out.end(), 1, std::multiplies<int>());
+        int num_leaf_group = num_tree / m_fan_out[0];
+        int tree_rank = position;
+        if (position < num_tree) {
+            tree_rank = (position % m_fan_out[0]) * num_leaf_group + position / m_fan_out[0];
+        }
+        check_mpi(MPI_Comm_split(comm, 0, tree_rank, &topology_comm));
+    }
+
     void TreeCommunicator::level_create(void)
     {
         if (num_level() == root_level() + 1) {
@@ -456,6 +846,12 @@ namespace geopm
         auto comm_it = m_comm.begin();
         auto level_it = m_level.begin();
         for (; level_it < m_level.end(); ++level_it, ++comm_it) {
+#ifdef GEOPM_ENABLE_MPI3
+            if (m_is_rma) {
+                *level_it = new RMATreeCommunicatorLevel(*comm_it);
+                continue;
+            }
+#endif
             *level_it = new TreeCommunicatorLevel(*comm_it, m_sample_mpi_type, m_policy_mpi_type);
         }
     }
@@ -488,13 +884,24 @@ namespace geopm
         : m_comm(comm)
         , m_sample_mpi_type(sample_mpi_type)
         , m_policy_mpi_type(policy_mpi_type)
-        , m_policy_request(MPI_REQUEST_NULL)
+        , m_sample_outbox(M_NUM_BUFFER * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION)
+        , m_sample_send_request(M_NUM_BUFFER * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION, MPI_REQUEST_NULL)
+        , m_sample_send_active(M_NUM_BUFFER, -1)
+        , m_policy_active(0)
     {
         check_mpi(MPI_Comm_size(comm, &m_size));
         check_mpi(MPI_Comm_rank(comm, &m_rank));
-        m_sample_mailbox.resize(m_size);
-        m_sample_request.resize(m_size);
-        std::fill(m_sample_request.begin(), m_sample_request.end(), MPI_REQUEST_NULL);
+        m_sample_mailbox.resize(M_NUM_BUFFER * m_size * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION);
+        m_sample_request.resize(M_NUM_BUFFER * m_size, MPI_REQUEST_NULL);
+        m_sample_active.resize(m_size, 0);
+        m_sample_active_request.resize(m_size, MPI_REQUEST_NULL);
+        m_sample_complete.resize(m_size);
+        m_sample_status.resize(m_size);
+        m_sample_restart.resize(m_size);
+        m_sample_last.resize(m_size, std::vector<struct geopm_sample_message_s>(1, GEOPM_SAMPLE_INVALID));
+        m_is_sample_fresh.resize(m_size, false);
+        m_sample_age.resize(m_size, -1);
+        std::fill(m_policy_request, m_policy_request + M_NUM_BUFFER, MPI_REQUEST_NULL);
         m_policy = GEOPM_POLICY_UNKNOWN;
         open_recv();
     }
@@ -504,29 +911,45 @@ namespace geopm
         close_recv();
     }
 
-    void TreeCommunicatorLevel::get_sample(std::vector<struct geopm_sample_message_s> &sample)
+    void TreeCommunicatorLevel::get_sample(std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age, int max_age)
     {
-        int is_complete;
-        int source;
-        MPI_Status status;
+        int num_complete;
+        int count;
 
-        for (auto request_it = m_sample_request.begin(); request_it < m_sample_request.end(); ++request_it) {
-            check_mpi(MPI_Test(&(*request_it), &is_complete, &status));
-            if (!is_complete) {
-                throw Exception("TreeCommunicatorLevel::get_sample", GEOPM_ERROR_SAMPLE_INCOMPLETE, __FILE__, __LINE__);
-            }
-        }
-        if (sample.size() < m_sample_mailbox.size()) {
+        if (sample.size() < (size_t)m_size ||
+            age.size() < (size_t)m_size) {
             throw Exception("input sample vector too small", GEOPM_ERROR_CTL_COMM, __FILE__, __LINE__);
         }
-        copy(m_sample_mailbox.begin(), m_sample_mailbox.end(), sample.begin());
-        source = 0;
-        auto request_it = m_sample_request.begin();
-        auto sample_it = m_sample_mailbox.begin();
-        for (; sample_it < m_sample_mailbox.end();
-             ++sample_it, ++request_it, ++source) {
-            check_mpi(MPI_Irecv(&(*sample_it), 1, m_sample_mpi_type, source, GEOPM_SAMPLE_TAG, m_comm, &(*request_it)));
+        check_mpi(MPI_Testsome(m_size, m_sample_active_request.data(), &num_complete,
+                               m_sample_complete.data(), m_sample_status.data()));
+        if (num_complete == MPI_UNDEFINED) {
+            num_complete = 0;
+        }
+        // Receive into the other mailbox before reading this one
+        for (int i = 0; i < num_complete; ++i) {
+            int source = m_sample_complete[i];
+            m_sample_active[source] = (m_sample_active[source] + 1) % M_NUM_BUFFER;
+            m_sample_active_request[source] = m_sample_request[source * M_NUM_BUFFER + m_sample_active[source]];
+            m_sample_restart[i] = m_sample_active_request[source];
         }
+        if (num_complete) {
+            check_mpi(MPI_Startall(num_complete, m_sample_restart.data()));
+        }
+        for (int i = 0; i < num_complete; ++i) {
+            int source = m_sample_complete[i];
+            int buffer = (m_sample_active[source] + M_NUM_BUFFER - 1) % M_NUM_BUFFER;
+            auto mailbox_it = m_sample_mailbox.begin() +
+                              (source * M_NUM_BUFFER + buffer) * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION;
+            check_mpi(MPI_Get_count(&(m_sample_status[i]), m_sample_mpi_type, &count));
+            m_sample_last[source].assign(mailbox_it, mailbox_it + count);
+            m_is_sample_fresh[source] = true;
+        }
+        if (!update_sample_age(m_is_sample_fresh, max_age, m_sample_age)) {
+            throw Exception("TreeCommunicatorLevel::get_sample", GEOPM_ERROR_SAMPLE_INCOMPLETE, __FILE__, __LINE__);
+        }
+        copy(m_sample_last.begin(), m_sample_last.end(), sample.begin());
+        copy(m_sample_age.begin(), m_sample_age.end(), age.begin());
+        std::fill(m_is_sample_fresh.begin(), m_is_sample_fresh.end(), false);
     }
 
     void TreeCommunicatorLevel::get_policy(struct geopm_policy_message_s &policy)
@@ -534,10 +957,12 @@ namespace geopm
         int is_complete;
         MPI_Status status;
 
-        check_mpi(MPI_Test(&m_policy_request, &is_complete, &status));
+        check_mpi(MPI_Test(&(m_policy_request[m_policy_active]), &is_complete, &status));
         if (is_complete) {
-            m_policy = m_policy_mailbox;
-            check_mpi(MPI_Irecv(&m_policy_mailbox, 1, m_policy_mpi_type, 0, GEOPM_POLICY_TAG, m_comm, &m_policy_request));
+            int buffer = m_policy_active;
+            m_policy_active = (m_policy_active + 1) % M_NUM_BUFFER;
+            check_mpi(MPI_Start(&(m_policy_request[m_policy_active])));
+            m_policy = m_policy_mailbox[buffer];
         }
         policy = m_policy;
         if (geopm_is_policy_equal(&policy, &GEOPM_POLICY_UNKNOWN)) {
@@ -545,28 +970,78 @@ namespace geopm
         }
     }
 
-    void TreeCommunicatorLevel::send_sample(const struct geopm_sample_message_s &sample)
+    bool TreeCommunicatorLevel::is_request_free(MPI_Request &request, bool &is_active)
     {
-        MPI_Request request;
+        if (is_active) {
+            int is_complete = 0;
+            MPI_Status status;
+            (void) MPI_Test(&request, &is_complete, &status);
+            is_active = !is_complete;
+        }
+        return !is_active;
+    }
 
-        // Don't check return code or hold onto request, drop message if receiver not ready
-        (void) MPI_Isend(const_cast<struct geopm_sample_message_s*>(&sample), 1, m_sample_mpi_type, 0, GEOPM_SAMPLE_TAG, m_comm, &request);
-        (void) MPI_Request_free(&request);
+    void TreeCommunicatorLevel::send_sample(const std::vector<struct geopm_sample_message_s> &sample)
+    {
+        int buffer;
+        for (buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+            int send_idx = m_sample_send_active[buffer];
+            bool is_active = send_idx != -1;
+            if (!is_active || is_request_free(m_sample_send_request[send_idx], is_active)) {
+                break;
+            }
+        }
+        if (buffer == M_NUM_BUFFER) {
+            MPI_Request request;
+            // Don't check return code or hold onto request, drop message if receiver not ready
+            (void) MPI_Isend(const_cast<struct geopm_sample_message_s*>(sample.data()), sample.size(), m_sample_mpi_type, 0, GEOPM_SAMPLE_TAG, m_comm, &request);
+            (void) MPI_Request_free(&request);
+            return;
+        }
+        auto outbox_it = m_sample_outbox.begin() + buffer * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION;
+        std::copy(sample.begin(), sample.end(), outbox_it);
+        // One persistent request for each outbox and message length
+        int send_idx = buffer * TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION + sample.size() - 1;
+        if (m_sample_send_request[send_idx] == MPI_REQUEST_NULL) {
+            check_mpi(MPI_Send_init(&(*outbox_it), sample.size(), m_sample_mpi_type, 0, GEOPM_SAMPLE_TAG, m_comm, &(m_sample_send_request[send_idx])));
+        }
+        (void) MPI_Start(&(m_sample_send_request[send_idx]));
+        m_sample_send_active[buffer] = send_idx;
     }
 
     void TreeCommunicatorLevel::send_policy(const std::vector<struct geopm_policy_message_s> &policy, size_t length)
     {
         size_t dest;
-        MPI_Request request;
 
         if (m_rank != 0) {
             throw Exception("called send_policy() from rank not at root of level", GEOPM_ERROR_CTL_COMM, __FILE__, __LINE__);
         }
+        if (length > (size_t)m_size) {
+            length = m_size;
+        }
         dest = 0;
         for (auto policy_it = policy.begin(); dest != length; ++policy_it, ++dest) {
-            // Don't check return code or hold onto request, drop message if receiver not ready
-            (void) MPI_Isend(const_cast<struct geopm_policy_message_s*>(&(*policy_it)), 1, m_policy_mpi_type, dest, GEOPM_POLICY_TAG, m_comm, &request);
-            (void) MPI_Request_free(&request);
+            int buffer;
+            for (buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+                int send_idx = dest * M_NUM_BUFFER + buffer;
+                bool is_active = m_is_policy_send_active[send_idx];
+                if (is_request_free(m_policy_send_request[send_idx], is_active)) {
+                    break;
+                }
+                m_is_policy_send_active[send_idx] = is_active;
+            }
+            if (buffer == M_NUM_BUFFER) {
+                MPI_Request request;
+                // Don't check return code or hold onto request, drop message if receiver not ready
+                (void) MPI_Isend(const_cast<struct geopm_policy_message_s*>(&(*policy_it)), 1, m_policy_mpi_type, dest, GEOPM_POLICY_TAG, m_comm, &request);
+                (void) MPI_Request_free(&request);
+            }
+            else {
+                int send_idx = dest * M_NUM_BUFFER + buffer;
+                m_policy_outbox[send_idx] = *policy_it;
+                (void) MPI_Start(&(m_policy_send_request[send_idx]));
+                m_is_policy_send_active[send_idx] = true;
+            }
         }
     }
 
@@ -577,39 +1052,224 @@ namespace geopm
 
     void TreeCommunicatorLevel::open_recv(void)
     {
-        check_mpi(MPI_Irecv(&m_policy_mailbox, 1, m_policy_mpi_type, 0, GEOPM_POLICY_TAG, m_comm, &m_policy_request));
+        for (int buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+            check_mpi(MPI_Recv_init(&(m_policy_mailbox[buffer]), 1, m_policy_mpi_type, 0, GEOPM_POLICY_TAG, m_comm, &(m_policy_request[buffer])));
+        }
+        check_mpi(MPI_Start(&(m_policy_request[m_policy_active])));
         if (m_rank == 0) {
-            int source = 0;
-            auto request_it = m_sample_request.begin();
             auto sample_it = m_sample_mailbox.begin();
-            for (; sample_it < m_sample_mailbox.end();
-                 ++sample_it, ++request_it, ++source) {
-                check_mpi(MPI_Irecv(&(*sample_it), 1, m_sample_mpi_type, source, GEOPM_SAMPLE_TAG, m_comm, &(*request_it)));
+            for (int source = 0; source < m_size; ++source) {
+                for (int buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+                    check_mpi(MPI_Recv_init(&(*sample_it), TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION, m_sample_mpi_type, source, GEOPM_SAMPLE_TAG, m_comm,
+                                            &(m_sample_request[source * M_NUM_BUFFER + buffer])));
+                    sample_it += TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION;
+                }
+                m_sample_active_request[source] = m_sample_request[source * M_NUM_BUFFER];
+            }
+            check_mpi(MPI_Startall(m_size, m_sample_active_request.data()));
+            m_policy_outbox.resize(M_NUM_BUFFER * m_size, GEOPM_POLICY_UNKNOWN);
+            m_policy_send_request.resize(M_NUM_BUFFER * m_size, MPI_REQUEST_NULL);
+            m_is_policy_send_active.resize(M_NUM_BUFFER * m_size, false);
+            for (int dest = 0; dest < m_size; ++dest) {
+                for (int buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+                    int send_idx = dest * M_NUM_BUFFER + buffer;
+                    check_mpi(MPI_Send_init(&(m_policy_outbox[send_idx]), 1, m_policy_mpi_type, dest, GEOPM_POLICY_TAG, m_comm, &(m_policy_send_request[send_idx])));
+                }
             }
         }
     }
 
     void TreeCommunicatorLevel::close_recv(void)
     {
-        if (m_policy_request != MPI_REQUEST_NULL) {
-            check_mpi(MPI_Cancel(&m_policy_request));
-            check_mpi(MPI_Request_free(&m_policy_request));
+        MPI_Status status;
+
+#ifdef GEOPM_ENABLE_MPI3
+        // Messages sent before the barrier are matched before it
+        // completes, so none can reach a later communicator that
+        // reuses the context of this one.  The wait is bounded so
+        // that a rank unwinding on an error does not hang: on
+        // timeout the barrier request is freed and teardown
+        // continues locally.
+        MPI_Request barrier_request;
+        int is_complete = 0;
+        struct geopm_time_s start, curr;
+        check_mpi(MPI_Ibarrier(m_comm, &barrier_request));
+        geopm_time(&start);
+        curr = start;
+        check_mpi(MPI_Test(&barrier_request, &is_complete, MPI_STATUS_IGNORE));
+        while (!is_complete && geopm_time_diff(&start, &curr) < M_CLOSE_TIMEOUT) {
+            (void)nanosleep(&M_CLOSE_POLL_DELAY, NULL);
+            check_mpi(MPI_Test(&barrier_request, &is_complete, MPI_STATUS_IGNORE));
+            geopm_time(&curr);
+        }
+        if (!is_complete) {
+            // Freeing an incomplete barrier is only safe because the
+            // communicator is freed right after the levels are
+            // destroyed in TreeCommunicator::comm_destroy(), so the
+            // request can never match a later collective on it.
+            check_mpi(MPI_Request_free(&barrier_request));
+        }
+#endif
+        // Receives in flight are cancelled, sends in flight are
+        // freed once they complete
+        check_mpi(MPI_Cancel(&(m_policy_request[m_policy_active])));
+        check_mpi(MPI_Wait(&(m_policy_request[m_policy_active]), &status));
+        for (int buffer = 0; buffer < M_NUM_BUFFER; ++buffer) {
+            check_mpi(MPI_Request_free(&(m_policy_request[buffer])));
         }
         if (m_rank == 0) {
-            for (auto request_it = m_sample_request.begin();
-                 request_it < m_sample_request.end();
-                 ++request_it) {
-                if (m_policy_request != MPI_REQUEST_NULL) {
-                    check_mpi(MPI_Cancel(&(*request_it)));
-                    check_mpi(MPI_Request_free(&(*request_it)));
-                }
+            for (int source = 0; source < m_size; ++source) {
+                check_mpi(MPI_Cancel(&(m_sample_active_request[source])));
+                check_mpi(MPI_Wait(&(m_sample_active_request[source]), &status));
+            }
+            for (auto request_it = m_sample_request.begin(); request_it != m_sample_request.end(); ++request_it) {
+                check_mpi(MPI_Request_free(&(*request_it)));
+            }
+            for (auto request_it = m_policy_send_request.begin(); request_it != m_policy_send_request.end(); ++request_it) {
+                check_mpi(MPI_Request_free(&(*request_it)));
+            }
+        }
+        for (auto request_it = m_sample_send_request.begin(); request_it != m_sample_send_request.end(); ++request_it) {
+            if (*request_it != MPI_REQUEST_NULL) {
+                check_mpi(MPI_Request_free(&(*request_it)));
             }
         }
     }
 
+#ifdef GEOPM_ENABLE_MPI3
+    ////////////////////////////////////
+    // RMATreeCommunicatorLevel API's //
+    ////////////////////////////////////
+
+    RMATreeCommunicatorLevel::RMATreeCommunicatorLevel(MPI_Comm comm)
+        : m_comm(comm)
+        , m_sample_win(MPI_WIN_NULL)
+        , m_sample_slot(NULL)
+        , m_sample_sequence(0)
+        , m_policy_win(MPI_WIN_NULL)
+        , m_policy_slot(NULL)
+        , m_policy_sequence_read(0)
+        , m_policy_sequence(0)
+        , m_policy(GEOPM_POLICY_UNKNOWN)
+    {
+        check_mpi(MPI_Comm_size(comm, &m_size));
+        check_mpi(MPI_Comm_rank(comm, &m_rank));
+        MPI_Aint sample_win_size = m_rank == 0 ? m_size * sizeof(struct m_sample_slot_s) : 0;
+        check_mpi(MPI_Win_allocate(sample_win_size, sizeof(struct m_sample_slot_s), MPI_INFO_NULL,
+                                   m_comm, &m_sample_slot, &m_sample_win));
+        check_mpi(MPI_Win_allocate(sizeof(struct m_policy_slot_s), sizeof(struct m_policy_slot_s), MPI_INFO_NULL,
+                                   m_comm, &m_policy_slot, &m_policy_win));
+        // Sequence number zero marks a slot that has never been written
+        check_mpi(MPI_Win_lock(MPI_LOCK_EXCLUSIVE, m_rank, 0, m_policy_win));
+        m_policy_slot->sequence = 0;
+        m_policy_slot->policy = GEOPM_POLICY_UNKNOWN;
+        check_mpi(MPI_Win_unlock(m_rank, m_policy_win));
+        if (m_rank == 0) {
+            m_sample_snapshot.resize(m_size);
+            m_sample_sequence_read.resize(m_size, 0);
+            m_is_sample_fresh.resize(m_size, false);
+            m_sample_age.resize(m_size, -1);
+            check_mpi(MPI_Win_lock(MPI_LOCK_EXCLUSIVE, m_rank, 0, m_sample_win));
+            for (int i = 0; i < m_size; ++i) {
+                m_sample_slot[i].sequence = 0;
+                m_sample_slot[i].num_sample = 1;
+                m_sample_slot[i].sample[0] = GEOPM_SAMPLE_INVALID;
+            }
+            check_mpi(MPI_Win_unlock(m_rank, m_sample_win));
+        }
+        // No member may put before the slots are initialized
+        check_mpi(MPI_Barrier(m_comm));
+    }
+
+    RMATreeCommunicatorLevel::~RMATreeCommunicatorLevel()
+    {
+        check_mpi(MPI_Win_free(&m_policy_win));
+        check_mpi(MPI_Win_free(&m_sample_win));
+    }
+
+    void RMATreeCommunicatorLevel::get_sample(std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age, int max_age)
+    {
+        if (m_rank != 0) {
+            throw Exception("called get_sample() from rank not at root of level", GEOPM_ERROR_CTL_COMM, __FILE__, __LINE__);
+        }
+        if (sample.size() < (size_t)m_size || age.size() < (size_t)m_size) {
+            throw Exception("input sample vector too small", GEOPM_ERROR_CTL_COMM, __FILE__, __LINE__);
+        }
+        check_mpi(MPI_Win_lock(MPI_LOCK_EXCLUSIVE, m_rank, 0, m_sample_win));
+        std::copy(m_sample_slot, m_sample_slot + m_size, m_sample_snapshot.begin());
+        check_mpi(MPI_Win_unlock(m_rank, m_sample_win));
+        for (int i = 0; i < m_size; ++i) {
+            m_is_sample_fresh[i] = m_sample_snapshot[i].sequence != m_sample_sequence_read[i];
+        }
+        if (!update_sample_age(m_is_sample_fresh, max_age, m_sample_age)) {
+            throw Exception("RMATreeCommunicatorLevel::get_sample", GEOPM_ERROR_SAMPLE_INCOMPLETE, __FILE__, __LINE__);
+        }
+        // A slot that was not written since the last call still holds
+        // the last known sample of the child
+        for (int i = 0; i < m_size; ++i) {
+            sample[i].assign(m_sample_snapshot[i].sample,
+                             m_sample_snapshot[i].sample + m_sample_snapshot[i].num_sample);
+            age[i] = m_sample_age[i];
+            m_sample_sequence_read[i] = m_sample_snapshot[i].sequence;
+        }
+    }
+
+    void RMATreeCommunicatorLevel::get_policy(struct geopm_policy_message_s &policy)
+    {
+        struct m_policy_slot_s slot;
+
+        check_mpi(MPI_Win_lock(MPI_LOCK_EXCLUSIVE, m_rank, 0, m_policy_win));
+        slot = *m_policy_slot;
+        check_mpi(MPI_Win_unlock(m_rank, m_policy_win));
+        if (slot.sequence != m_policy_sequence_read) {
+            m_policy = slot.policy;
+            m_policy_sequence_read = slot.sequence;
+        }
+        policy = m_policy;
+        if (geopm_is_policy_equal(&policy, &GEOPM_POLICY_UNKNOWN)) {
+            throw Exception("RMATreeCommunicatorLevel::get_policy", GEOPM_ERROR_POLICY_UNKNOWN, __FILE__, __LINE__);
+        }
+    }
+
+    void RMATreeCommunicatorLevel::send_sample(const std::vector<struct geopm_sample_message_s> &sample)
+    {
+        struct m_sample_slot_s slot;
+        slot.sequence = ++m_sample_sequence;
+        slot.num_sample = sample.size();
+        std::copy(sample.begin(), sample.end(), slot.sample);
+        // Only the samples in use are transferred
+        int size = offsetof(struct m_sample_slot_s, sample) + sample.size() * sizeof(struct geopm_sample_message_s);
+
+        check_mpi(MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, m_sample_win));
+        check_mpi(MPI_Put(&slot, size, MPI_BYTE, 0, m_rank, size, MPI_BYTE, m_sample_win));
+        check_mpi(MPI_Win_unlock(0, m_sample_win));
+    }
+
+    void RMATreeCommunicatorLevel::send_policy(const std::vector<struct geopm_policy_message_s> &policy, size_t length)
+    {
+        if (m_rank != 0) {
+            throw Exception("called send_policy() from rank not at root of level", GEOPM_ERROR_CTL_COMM, __FILE__, __LINE__);
+        }
+        struct m_policy_slot_s slot;
+        slot.sequence = ++m_policy_sequence;
+        int dest = 0;
+        for (auto policy_it = policy.begin(); dest != (int)length; ++policy_it, ++dest) {
+            slot.policy = *policy_it;
+            check_mpi(MPI_Win_lock(MPI_LOCK_SHARED, dest, 0, m_policy_win));
+            check_mpi(MPI_Put(&slot, sizeof(slot), MPI_BYTE, dest, 0, sizeof(slot), MPI_BYTE, m_policy_win));
+            check_mpi(MPI_Win_unlock(dest, m_policy_win));
+        }
+    }
+
+    int RMATreeCommunicatorLevel::level_rank(void)
+    {
+        return m_rank;
+    }
+#endif
+
     SingleTreeCommunicator::SingleTreeCommunicator(GlobalPolicy *global_policy)
         : m_policy(global_policy)
-        , m_sample(GEOPM_SAMPLE_INVALID)
+        , m_sample(1, GEOPM_SAMPLE_INVALID)
     {
 
     }
@@ -640,6 +1300,11 @@ namespace geopm
     }
 
     void SingleTreeCommunicator::send_sample(int level, const struct geopm_sample_message_s &sample)
+    {
+        m_sample.assign(1, sample);
+    }
+
+    void SingleTreeCommunicator::send_sample(int level, const std::vector<struct geopm_sample_message_s> &sample)
     {
         m_sample = sample;
     }
@@ -650,8 +1315,20 @@ namespace geopm
     }
 
     void SingleTreeCommunicator::get_sample(int level, std::vector<struct geopm_sample_message_s> &sample)
+    {
+        sample[0] = m_sample[0];
+    }
+
+    void SingleTreeCommunicator::get_sample(int level, std::vector<struct geopm_sample_message_s> &sample, std::vector<int> &age)
+    {
+        sample[0] = m_sample[0];
+        age[0] = 0;
+    }
+
+    void SingleTreeCommunicator::get_sample(int level, std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age)
     {
         sample[0] = m_sample;
+        age[0] = 0;
     }
 
     void SingleTreeCommunicator::get_policy(int level, struct geopm_policy_message_s &policy)
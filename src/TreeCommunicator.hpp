@@ -34,6 +34,7 @@
 #define TREECOMMUNICATOR_HPP_INCLUDE
 
 #include <vector>
+#include <string>
 #include <mpi.h>
 #include <pthread.h>
 
@@ -45,7 +46,7 @@ namespace geopm
     void check_mpi(int err);
 
     class TreeCommunicatorRoot;
-    class TreeCommunicatorLevel;
+    class TreeCommunicatorLevelBase;
     class GlobalPolicy;
 
     /// @brief Class which enables inter-process communication for
@@ -60,6 +61,11 @@ namespace geopm
     class TreeCommunicatorBase
     {
         public:
+            enum m_const_e {
+                /// Most region samples sent up the tree in one
+                /// message.
+                M_MAX_NUM_SAMPLE_REGION = 8,
+            };
             TreeCommunicatorBase() {}
             /// @brief TreeCommunicator destructor, virtual.
             virtual ~TreeCommunicatorBase() {}
@@ -68,8 +74,11 @@ namespace geopm
             virtual int level_rank(int level) const = 0;
             virtual int level_size(int level) const = 0;
             virtual void send_sample(int level, const struct geopm_sample_message_s &sample) = 0;
+            virtual void send_sample(int level, const std::vector<struct geopm_sample_message_s> &sample) = 0;
             virtual void send_policy(int level, const std::vector<struct geopm_policy_message_s> &policy) = 0;
             virtual void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample) = 0;
+            virtual void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample, std::vector<int> &age) = 0;
+            virtual void get_sample(int level, std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age) = 0;
             virtual void get_policy(int level, struct geopm_policy_message_s &policy) = 0;
     };
 
@@ -102,6 +111,58 @@ namespace geopm
             /// @param [in] comm All ranks in MPI communicator
             ///        participate in the tree.
             TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm);
+            /// @brief TreeCommunicator constructor with explicit
+            ///        selection of the communication backend.
+            ///
+            /// Same as the three argument constructor except that
+            /// the backend is chosen by the caller rather than by the
+            /// GEOPM_TREE_RMA environment variable.  All ranks in
+            /// the communicator must make the same choice.
+            ///
+            /// @param [in] fan_out Vector of fan out values for each
+            ///        level ordered from root to leaves.
+            ///
+            /// @param [in] global_policy Policy enforced at the root
+            ///        of the tree.
+            ///
+            /// @param [in] comm All ranks in MPI communicator
+            ///        participate in the tree.
+            ///
+            /// @param [in] is_rma If true samples and policies are
+            ///        passed with MPI-3 one-sided operations, each
+            ///        receiver exposes a window of message slots
+            ///        that the senders put into.  Otherwise
+            ///        non-blocking point to point messages are used.
+            ///        Ignored if the library was built without MPI-3
+            ///        support.
+            TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm, bool is_rma);
+            /// @brief TreeCommunicator constructor with explicit
+            ///        selection of the backend and node placement.
+            ///
+            /// Same as the four argument constructor except that the
+            /// ranks are placed in the tree according to topology
+            /// rather than the GEOPM_TREE_TOPOLOGY environment
+            /// variable.
+            ///
+            /// @param [in] fan_out Vector of fan out values for each
+            ///        level ordered from root to leaves.
+            ///
+            /// @param [in] global_policy Policy enforced at the root
+            ///        of the tree.
+            ///
+            /// @param [in] comm All ranks in MPI communicator
+            ///        participate in the tree.
+            ///
+            /// @param [in] is_rma Selects the one-sided backend.
+            ///
+            /// @param [in] topology Either "hostname:<regex>" to key
+            ///        each rank by the part of its host name matched
+            ///        by the regular expression, or "file:<path>" to
+            ///        look up the key in a file of host name and
+            ///        group pairs.  Ranks with the same key are
+            ///        placed in the same leaf groups where possible.
+            ///        If empty the tree is laid out in rank order.
+            TreeCommunicator(const std::vector<int> &fan_out, GlobalPolicy *global_policy, const MPI_Comm &comm, bool is_rma, const std::string &topology);
             /// @brief TreeCommunicator destructor, virtual.
             virtual ~TreeCommunicator();
             /// @brief The number of levels for calling process.
@@ -166,6 +227,21 @@ namespace geopm
             /// @param [in] sample The sample message sent from the
             ///        local process.
             void send_sample(int level, const struct geopm_sample_message_s &sample);
+            /// @brief Send samples for several regions up one level
+            ///        in a single message.
+            ///
+            /// Same as the single sample send_sample() except that
+            /// between one and M_MAX_NUM_SAMPLE_REGION samples, each
+            /// for a different region, are delivered together.  By
+            /// convention the first sample is for the outer sync
+            /// region, which is what the single sample get_sample()
+            /// returns for each child.
+            ///
+            /// @param [in] level The level that is sending the sample.
+            ///
+            /// @param [in] sample The sample messages sent from the
+            ///        local process.
+            void send_sample(int level, const std::vector<struct geopm_sample_message_s> &sample);
             /// @brief Send policy down one level.
             ///
             /// Called only by a root process of the level.  Send
@@ -192,6 +268,51 @@ namespace geopm
             /// @param [out] sample A vector of sample messages
             ///        collected from the level.
             void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample);
+            /// @brief Get samples from children, tolerating children
+            ///        that have not sent a new sample.
+            ///
+            /// Same as the two argument get_sample() except that
+            /// the last known sample of a child is reused if no new
+            /// one has arrived, provided that it has been reused for
+            /// fewer than max_sample_age() calls.  At least one
+            /// child must have sent a new sample.  Throws
+            /// geopm::Exception with err_value() of
+            /// GEOPM_ERROR_SAMPLE_INCOMPLETE otherwise.
+            ///
+            /// @param [in] level The level which is sending samples up.
+            ///
+            /// @param [out] sample A vector of sample messages
+            ///        collected from the level.
+            ///
+            /// @param [out] age For each member of the level the
+            ///        number of previous calls that have already
+            ///        returned its sample, zero if the sample is new.
+            void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample, std::vector<int> &age);
+            /// @brief Get every region sample sent by the children.
+            ///
+            /// Same as the three argument get_sample() except that
+            /// all of the samples in the last message from each
+            /// child are returned.
+            ///
+            /// @param [in] level The level which is sending samples up.
+            ///
+            /// @param [out] sample For each member of the level the
+            ///        samples it sent in one message, resized to the
+            ///        number sent.
+            ///
+            /// @param [out] age For each member of the level the
+            ///        number of previous calls that have already
+            ///        returned its samples, zero if they are new.
+            void get_sample(int level, std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age);
+            /// @brief Set the number of times a child sample may be
+            ///        reused by get_sample().
+            ///
+            /// The default is taken from the GEOPM_MAX_SAMPLE_AGE
+            /// environment variable, or zero if it is not set, in
+            /// which case every child must send a new sample.
+            ///
+            /// @param [in] max_age Maximum age of a child sample.
+            void max_sample_age(int max_age);
             /// @brief Get policy from parent.
             ///
             /// Record current policy for calling process on the
@@ -213,6 +334,10 @@ namespace geopm
             /// @brief Constructor helper to instantiate
             ///        sub-communicators.
             void comm_create(const MPI_Comm &comm);
+            /// @brief Constructor helper to order the ranks of comm
+            ///        so that ranks with the same topology key fill
+            ///        the leaf groups of the tree together.
+            void topology_comm_create(const MPI_Comm &comm, MPI_Comm &topology_comm);
             /// @brief Constructor helper to instantiate the level
             ///        specific objects.
             void level_create(void);
@@ -238,7 +363,20 @@ namespace geopm
             /// GlobalPolicy object defining the policy
             GlobalPolicy *m_global_policy;
             /// Intermediate levels
-            std::vector<TreeCommunicatorLevel *> m_level;
+            std::vector<TreeCommunicatorLevelBase *> m_level;
+            /// Use the one-sided backend for the levels
+            bool m_is_rma;
+            /// Description of the key used to group ranks at the
+            /// leaf level, empty to use rank order
+            std::string m_topology;
+            /// Number of times get_sample() may reuse a child sample
+            int m_max_sample_age;
+            /// Ages discarded by the two argument get_sample()
+            std::vector<int> m_sample_age;
+            /// Region samples from each child that are reduced to
+            /// the outer sync sample by the single sample
+            /// get_sample()
+            std::vector<std::vector<struct geopm_sample_message_s> > m_sample_region;
             /// MPI data type for sample message
             MPI_Datatype m_sample_mpi_type;
             /// MPI data type for policy message
@@ -262,12 +400,15 @@ namespace geopm
             int level_rank(int level) const;
             int level_size(int level) const;
             void send_sample(int level, const struct geopm_sample_message_s &sample);
+            void send_sample(int level, const std::vector<struct geopm_sample_message_s> &sample);
             void send_policy(int level, const std::vector<struct geopm_policy_message_s> &policy);
             void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample);
+            void get_sample(int level, std::vector<struct geopm_sample_message_s> &sample, std::vector<int> &age);
+            void get_sample(int level, std::vector<std::vector<struct geopm_sample_message_s> > &sample, std::vector<int> &age);
             void get_policy(int level, struct geopm_policy_message_s &policy);
         protected:
             GlobalPolicy *m_policy;
-            struct geopm_sample_message_s m_sample;
+            std::vector<struct geopm_sample_message_s> m_sample;
     };
 
 }
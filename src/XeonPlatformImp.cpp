@@ -54,6 +54,8 @@ namespace geopm
         , m_max_pp0_watts(100)
         , m_min_dram_watts(1)
         , m_max_dram_watts(100)
+        , m_min_freq(0.0)
+        , m_max_freq(0.0)
         , m_signal_msr_offset(M_LLC_VICTIMS)
         , m_control_msr_pair(M_NUM_CONTROL)
         , M_BOX_FRZ_EN(0x1 << 16)
@@ -67,6 +69,9 @@ namespace geopm
         , M_UMASK_0(M_LLC_VICTIMS_UMASK)
         , M_PKG_POWER_LIMIT_MASK(0x1800000018000UL)
         , M_DRAM_POWER_LIMIT_MASK(0x18000)
+        , M_COUNTER_MASK_32(0xffffffffULL)
+        , M_COUNTER_MASK_40(0xffffffffffULL)
+        , M_COUNTER_MASK_44(0xfffffffffffULL)
         , M_PLATFORM_ID(platform_id)
         , M_MODEL_NAME(model_name)
     {
@@ -182,7 +187,8 @@ namespace geopm
                 lower_bound = m_min_dram_watts;
                 break;
             case GEOPM_TELEMETRY_TYPE_FREQUENCY:
-                throw Exception("XeonPlatformImp::bound(GEOPM_TELEMETRY_TYPE_FREQUENCY)", GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+                upper_bound = m_max_freq;
+                lower_bound = m_min_freq;
                 break;
             default:
                 throw geopm::Exception("XeonPlatformImp::bound(): Invalid control type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -276,7 +282,11 @@ namespace geopm
                     m_batch.numops = num_signal;
                     m_batch.ops = (struct m_msr_batch_op*)realloc(m_batch.ops, m_batch.numops * sizeof(struct m_msr_batch_op));
                 }
+                m_batch_overflow_idx.resize(num_signal);
+                m_batch_counter_mask.resize(num_signal);
+                m_batch_value.resize(num_signal);
 
+                int counter_idx = m_num_package * m_num_energy_signal;
                 for (auto it = signal_desc.begin(); it != signal_desc.end(); ++it) {
                     m_batch.ops[index].isrdmsr = 1;
                     m_batch.ops[index].err = 0;
@@ -299,24 +309,38 @@ namespace geopm
                     switch ((*it).signal_type) {
                         case GEOPM_TELEMETRY_TYPE_PKG_ENERGY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_RAPL_PKG_STATUS];
+                            m_batch_overflow_idx[index] = (*it).device_index * m_num_energy_signal + M_PKG_STATUS_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_32;
                             break;
                         case GEOPM_TELEMETRY_TYPE_DRAM_ENERGY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_RAPL_DRAM_STATUS];
+                            m_batch_overflow_idx[index] = (*it).device_index * m_num_energy_signal + M_DRAM_STATUS_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_32;
                             break;
                         case GEOPM_TELEMETRY_TYPE_FREQUENCY:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_IA32_PERF_STATUS];
+                            m_batch_overflow_idx[index] = -1;
+                            m_batch_counter_mask[index] = ~0ULL;
                             break;
                         case GEOPM_TELEMETRY_TYPE_INST_RETIRED:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_INST_RETIRED];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_INST_RETIRED_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_CLK_UNHALTED_CORE];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_CORE_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_REF:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_CLK_UNHALTED_REF];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_REF_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_40;
                             break;
                         case GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH:
                             m_batch.ops[index].msr = m_signal_msr_offset[M_LLC_VICTIMS + m_batch.ops[index].cpu];
+                            m_batch_overflow_idx[index] = counter_idx + (*it).device_index * m_num_counter_signal + M_LLC_VICTIMS_OVERFLOW;
+                            m_batch_counter_mask[index] = M_COUNTER_MASK_44;
                             break;
                         default:
                             throw geopm::Exception("XeonPlatformImp::batch_read_signal: Invalid signal type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -327,48 +351,27 @@ namespace geopm
             }
 
             batch_msr_read();
+            batch_msr_overflow();
 
-            index = 0;
             signal_index = 0;
-            int offset_idx;
             for (auto it = signal_desc.begin(); it != signal_desc.end(); ++it) {
                 switch ((*it).signal_type) {
                     case GEOPM_TELEMETRY_TYPE_PKG_ENERGY:
-                        offset_idx = (*it).device_index * m_num_energy_signal + M_PKG_STATUS_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 32,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        (*it).value *= m_energy_units;
+                        (*it).value = (double)m_batch_value[signal_index++] * m_energy_units;
                         break;
                     case GEOPM_TELEMETRY_TYPE_DRAM_ENERGY:
-                        offset_idx = (*it).device_index * m_num_energy_signal + M_DRAM_STATUS_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 32,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        (*it).value *= m_dram_energy_units;
+                        (*it).value = (double)m_batch_value[signal_index++] * m_dram_energy_units;
                         break;
                     case GEOPM_TELEMETRY_TYPE_FREQUENCY:
-                        (*it).value = (double)((m_batch.ops[signal_index++].msrdata >> 8) & 0x0FF);
+                        (*it).value = (double)((m_batch_value[signal_index++] >> 8) & 0x0FF);
                         //convert to MHZ
                         (*it).value *= 0.1;
                         break;
                     case GEOPM_TELEMETRY_TYPE_INST_RETIRED:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_INST_RETIRED_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        break;
                     case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_CORE_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        break;
                     case GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_REF:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_CLK_UNHALTED_REF_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 40,
-                                                   m_batch.ops[signal_index++].msrdata);
-                        break;
                     case GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH:
-                        offset_idx = m_num_package * m_num_energy_signal + (*it).device_index * m_num_counter_signal + M_LLC_VICTIMS_OVERFLOW;
-                        (*it).value = msr_overflow(offset_idx, 44,
-                                                   m_batch.ops[signal_index++].msrdata);
+                        (*it).value = (double)m_batch_value[signal_index++];
                         break;
                     default:
                         throw geopm::Exception("XeonPlatformImp::read_signal: Invalid signal type", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -424,6 +427,27 @@ namespace geopm
         }
     }
 
+    void XeonPlatformImp::batch_write_control(const std::vector<struct geopm_signal_descriptor> &control_desc)
+    {
+        std::vector<struct m_msr_access_s> access;
+        access.reserve(control_desc.size());
+        for (auto it = control_desc.begin(); it != control_desc.end(); ++it) {
+            if ((*it).signal_type == GEOPM_TELEMETRY_TYPE_FREQUENCY) {
+                // Gather P-state requests so they are written in one batch
+                struct m_msr_access_s curr;
+                curr.cpu = msr_cpu((*it).device_type, (*it).device_index);
+                curr.offset = m_control_msr_pair[M_IA32_PERF_CTL].first;
+                curr.mask = m_control_msr_pair[M_IA32_PERF_CTL].second;
+                curr.value = ((uint64_t)((*it).value * 10)) << 8;
+                access.push_back(curr);
+            }
+            else {
+                write_control((*it).device_type, (*it).device_index, (*it).signal_type, (*it).value);
+            }
+        }
+        batch_msr_write(access);
+    }
+
     void XeonPlatformImp::msr_initialize()
     {
         rapl_init();
@@ -435,29 +459,29 @@ namespace geopm
         size_t num_signal = m_num_energy_signal * m_num_package + m_num_counter_signal * m_num_hw_cpu;
         m_msr_value_last.resize(num_signal);
         m_msr_overflow_offset.resize(num_signal);
-        std::fill(m_msr_value_last.begin(), m_msr_value_last.end(), 0.0);
-        std::fill(m_msr_overflow_offset.begin(), m_msr_overflow_offset.end(), 0.0);
+        std::fill(m_msr_value_last.begin(), m_msr_value_last.end(), 0);
+        std::fill(m_msr_overflow_offset.begin(), m_msr_overflow_offset.end(), 0);
 
         //Save off the msr offsets for the signals we want to read to avoid a map lookup
         for (int i = 0; i < M_LLC_VICTIMS; ++i) {
             switch (i) {
                 case M_RAPL_PKG_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("PKG_ENERGY_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PKG_ENERGY_STATUS).offset;
                     break;
                 case M_RAPL_DRAM_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("DRAM_ENERGY_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_DRAM_ENERGY_STATUS).offset;
                     break;
                 case M_IA32_PERF_STATUS:
-                    m_signal_msr_offset[i] = msr_offset("IA32_PERF_STATUS");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_IA32_PERF_STATUS).offset;
                     break;
                 case M_INST_RETIRED:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR0");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR0).offset;
                     break;
                 case M_CLK_UNHALTED_CORE:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR1");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR1).offset;
                     break;
                 case M_CLK_UNHALTED_REF:
-                    m_signal_msr_offset[i] = msr_offset("PERF_FIXED_CTR2");
+                    m_signal_msr_offset[i] = msr_handle(M_MSR_PERF_FIXED_CTR2).offset;
                     break;
                 default:
                     throw Exception("HSXPlatformImp: Index not enumerated",
@@ -467,14 +491,18 @@ namespace geopm
         }
         int cpu_per_socket = m_num_hw_cpu / m_num_package;
         for (int i = 0; i < m_num_hw_cpu; i++) {
-            std::string msr_name("C" + std::to_string(i % cpu_per_socket) + "_MSR_PMON_CTR1");
-            m_signal_msr_offset[M_LLC_VICTIMS + i] = msr_offset(msr_name);
+            m_signal_msr_offset[M_LLC_VICTIMS + i] = cbo_msr_handle(i % cpu_per_socket, M_CBO_CTR1).offset;
         }
 
         //Save off the msr offsets and masks for the controls we want to write to avoid a map lookup
-        m_control_msr_pair[M_RAPL_PKG_LIMIT] = std::make_pair(msr_offset("PKG_POWER_LIMIT"), msr_mask("PKG_POWER_LIMIT") );
-        m_control_msr_pair[M_RAPL_DRAM_LIMIT] = std::make_pair(msr_offset("DRAM_POWER_LIMIT"), msr_mask("DRAM_POWER_LIMIT") );
-        m_control_msr_pair[M_IA32_PERF_CTL] = std::make_pair(msr_offset("IA32_PERF_CTL"), msr_mask("IA32_PERF_CTL") );
+        m_control_msr_pair[M_RAPL_PKG_LIMIT] = std::make_pair(msr_handle(M_MSR_PKG_POWER_LIMIT).offset, msr_handle(M_MSR_PKG_POWER_LIMIT).mask);
+        m_control_msr_pair[M_RAPL_DRAM_LIMIT] = std::make_pair(msr_handle(M_MSR_DRAM_POWER_LIMIT).offset, msr_handle(M_MSR_DRAM_POWER_LIMIT).mask);
+        m_control_msr_pair[M_IA32_PERF_CTL] = std::make_pair(msr_handle(M_MSR_IA32_PERF_CTL).offset, msr_handle(M_MSR_IA32_PERF_CTL).mask);
+
+        //Frequency bounds in units of 100 MHz ratios, turbo ratios are not included
+        uint64_t tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, msr_handle(M_MSR_PLATFORM_INFO));
+        m_max_freq = ((tmp >> 8) & 0xFF) * 0.1;
+        m_min_freq = ((tmp >> 40) & 0xFF) * 0.1;
     }
 
     void XeonPlatformImp::msr_reset()
@@ -489,7 +517,7 @@ namespace geopm
         uint64_t tmp;
 
         //Make sure units are consistent between packages
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "RAPL_POWER_UNIT");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_RAPL_POWER_UNIT]);
         m_energy_units = pow(0.5, (double)((tmp >> 8) & 0x1F));
         if (m_dram_energy_units == 0.0) {
             m_dram_energy_units = m_energy_units;
@@ -497,7 +525,7 @@ namespace geopm
         m_power_units = pow(2, (double)((tmp >> 0) & 0xF));
 
         for (int i = 1; i < m_num_package; i++) {
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "RAPL_POWER_UNIT");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_RAPL_POWER_UNIT]);
             double energy = pow(0.5, (double)((tmp >> 8) & 0x1F));
             double power = pow(2, (double)((tmp >> 0) & 0xF));
             if (energy != m_energy_units || power != m_power_units) {
@@ -506,12 +534,12 @@ namespace geopm
         }
 
         //Make sure bounds are consistent between packages
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "PKG_POWER_INFO");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_PKG_POWER_INFO]);
         m_tdp_pkg_watts = ((double)(tmp & 0x7fff)) / m_power_units;
         m_min_pkg_watts = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
         m_max_pkg_watts = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
 
-        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, "DRAM_POWER_INFO");
+        tmp = msr_read(GEOPM_DOMAIN_PACKAGE, 0, m_msr_handle[M_MSR_DRAM_POWER_INFO]);
         m_min_dram_watts = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
         m_max_dram_watts = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
 
@@ -521,13 +549,13 @@ namespace geopm
         m_pkg_time_window = (uint64_t)(log(m_control_latency_ms)/log(2)) << 49;
 
         for (int i = 1; i < m_num_package; i++) {
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "PKG_POWER_INFO");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_PKG_POWER_INFO]);
             double pkg_min = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
             double pkg_max = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
             if (pkg_min != m_min_pkg_watts || pkg_max != m_max_pkg_watts) {
                 throw Exception("detected inconsistent power pkg bounds among packages", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
             }
-            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, "DRAM_POWER_INFO");
+            tmp = msr_read(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_DRAM_POWER_INFO]);
             double dram_min = ((double)((tmp >> 16) & 0x7fff)) / m_power_units;
             double dram_max = ((double)((tmp >> 32) & 0x7fff)) / m_power_units;
             if (dram_min != m_min_dram_watts || dram_max != m_max_dram_watts) {
@@ -544,45 +572,39 @@ namespace geopm
     {
         int cpu_per_socket = m_num_hw_cpu / m_num_package;
         for (int i = 0; i < m_num_hw_cpu; i++) {
-            std::string msr_name("_MSR_PMON_CTL1");
-            std::string box_msr_name("_MSR_PMON_BOX_CTL");
-            std::string filter_msr_name("_MSR_PMON_BOX_FILTER");
-            box_msr_name.insert(0, std::to_string(i % cpu_per_socket));
-            box_msr_name.insert(0, "C");
-            msr_name.insert(0, std::to_string(i % cpu_per_socket));
-            msr_name.insert(0, "C");
-            filter_msr_name.insert(0, std::to_string(i % cpu_per_socket));
-            filter_msr_name.insert(0, "C");
+            const struct m_msr_handle_s &ctl_msr = cbo_msr_handle(i % cpu_per_socket, M_CBO_CTL1);
+            const struct m_msr_handle_s &box_msr = cbo_msr_handle(i % cpu_per_socket, M_CBO_BOX_CTL);
+            const struct m_msr_handle_s &filter_msr = cbo_msr_handle(i % cpu_per_socket, M_CBO_BOX_FILTER);
 
             // enable freeze
-            msr_write(GEOPM_DOMAIN_CPU, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       | M_BOX_FRZ_EN);
             // freeze box
-            msr_write(GEOPM_DOMAIN_CPU, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       | M_BOX_FRZ);
-            msr_write(GEOPM_DOMAIN_CPU, i, msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, ctl_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, ctl_msr)
                       | M_CTR_EN);
-            msr_write(GEOPM_DOMAIN_CPU, i, filter_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, filter_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, filter_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, filter_msr)
                       | M_LLC_FILTER_MASK);
             // llc victims
-            msr_write(GEOPM_DOMAIN_CPU, i, msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, ctl_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, ctl_msr)
                       | M_EVENT_SEL_0 | M_UMASK_0);
             // reset counters
-            msr_write(GEOPM_DOMAIN_CPU, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       | M_RST_CTRS);
             /// @bug is this needed???
-            msr_write(GEOPM_DOMAIN_CPU, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       & ~M_BOX_FRZ);
             // unfreeze box
-            msr_write(GEOPM_DOMAIN_CPU, i, box_msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       & ~M_BOX_FRZ);
         }
     }
@@ -590,9 +612,9 @@ namespace geopm
     void XeonPlatformImp::fixed_counters_init()
     {
         for (int cpu = 0; cpu < m_num_hw_cpu; cpu++) {
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_FIXED_CTR_CTRL", 0x0333);
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_GLOBAL_CTRL", 0x700000003);
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_GLOBAL_OVF_CTRL", 0x0);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_FIXED_CTR_CTRL], 0x0333);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_GLOBAL_CTRL], 0x700000003);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_GLOBAL_OVF_CTRL], 0x0);
         }
     }
 
@@ -603,8 +625,8 @@ namespace geopm
         for (int i = 1; i < m_num_package; i++) {
             msr_val = (uint64_t)(m_max_pkg_watts * m_power_units);
             msr_val = msr_val | (msr_val << 32) | M_PKG_POWER_LIMIT_MASK | m_pkg_time_window;
-            msr_write(GEOPM_DOMAIN_PACKAGE, i, "PKG_POWER_LIMIT", msr_val);
-            msr_write(GEOPM_DOMAIN_PACKAGE, i, "DRAM_POWER_LIMIT", 0x0);
+            msr_write(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_PKG_POWER_LIMIT], msr_val);
+            msr_write(GEOPM_DOMAIN_PACKAGE, i, m_msr_handle[M_MSR_DRAM_POWER_LIMIT], 0x0);
         }
     }
 
@@ -612,12 +634,10 @@ namespace geopm
     {
         int cpu_per_socket = m_num_hw_cpu / m_num_package;
         for (int i = 0; i < m_num_hw_cpu; i++) {
-            std::string msr_name("_MSR_PMON_BOX_CTL");
-            msr_name.insert(0, std::to_string(i % cpu_per_socket));
-            msr_name.insert(0, "C");
+            const struct m_msr_handle_s &box_msr = cbo_msr_handle(i % cpu_per_socket, M_CBO_BOX_CTL);
             // reset counters
-            msr_write(GEOPM_DOMAIN_CPU, i, msr_name,
-                      msr_read(GEOPM_DOMAIN_CPU, i, msr_name)
+            msr_write(GEOPM_DOMAIN_CPU, i, box_msr,
+                      msr_read(GEOPM_DOMAIN_CPU, i, box_msr)
                       | M_RST_CTRS);
         }
     }
@@ -625,9 +645,9 @@ namespace geopm
     void XeonPlatformImp::fixed_counters_reset()
     {
         for (int cpu = 0; cpu < m_num_hw_cpu; cpu++) {
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_FIXED_CTR0", 0x0);
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_FIXED_CTR1", 0x0);
-            msr_write(GEOPM_DOMAIN_CPU, cpu, "PERF_FIXED_CTR2", 0x0);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_FIXED_CTR0], 0x0);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_FIXED_CTR1], 0x0);
+            msr_write(GEOPM_DOMAIN_CPU, cpu, m_msr_handle[M_MSR_PERF_FIXED_CTR2], 0x0);
         }
     }
 
@@ -636,6 +656,7 @@ namespace geopm
         static const std::map<std::string, std::pair<off_t, unsigned long> > msr_map({
             {"IA32_PERF_STATUS",        {0x0198, 0x0000000000000000}},
             {"IA32_PERF_CTL",           {0x0199, 0x000000010000ffff}},
+            {"PLATFORM_INFO",           {0x00CE, 0x0000000000000000}},
             {"RAPL_POWER_UNIT",         {0x0606, 0x0000000000000000}},
             {"PKG_POWER_LIMIT",         {0x0610, 0x00ffffff00ffffff}},
             {"PKG_ENERGY_STATUS",       {0x0611, 0x0000000000000000}},
@@ -765,6 +786,7 @@ namespace geopm
         static const std::map<std::string, std::pair<off_t, unsigned long> > msr_map({
             {"IA32_PERF_STATUS",        {0x0198, 0x0000000000000000}},
             {"IA32_PERF_CTL",           {0x0199, 0x000000010000ffff}},
+            {"PLATFORM_INFO",           {0x00CE, 0x0000000000000000}},
             {"RAPL_POWER_UNIT",         {0x0606, 0x0000000000000000}},
             {"PKG_POWER_LIMIT",         {0x0610, 0x00ffffff00ffffff}},
             {"PKG_ENERGY_STATUS",       {0x0611, 0x0000000000000000}},
@@ -44,6 +44,7 @@ extern "C"
     };
 
     const char *geopm_env_policy(void);
+    const char *geopm_env_policy_cache(void);
     const char *geopm_env_shmkey(void);
     const char *geopm_env_trace(void);
     const char *geopm_env_plugin_path(void);
@@ -54,6 +55,12 @@ extern "C"
     int geopm_env_do_trace(void);
     int geopm_env_do_ignore_affinity(void);
     int geopm_env_do_profile(void);
+    int geopm_env_do_tree_rma(void);
+    int geopm_env_do_policy_watch(void);
+    int geopm_env_max_sample_age(void);
+    int geopm_env_max_fan_out(void);
+    int geopm_env_tree_depth(void);
+    const char *geopm_env_tree_topology(void);
 
 #ifdef __cplusplus
 }
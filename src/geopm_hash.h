@@ -31,7 +31,6 @@
  */
 #ifndef GEOPM_HASH_H_INCLUDE
 #define GEOPM_HASH_H_INCLUDE
-#endif
 
 #include <stdint.h>
 #include <smmintrin.h>
@@ -49,3 +48,4 @@ uint64_t geopm_crc32_str(uint64_t begin, const char *key);
 #ifdef __cplusplus
 }
 #endif
+#endif
@@ -31,6 +31,7 @@
  */
 
 #include "geopm_message.h"
+#include "geopm_policy.h"
 #include "config.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -65,3 +66,23 @@ int geopm_is_sample_equal(const struct geopm_sample_message_s *a, const struct g
     }
     return result;
 }
+
+int geopm_region_id_hint(uint64_t region_id)
+{
+    int result = GEOPM_POLICY_HINT_UNKNOWN;
+    if (region_id != GEOPM_REGION_ID_MPI &&
+        region_id != GEOPM_REGION_ID_OUTER) {
+        result = (int)(region_id >> 32);
+    }
+    return result;
+}
+
+uint64_t geopm_region_id_set_hint(uint64_t hint, uint64_t region_id)
+{
+    uint64_t result = region_id;
+    if (region_id != GEOPM_REGION_ID_MPI &&
+        region_id != GEOPM_REGION_ID_OUTER) {
+        result = (region_id & 0xFFFFFFFFULL) | (hint << 32);
+    }
+    return result;
+}
@@ -62,6 +62,7 @@ enum geopm_sample_type_e {
     GEOPM_SAMPLE_TYPE_ENERGY,
     GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER,
     GEOPM_SAMPLE_TYPE_FREQUENCY_DENOM,
+    GEOPM_SAMPLE_TYPE_MPI_RUNTIME,
     GEOPM_NUM_SAMPLE_TYPE // Sample counter, must be last
 };
 
@@ -150,6 +151,20 @@ int geopm_is_policy_equal(const struct geopm_policy_message_s *a, const struct g
 /// @param [in] b Pointer to a sample message.
 /// @return 1 if samples are equal, else 0
 int geopm_is_sample_equal(const struct geopm_sample_message_s *a, const struct geopm_sample_message_s *b);
+/// @brief Extract the policy hint encoded in the upper 32 bits
+///        of a region id by geopm_region_id_set_hint().
+/// @param [in] region_id Region id returned by geopm_prof_region().
+/// @return Value from the #geopm_policy_hint_e enum,
+///         GEOPM_POLICY_HINT_UNKNOWN for the mpi-sync and
+///         outer-sync regions.
+int geopm_region_id_hint(uint64_t region_id);
+/// @brief Encode a policy hint in the upper 32 bits of a region
+///        id, the lower 32 bits hold the hash of the region name.
+/// @param [in] hint Value from the #geopm_policy_hint_e enum.
+/// @param [in] region_id Region id to modify.
+/// @return The region id carrying the hint, the mpi-sync and
+///         outer-sync region ids are returned unmodified.
+uint64_t geopm_region_id_set_hint(uint64_t hint, uint64_t region_id);
 
 #ifdef __cplusplus
 }
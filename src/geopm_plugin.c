@@ -37,6 +37,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <dlfcn.h>
+#include <pthread.h>
 #ifndef u_short
 #define u_short unsigned short
 #endif
@@ -50,11 +51,51 @@
 #define NAME_MAX 1024
 #endif
 
-int geopm_plugin_load(int plugin_type, struct geopm_factory_c *factory)
+typedef int (*geopm_plugin_register_f)(int, struct geopm_factory_c *, void *);
+
+/* Plugins found on the plugin path, the scan and dlopen() is done
+   once per process and the handles are kept open for its lifetime. */
+struct geopm_plugin_cache_s {
+    int num_plugin;
+    char **path;
+    geopm_plugin_register_f *register_func;
+};
+
+static struct geopm_plugin_cache_s g_plugin_cache = {0, NULL, NULL};
+static pthread_once_t g_plugin_cache_once = PTHREAD_ONCE_INIT;
+static int g_plugin_cache_err = 0;
+
+static int geopm_plugin_cache_append(const char *path, geopm_plugin_register_f register_func)
+{
+    int err = 0;
+    int num_plugin = g_plugin_cache.num_plugin + 1;
+    char **new_path = realloc(g_plugin_cache.path, num_plugin * sizeof(char *));
+    if (new_path) {
+        g_plugin_cache.path = new_path;
+    }
+    geopm_plugin_register_f *new_func = realloc(g_plugin_cache.register_func, num_plugin * sizeof(geopm_plugin_register_f));
+    if (new_func) {
+        g_plugin_cache.register_func = new_func;
+    }
+    char *path_copy = malloc(strlen(path) + 1);
+    if (!new_path || !new_func || !path_copy) {
+        free(path_copy);
+        err = ENOMEM;
+    }
+    else {
+        strcpy(path_copy, path);
+        g_plugin_cache.path[num_plugin - 1] = path_copy;
+        g_plugin_cache.register_func[num_plugin - 1] = register_func;
+        g_plugin_cache.num_plugin = num_plugin;
+    }
+    return err;
+}
+
+static void geopm_plugin_cache_init(void)
 {
     int err = 0;
     void *plugin;
-    int (*register_func)(int, struct geopm_factory_c *, void *);
+    geopm_plugin_register_f register_func;
     int fts_options = FTS_COMFOLLOW | FTS_NOCHDIR;
     FTS *p_fts;
     FTSENT *file;
@@ -84,15 +125,15 @@ int geopm_plugin_load(int plugin_type, struct geopm_factory_c *factory)
         }
 
         if ((p_fts = fts_open(paths, fts_options, NULL)) != NULL) {
-            while ((file = fts_read(p_fts)) != NULL) {
+            while (!err && (file = fts_read(p_fts)) != NULL) {
                 if (file->fts_info == FTS_F &&
                     (strstr(file->fts_name, ".so") ||
                      strstr(file->fts_name, ".dylib"))) {
                     plugin = dlopen(file->fts_path, RTLD_LAZY);
                     if (plugin != NULL) {
-                        register_func = (int (*)(int, struct geopm_factory_c *, void *)) dlsym(plugin, "geopm_plugin_register");
+                        register_func = (geopm_plugin_register_f) dlsym(plugin, "geopm_plugin_register");
                         if (register_func != NULL) {
-                            register_func(plugin_type, factory, plugin);
+                            err = geopm_plugin_cache_append(file->fts_path, register_func);
                         }
                         else {
                             dlclose(plugin);
@@ -104,6 +145,22 @@ int geopm_plugin_load(int plugin_type, struct geopm_factory_c *factory)
         }
         free(paths);
     }
+    g_plugin_cache_err = err;
+}
 
+int geopm_plugin_load(int plugin_type, struct geopm_factory_c *factory)
+{
+    int err = pthread_once(&g_plugin_cache_once, geopm_plugin_cache_init);
+    if (!err) {
+        err = g_plugin_cache_err;
+    }
+    for (int i = 0; !err && i < g_plugin_cache.num_plugin; ++i) {
+        /* The factory owns a reference to the library for each object
+           it registers and will dlclose() it, so take a new one. */
+        void *plugin = dlopen(g_plugin_cache.path[i], RTLD_LAZY | RTLD_NOLOAD);
+        if (plugin != NULL) {
+            g_plugin_cache.register_func[i](plugin_type, factory, plugin);
+        }
+    }
     return err;
 }
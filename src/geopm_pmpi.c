@@ -40,6 +40,7 @@
 #include "geopm_error.h"
 #include "geopm_message.h"
 #include "geopm_env.h"
+#include "geopm_comm.h"
 #include "config.h"
 
 static int g_is_geopm_pmpi_ctl_enabled = 0;
@@ -164,7 +165,7 @@ static int geopm_pmpi_init(const char *exec_name)
             err = GEOPM_ERROR_LOGIC;
         }
         if (!err) {
-            err = geopm_comm_split_ppn1(MPI_COMM_WORLD, "pmpi", &g_ppn1_comm);
+            err = geopm_comm_ppn1_cached(MPI_COMM_WORLD, &g_ppn1_comm);
         }
         if (!err && g_ppn1_comm != MPI_COMM_NULL) {
             int ppn1_rank;
@@ -219,10 +220,6 @@ static int geopm_pmpi_finalize(void)
         tmp_err = PMPI_Comm_free(&G_GEOPM_COMM_WORLD_SWAP);
         err = err ? err : tmp_err;
     }
-    if (g_ppn1_comm != MPI_COMM_NULL) {
-        tmp_err = PMPI_Comm_free(&g_ppn1_comm);
-        err = err ? err : tmp_err;
-    }
     return err;
 }
 
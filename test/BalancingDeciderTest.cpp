@@ -76,7 +76,8 @@ void BalancingDeciderTest::SetUp()
         sample[sample_idx].region_id = 42;
     }
     for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < GEOPM_NUM_SAMPLE_TYPE; j++) {
+        // No MPI wait is reported so the balancer uses runtime
+        for (int j = 0; j < GEOPM_SAMPLE_TYPE_MPI_RUNTIME; j++) {
             for (int k = 0; k < 8; ++k) {
                 sample[k].signal[j] = (double)(i + 1 + k);
             }
@@ -157,3 +158,78 @@ TEST_F(BalancingDeciderTest, update_policy)
         EXPECT_NEAR(expect + (dom * 10.52631578947367), tgt[dom], 1E-9);
     }
 }
+
+TEST_F(BalancingDeciderTest, seed)
+{
+    std::vector<double> tgt(m_num_domain);
+    std::fill(tgt.begin(), tgt.end(), 13.0);
+    tgt[0] = 12.0;
+    tgt[1] = 14.0;
+    m_policy->seed(GEOPM_REGION_ID_OUTER, 104, tgt, true);
+    // The learned split is scaled to the new budget and the
+    // balancer starts out converged.
+    m_policy_message.power_budget = 208;
+    m_balancer->update_policy(m_policy_message, *m_policy);
+    m_policy->target(GEOPM_REGION_ID_OUTER, tgt);
+    for (int dom = 0; dom < m_num_domain; ++dom) {
+        if (dom == 0) {
+            EXPECT_DOUBLE_EQ(24, tgt[dom]);
+        }
+        else if (dom == 1) {
+            EXPECT_DOUBLE_EQ(28, tgt[dom]);
+        }
+        else {
+            EXPECT_DOUBLE_EQ(26, tgt[dom]);
+        }
+    }
+    EXPECT_TRUE(m_policy->is_converged(GEOPM_REGION_ID_OUTER));
+}
+
+TEST_F(BalancingDeciderTest, mpi_slack)
+{
+    std::vector<double> tgt(m_num_domain);
+    std::vector<struct geopm_sample_message_s> sample(m_num_domain);
+    std::vector<int> age(m_num_domain, 0);
+    geopm::Region region(GEOPM_REGION_ID_OUTER, GEOPM_POLICY_HINT_UNKNOWN, m_num_domain, 1);
+    m_policy_message.power_budget = 800;
+    m_balancer->update_policy(m_policy_message, *m_policy);
+
+    // Every iteration takes one second, child i waits 0.05 * i of it in MPI
+    for (int dom = 0; dom < m_num_domain; ++dom) {
+        sample[dom].region_id = GEOPM_REGION_ID_OUTER;
+        sample[dom].signal[GEOPM_SAMPLE_TYPE_RUNTIME] = 1.0 - 0.05 * dom;
+        sample[dom].signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] = 0.05 * dom;
+    }
+    region.insert(sample, age);
+    EXPECT_TRUE(m_balancer->update_policy(region, *m_policy));
+    m_policy->target(GEOPM_REGION_ID_OUTER, tgt);
+    double sum = 0.0;
+    for (int dom = 0; dom < m_num_domain; ++dom) {
+        EXPECT_NEAR(800.0 * (1.0 - 0.05 * dom) / 6.6, tgt[dom], 1E-9);
+        sum += tgt[dom];
+    }
+    EXPECT_NEAR(800.0, sum, 1E-9);
+
+    // A stale sample is not a new iteration
+    std::fill(age.begin(), age.end(), 1);
+    region.insert(sample, age);
+    EXPECT_FALSE(m_balancer->update_policy(region, *m_policy));
+    // The first iteration after a shift is discarded
+    std::fill(age.begin(), age.end(), 0);
+    region.insert(sample, age);
+    EXPECT_FALSE(m_balancer->update_policy(region, *m_policy));
+
+    // Balanced slack converges after enough iterations
+    for (int dom = 0; dom < m_num_domain; ++dom) {
+        sample[dom].signal[GEOPM_SAMPLE_TYPE_RUNTIME] = 0.9;
+        sample[dom].signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] = 0.1;
+    }
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_FALSE(m_policy->is_converged(GEOPM_REGION_ID_OUTER));
+        region.insert(sample, age);
+        EXPECT_FALSE(m_balancer->update_policy(region, *m_policy));
+    }
+    EXPECT_TRUE(m_policy->is_converged(GEOPM_REGION_ID_OUTER));
+    m_policy->target(GEOPM_REGION_ID_OUTER, tgt);
+    EXPECT_NEAR(800.0 * 0.65 / 6.6, tgt[m_num_domain - 1], 1E-9);
+}
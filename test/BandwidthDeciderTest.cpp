@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <math.h>
+
+#include "gtest/gtest.h"
+#include "geopm_message.h"
+#include "geopm_time.h"
+#include "BandwidthDecider.hpp"
+#include "Region.hpp"
+#include "Policy.hpp"
+
+class BandwidthDeciderTest: public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        /// Insert one sample into the region with the given
+        /// instructions per cycle and read bandwidth on every domain,
+        /// then run the decider on it.
+        bool sample(geopm::Region &region, double ipc, double bandwidth);
+        /// Check that every domain of the region targets frequency.
+        void check_target(uint64_t region_id, double frequency);
+        geopm::BandwidthDecider *m_decider;
+        geopm::Policy *m_policy;
+        geopm::Region *m_region;
+        struct geopm_policy_message_s m_policy_message;
+        struct geopm_time_s m_time;
+        std::vector<double> m_counter;
+        const int m_num_domain = 2;
+        const double m_upper_bound = 2.0e9;
+        const double m_lower_bound = 1.0e9;
+        const double m_memory_frequency = 1.5e9;
+        const uint64_t m_region_id = 42;
+};
+
+void BandwidthDeciderTest::SetUp()
+{
+    m_decider = new geopm::BandwidthDecider;
+    m_decider->bound(m_upper_bound, m_lower_bound);
+    m_policy = new geopm::Policy(m_num_domain);
+    m_region = new geopm::Region(m_region_id, GEOPM_POLICY_HINT_UNKNOWN, m_num_domain, 0);
+    m_policy_message = GEOPM_POLICY_UNKNOWN;
+    m_policy_message.mode = GEOPM_POLICY_MODE_FREQ_UNIFORM_DYNAMIC;
+    m_time = {{0, 0}};
+    m_counter.resize(GEOPM_NUM_TELEMETRY_TYPE, 0.0);
+    // Every domain starts out at the upper bound
+    EXPECT_TRUE(m_decider->update_policy(m_policy_message, *m_policy));
+    EXPECT_FALSE(m_decider->update_policy(m_policy_message, *m_policy));
+    check_target(GEOPM_REGION_ID_OUTER, m_upper_bound);
+}
+
+void BandwidthDeciderTest::TearDown()
+{
+    delete m_region;
+    delete m_policy;
+    delete m_decider;
+}
+
+bool BandwidthDeciderTest::sample(geopm::Region &region, double ipc, double bandwidth)
+{
+    // One second between samples with 1e9 unhalted cycles
+    double clk = isnan(ipc) ? 0.0 : 1.0e9;
+    m_time.t.tv_sec += 1;
+    m_counter[GEOPM_TELEMETRY_TYPE_CLK_UNHALTED_CORE] += clk;
+    m_counter[GEOPM_TELEMETRY_TYPE_INST_RETIRED] += isnan(ipc) ? 0.0 : ipc * clk;
+    m_counter[GEOPM_TELEMETRY_TYPE_READ_BANDWIDTH] += bandwidth;
+    std::vector<struct geopm_telemetry_message_s> telemetry(m_num_domain);
+    for (auto it = telemetry.begin(); it != telemetry.end(); ++it) {
+        (*it).region_id = region.identifier();
+        (*it).timestamp = m_time;
+        std::copy(m_counter.begin(), m_counter.end(), (*it).signal);
+        (*it).signal[GEOPM_TELEMETRY_TYPE_PROGRESS] = 0.5;
+        (*it).signal[GEOPM_TELEMETRY_TYPE_RUNTIME] = -1.0;
+    }
+    region.insert(telemetry);
+    return m_decider->update_policy(region, *m_policy);
+}
+
+void BandwidthDeciderTest::check_target(uint64_t region_id, double frequency)
+{
+    std::vector<double> target(m_num_domain);
+    m_policy->target(region_id, target);
+    for (int domain_idx = 0; domain_idx < m_num_domain; ++domain_idx) {
+        EXPECT_DOUBLE_EQ(frequency, target[domain_idx]);
+    }
+}
+
+TEST_F(BandwidthDeciderTest, name)
+{
+    EXPECT_TRUE(std::string("frequency_bandwidth") == m_decider->name());
+    EXPECT_TRUE(m_decider->decider_supported("frequency_bandwidth"));
+    EXPECT_FALSE(m_decider->decider_supported("power_balancing"));
+    geopm::Decider *cloned = m_decider->clone();
+    EXPECT_TRUE(std::string("frequency_bandwidth") == cloned->name());
+    delete cloned;
+}
+
+TEST_F(BandwidthDeciderTest, first_sample)
+{
+    // Entering the region enforces its policy.  The first sample
+    // has no derivative, the region stays at the upper bound and is
+    // not converged
+    EXPECT_TRUE(sample(*m_region, 0.2, 100.0));
+    check_target(m_region_id, m_upper_bound);
+    EXPECT_FALSE(m_policy->is_converged(m_region_id));
+    // Compute bound samples converge at once
+    EXPECT_FALSE(sample(*m_region, 2.0, 10.0));
+    check_target(m_region_id, m_upper_bound);
+    EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    // No cycles elapsed, the sample carries no IPC
+    EXPECT_FALSE(sample(*m_region, NAN, 10.0));
+    check_target(m_region_id, m_upper_bound);
+    EXPECT_FALSE(m_policy->is_converged(m_region_id));
+}
+
+TEST_F(BandwidthDeciderTest, enter_and_leave)
+{
+    sample(*m_region, 2.0, 10.0);
+    EXPECT_FALSE(sample(*m_region, 2.0, 10.0));
+    check_target(m_region_id, m_upper_bound);
+    // Low IPC with the highest bandwidth seen must persist for five
+    // samples before the region is classified as memory bound
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(sample(*m_region, 0.3, 100.0));
+        check_target(m_region_id, m_upper_bound);
+        EXPECT_FALSE(m_policy->is_converged(m_region_id));
+    }
+    EXPECT_TRUE(sample(*m_region, 0.3, 100.0));
+    check_target(m_region_id, m_memory_frequency);
+    EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    // Between the enter and exit thresholds the state is kept
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(sample(*m_region, 0.75, 50.0));
+        check_target(m_region_id, m_memory_frequency);
+        EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    }
+    // High IPC must also persist for five samples to leave
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(sample(*m_region, 1.5, 50.0));
+        check_target(m_region_id, m_memory_frequency);
+    }
+    EXPECT_TRUE(sample(*m_region, 1.5, 50.0));
+    check_target(m_region_id, m_upper_bound);
+    EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    // Low IPC at a small fraction of the peak bandwidth is not
+    // memory bound
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(sample(*m_region, 0.3, 10.0));
+        check_target(m_region_id, m_upper_bound);
+        EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    }
+}
+
+TEST_F(BandwidthDeciderTest, region_boundary)
+{
+    sample(*m_region, 2.0, 10.0);
+    for (int i = 0; i < 5; ++i) {
+        sample(*m_region, 0.3, 100.0);
+    }
+    check_target(m_region_id, m_memory_frequency);
+    // Entering a new region must enforce its targets, which start at
+    // the upper bound, even though they have not changed
+    geopm::Region region(m_region_id + 2, GEOPM_POLICY_HINT_UNKNOWN, m_num_domain, 0);
+    EXPECT_TRUE(sample(region, 2.0, 10.0));
+    check_target(m_region_id + 2, m_upper_bound);
+    EXPECT_FALSE(sample(region, 2.0, 10.0));
+    check_target(m_region_id + 2, m_upper_bound);
+    // and returning to the memory bound region restores its target
+    EXPECT_TRUE(sample(*m_region, 0.3, 100.0));
+    check_target(m_region_id, m_memory_frequency);
+    EXPECT_FALSE(sample(*m_region, 0.3, 100.0));
+}
+
+TEST_F(BandwidthDeciderTest, hysteresis_reset)
+{
+    sample(*m_region, 2.0, 100.0);
+    // A single compute bound sample restarts the count
+    for (int i = 0; i < 4; ++i) {
+        sample(*m_region, 0.3, 100.0);
+    }
+    sample(*m_region, 2.0, 100.0);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(sample(*m_region, 0.3, 100.0));
+        check_target(m_region_id, m_upper_bound);
+    }
+    // A sample without IPC neither counts nor restarts the count
+    EXPECT_FALSE(sample(*m_region, NAN, 100.0));
+    check_target(m_region_id, m_upper_bound);
+    EXPECT_TRUE(sample(*m_region, 0.3, 100.0));
+    check_target(m_region_id, m_memory_frequency);
+}
+
+TEST_F(BandwidthDeciderTest, hint_memory)
+{
+    geopm::Region region(m_region_id + 1, GEOPM_POLICY_HINT_MEMORY, m_num_domain, 0);
+    // The hint places the region at the memory frequency before it
+    // has been sampled
+    EXPECT_TRUE(sample(region, NAN, 0.0));
+    check_target(m_region_id + 1, m_memory_frequency);
+    EXPECT_FALSE(m_policy->is_converged(m_region_id + 1));
+    // Compute bound samples move it back after five samples
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_FALSE(sample(region, 2.0, 10.0));
+        check_target(m_region_id + 1, m_memory_frequency);
+    }
+    EXPECT_TRUE(sample(region, 2.0, 10.0));
+    check_target(m_region_id + 1, m_upper_bound);
+}
@@ -90,3 +90,23 @@ TEST_F(CircularBufferTest, buffer_capacity)
     m_buffer->set_capacity(2);
     EXPECT_EQ(2, m_buffer->capacity());
 }
+
+TEST_F(CircularBufferTest, buffer_slot)
+{
+    // Slot is not part of the buffer until advanced
+    m_buffer->slot() = 4.0;
+    EXPECT_EQ(3, m_buffer->size());
+    m_buffer->advance();
+    EXPECT_EQ(4, m_buffer->size());
+    EXPECT_DOUBLE_EQ(4.0, m_buffer->value(3));
+    m_buffer->insert(5.0);
+    // When full the slot is the oldest entry
+    double &oldest = m_buffer->slot();
+    EXPECT_DOUBLE_EQ(1.0, oldest);
+    oldest = 6.0;
+    EXPECT_DOUBLE_EQ(6.0, m_buffer->value(0));
+    m_buffer->advance();
+    EXPECT_EQ(5, m_buffer->size());
+    EXPECT_DOUBLE_EQ(2.0, m_buffer->value(0));
+    EXPECT_DOUBLE_EQ(6.0, m_buffer->value(4));
+}
@@ -78,3 +78,20 @@ TEST_F(DeciderFactoryTest, no_supported_decider)
     ASSERT_EQ(NULL, d);
     EXPECT_EQ(GEOPM_ERROR_DECIDER_UNSUPPORTED, thrown);
 }
+
+TEST_F(DeciderFactoryTest, plugin_cache)
+{
+    // Plugins are scanned once per process; a factory closing its
+    // library references must not unload them for the next factory.
+    for (int i = 0; i < 2; ++i) {
+        geopm::DeciderFactory factory;
+        geopm::Decider *d = factory.decider("power_governing");
+        ASSERT_FALSE(d == NULL);
+        EXPECT_EQ("power_governing", d->name());
+        delete d;
+        d = factory.decider("static_policy");
+        ASSERT_FALSE(d == NULL);
+        EXPECT_EQ("static_policy", d->name());
+        delete d;
+    }
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <math.h>
+
+#include "gtest/gtest.h"
+#include "geopm_message.h"
+#include "FrequencySearchDecider.hpp"
+#include "Region.hpp"
+#include "Policy.hpp"
+
+class FrequencySearchDeciderTest: public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        /// Runtime of one entry into the region at frequency, the
+        /// energy of every entry is one joule so this is also the
+        /// energy-delay product.
+        double runtime(double frequency) const;
+        /// Complete one entry into the region with the runtime given,
+        /// or with runtime(target) if it is NAN, and run the decider.
+        /// Returns the target the entry ran at.
+        double entry(geopm::Region &region, double entry_runtime = NAN);
+        double target(uint64_t region_id);
+        geopm::FrequencySearchDecider *m_decider;
+        geopm::Policy *m_policy;
+        geopm::Region *m_region;
+        struct geopm_policy_message_s m_policy_message;
+        const int m_num_domain = 2;
+        const double m_upper_bound = 2.0e9;
+        const double m_lower_bound = 1.0e9;
+        const double m_best_frequency = 1.3e9;
+        const uint64_t m_region_id = 42;
+};
+
+void FrequencySearchDeciderTest::SetUp()
+{
+    m_decider = new geopm::FrequencySearchDecider;
+    m_decider->bound(m_upper_bound, m_lower_bound);
+    m_policy = new geopm::Policy(m_num_domain);
+    m_region = new geopm::Region(m_region_id, GEOPM_POLICY_HINT_UNKNOWN, m_num_domain, 1);
+    m_policy_message = GEOPM_POLICY_UNKNOWN;
+    m_policy_message.mode = GEOPM_POLICY_MODE_FREQ_UNIFORM_DYNAMIC;
+    EXPECT_TRUE(m_decider->update_policy(m_policy_message, *m_policy));
+    EXPECT_FALSE(m_decider->update_policy(m_policy_message, *m_policy));
+    EXPECT_DOUBLE_EQ(m_upper_bound, target(GEOPM_REGION_ID_OUTER));
+}
+
+void FrequencySearchDeciderTest::TearDown()
+{
+    delete m_region;
+    delete m_policy;
+    delete m_decider;
+}
+
+double FrequencySearchDeciderTest::runtime(double frequency) const
+{
+    double delta = (frequency - m_best_frequency) / (m_upper_bound - m_lower_bound);
+    return 1.0 + delta * delta;
+}
+
+double FrequencySearchDeciderTest::entry(geopm::Region &region, double entry_runtime)
+{
+    double frequency = target(region.identifier());
+    std::vector<struct geopm_sample_message_s> sample(m_num_domain);
+    for (auto it = sample.begin(); it != sample.end(); ++it) {
+        (*it).region_id = region.identifier();
+        (*it).signal[GEOPM_SAMPLE_TYPE_RUNTIME] = isnan(entry_runtime) ? runtime(frequency) : entry_runtime;
+        (*it).signal[GEOPM_SAMPLE_TYPE_ENERGY] = 1.0 / m_num_domain;
+        (*it).signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME] = 0.0;
+    }
+    region.insert(sample);
+    m_decider->update_policy(region, *m_policy);
+    return frequency;
+}
+
+double FrequencySearchDeciderTest::target(uint64_t region_id)
+{
+    std::vector<double> result(m_num_domain);
+    m_policy->target(region_id, result);
+    for (int domain_idx = 1; domain_idx < m_num_domain; ++domain_idx) {
+        EXPECT_DOUBLE_EQ(result[0], result[domain_idx]);
+    }
+    return result[0];
+}
+
+TEST_F(FrequencySearchDeciderTest, name)
+{
+    EXPECT_TRUE(std::string("frequency_search") == m_decider->name());
+    EXPECT_TRUE(m_decider->decider_supported("frequency_search"));
+    EXPECT_FALSE(m_decider->decider_supported("frequency_bandwidth"));
+    geopm::Decider *cloned = m_decider->clone();
+    EXPECT_TRUE(std::string("frequency_search") == cloned->name());
+    delete cloned;
+}
+
+TEST_F(FrequencySearchDeciderTest, converge)
+{
+    const double range = m_upper_bound - m_lower_bound;
+    EXPECT_TRUE(m_decider->update_policy(*m_region, *m_policy));
+    // The first entry is discarded, then each of the two interior
+    // points of the golden-section bracket is measured three times.
+    const double point_0 = m_upper_bound - 0.6180339887498949 * range;
+    const double point_1 = m_lower_bound + 0.6180339887498949 * range;
+    EXPECT_DOUBLE_EQ(point_0, entry(*m_region, 1.0e-3));
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(point_0, entry(*m_region));
+        EXPECT_FALSE(m_policy->is_converged(m_region_id));
+    }
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(point_1, entry(*m_region));
+        EXPECT_FALSE(m_policy->is_converged(m_region_id));
+    }
+    // Entries that report no runtime are not counted
+    EXPECT_DOUBLE_EQ(point_1 - 0.6180339887498949 * (point_1 - m_lower_bound), target(m_region_id));
+    entry(*m_region, 0.0);
+    entry(*m_region, -1.0);
+    // Each later point narrows the bracket by the golden ratio until
+    // it is within 5% of the frequency range: six more points.
+    int num_entry = 0;
+    while (!m_policy->is_converged(m_region_id) && num_entry < 100) {
+        double frequency = entry(*m_region);
+        EXPECT_LE(m_lower_bound, frequency);
+        EXPECT_GE(m_upper_bound, frequency);
+        ++num_entry;
+    }
+    EXPECT_EQ(6 * 3, num_entry);
+    ASSERT_TRUE(m_policy->is_converged(m_region_id));
+    double best = target(m_region_id);
+    EXPECT_NEAR(m_best_frequency, best, 0.05 * range);
+    // The best frequency is locked in
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_DOUBLE_EQ(best, entry(*m_region, 1.0e-3));
+        EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    }
+}
+
+TEST_F(FrequencySearchDeciderTest, region_boundary)
+{
+    geopm::Region other(m_region_id + 1, GEOPM_POLICY_HINT_UNKNOWN, m_num_domain, 1);
+    // Switching regions asks for the policy to be enforced, staying
+    // in a region without a new target does not.
+    EXPECT_TRUE(m_decider->update_policy(*m_region, *m_policy));
+    EXPECT_FALSE(m_decider->update_policy(*m_region, *m_policy));
+    EXPECT_TRUE(m_decider->update_policy(other, *m_policy));
+    EXPECT_FALSE(m_decider->update_policy(other, *m_policy));
+    EXPECT_TRUE(m_decider->update_policy(*m_region, *m_policy));
+}
+
+TEST_F(FrequencySearchDeciderTest, seed)
+{
+    std::vector<double> seed(m_num_domain, 1.4e9);
+    m_policy->seed(m_region_id, m_num_domain * m_upper_bound, seed, true);
+    // A region learned in an earlier run starts out converged at the
+    // cached frequency
+    EXPECT_TRUE(m_decider->update_policy(*m_region, *m_policy));
+    EXPECT_DOUBLE_EQ(1.4e9, target(m_region_id));
+    EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_DOUBLE_EQ(1.4e9, entry(*m_region));
+        EXPECT_TRUE(m_policy->is_converged(m_region_id));
+    }
+}
+
+TEST_F(FrequencySearchDeciderTest, hint)
+{
+    const int hint[] = {GEOPM_POLICY_HINT_COMPUTE,
+                        GEOPM_POLICY_HINT_MEMORY,
+                        GEOPM_POLICY_HINT_NETWORK};
+    const double expect[] = {m_upper_bound,
+                             1.5e9,
+                             m_lower_bound};
+    for (int i = 0; i < 3; ++i) {
+        geopm::Region region(m_region_id + i + 1, hint[i], m_num_domain, 1);
+        // Hinted regions skip the search
+        EXPECT_TRUE(m_decider->update_policy(region, *m_policy));
+        EXPECT_DOUBLE_EQ(expect[i], target(region.identifier()));
+        EXPECT_TRUE(m_policy->is_converged(region.identifier()));
+        for (int j = 0; j < 5; ++j) {
+            EXPECT_DOUBLE_EQ(expect[i], entry(region));
+            EXPECT_TRUE(m_policy->is_converged(region.identifier()));
+        }
+    }
+    // A seed takes precedence over the hint
+    std::vector<double> seed(m_num_domain, 1.4e9);
+    m_policy->seed(m_region_id + 4, m_num_domain * m_upper_bound, seed, true);
+    geopm::Region region(m_region_id + 4, GEOPM_POLICY_HINT_COMPUTE, m_num_domain, 1);
+    m_decider->update_policy(region, *m_policy);
+    EXPECT_DOUBLE_EQ(1.4e9, target(region.identifier()));
+    // unless the search had not finished when it was cached
+    m_policy->seed(m_region_id + 5, m_num_domain * m_upper_bound, seed, false);
+    geopm::Region probe_region(m_region_id + 5, GEOPM_POLICY_HINT_COMPUTE, m_num_domain, 1);
+    m_decider->update_policy(probe_region, *m_policy);
+    EXPECT_DOUBLE_EQ(m_upper_bound, target(probe_region.identifier()));
+}
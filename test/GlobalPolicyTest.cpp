@@ -31,6 +31,7 @@
  */
 #include <unistd.h>
 #include <iostream>
+#include <fstream>
 
 #include "gtest/gtest.h"
 #include "geopm_policy.h"
@@ -501,3 +502,59 @@ TEST_F(GlobalPolicyTest, negative_c_interface)
     EXPECT_EQ(GEOPM_ERROR_POLICY_NULL, geopm_policy_write(policy));
     EXPECT_EQ(GEOPM_ERROR_POLICY_NULL, geopm_policy_destroy(policy));
 }
+
+TEST_F(GlobalPolicyTestShmem, generation)
+{
+    geopm::GlobalPolicy writer("", m_path);
+    writer.tree_decider("power_balancing");
+    writer.leaf_decider("power_governing");
+    writer.mode(GEOPM_POLICY_MODE_DYNAMIC);
+    writer.budget_watts(1000);
+    writer.write();
+
+    geopm::GlobalPolicy reader(m_path, "");
+    struct geopm_policy_message_s message;
+    reader.policy_message(message);
+    EXPECT_EQ(1000, message.power_budget);
+
+    // An unchanged policy is not read again, so local values stand
+    reader.budget_watts(500);
+    reader.policy_message(message);
+    EXPECT_EQ(500, message.power_budget);
+
+    // A new write is picked up
+    writer.budget_watts(2000);
+    writer.write();
+    reader.policy_message(message);
+    EXPECT_EQ(2000, message.power_budget);
+}
+
+TEST_F(GlobalPolicyTest, watch)
+{
+    geopm::GlobalPolicy *writer = new geopm::GlobalPolicy("", m_path);
+    writer->tree_decider("power_balancing");
+    writer->leaf_decider("power_governing");
+    writer->mode(GEOPM_POLICY_MODE_PERF_BALANCE_DYNAMIC);
+    writer->budget_watts(1000);
+    writer->write();
+
+    geopm::GlobalPolicy reader(m_path, "");
+    reader.watch();
+    struct geopm_policy_message_s message;
+    reader.policy_message(message);
+    EXPECT_EQ(1000, message.power_budget);
+
+    writer->budget_watts(2000);
+    writer->write();
+    reader.policy_message(message);
+    EXPECT_EQ(2000, message.power_budget);
+    delete writer;
+
+    // A malformed update is ignored
+    std::ofstream bad_file(m_path.c_str());
+    bad_file << "{\"mode\": \"not_a_mode\"}";
+    bad_file.close();
+    reader.policy_message(message);
+    EXPECT_EQ(2000, message.power_budget);
+    EXPECT_EQ(GEOPM_POLICY_MODE_PERF_BALANCE_DYNAMIC, message.mode);
+}
@@ -32,68 +32,137 @@
 
 #include <mpi.h>
 #include <unistd.h>
+#include <limits.h>
+#include <stdio.h>
+#include <fstream>
+#include <string>
 
 #include "gtest/gtest.h"
-#include "Controller.hpp"
 #include "geopm.h"
+#include "geopm_env.h"
+#include "geopm_time.h"
 
 #ifndef NAME_MAX
 #define NAME_MAX 256
 #endif
 
-class MPIControllerTest: public :: testing :: Test {};
+class MPIControllerTest: public :: testing :: Test
+{
+    public:
+        MPIControllerTest();
+        virtual ~MPIControllerTest();
+    protected:
+        void spin(double duration);
+        void parse_log(const std::string &region_name, double &runtime, double &count);
+        double m_epsilon;
+        std::string m_log_file_node;
+        bool m_is_node_root;
+};
+
+MPIControllerTest::MPIControllerTest()
+    : m_epsilon(0.5)
+    , m_log_file_node(geopm_env_report())
+    , m_is_node_root(false)
+{
+    char hostname[NAME_MAX];
+    MPI_Comm ppn1_comm;
+    gethostname(hostname, NAME_MAX);
+    m_log_file_node.append("-");
+    m_log_file_node.append(hostname);
+
+    geopm_comm_split_ppn1(MPI_COMM_WORLD, "ctl_test", &ppn1_comm);
+    if (ppn1_comm != MPI_COMM_NULL) {
+        m_is_node_root = true;
+        MPI_Comm_free(&ppn1_comm);
+    }
+}
+
+MPIControllerTest::~MPIControllerTest()
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (m_is_node_root) {
+        remove(m_log_file_node.c_str());
+    }
+}
 
-TEST_F(MPIControllerTest, hello)
+void MPIControllerTest::spin(double duration)
 {
-    FILE *fid;
-    int rank;
-    std::vector<int> factor(2);
-    std::string control;
-    std::string report;
-    factor[0] = 4;
-    factor[1] = 4;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if (!rank) {
-        control = "/tmp/MPIControllerTest.hello.control";
-        report =  "/tmp/MPIControllerTest.hello.report";
-        fid = fopen(control.c_str(), "w");
-        EXPECT_TRUE(fid != NULL);
-        fprintf(fid, "goal:performance\n");
-        fprintf(fid, "mode:dynamic_power\n");
-        fprintf(fid, "power_budget:1.0\n");
-        fclose(fid);
+    struct geopm_time_s start;
+    struct geopm_time_s curr;
+    double timeout = 0.0;
+    geopm_time(&start);
+    while (timeout < duration) {
+        geopm_time(&curr);
+        timeout = geopm_time_diff(&start, &curr);
     }
-    geopm::Controller hello_ctl(factor, control, report, MPI_COMM_WORLD);
-    hello_ctl.run();
-    if (!rank) {
-        unlink(control.c_str());
+}
+
+void MPIControllerTest::parse_log(const std::string &region_name, double &runtime, double &count)
+{
+    std::string line;
+    std::ifstream log(m_log_file_node, std::ios_base::in);
+    runtime = -1.0;
+    count = -1.0;
+    ASSERT_TRUE(log.is_open());
+    while (std::getline(log, line)) {
+        if (line.find("Region " + region_name + ":") == 0) {
+            while (std::getline(log, line) && line.find("Region ") != 0) {
+                sscanf(line.c_str(), " runtime (sec): %lf", &runtime);
+                sscanf(line.c_str(), " count: %lf", &count);
+            }
+            break;
+        }
     }
 }
 
-TEST_F(MPIControllerTest, geopm_ctl_run)
+TEST_F(MPIControllerTest, intermittent_region)
 {
-    FILE *fid;
-    int rank;
-    int num_factor = 2;
-    const int factor[2] = {4,4};
-    char control[NAME_MAX] = {0};
-    char report[NAME_MAX] = {0};
-
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-    if (!rank) {
-        strncpy(control, "/tmp/MPIControllerTest.geopm_ctl_run.control", NAME_MAX - 1);
-        strncpy(report, "/tmp/MPIControllerTest.geopm_ctl_run.report", NAME_MAX - 1);
-        fid = fopen(control, "w");
-        EXPECT_TRUE(fid != NULL);
-        fprintf(fid, "goal:efficency\n");
-        fprintf(fid, "mode:dynamic_power\n");
-        fprintf(fid, "power_budget:1.0\n");
-        fclose(fid);
+    // Regions that are not entered in every outer loop iteration
+    // leave the tree levels with nothing new to report for them on
+    // most control loops.
+    const int num_iter = 6;
+    const double duration = 0.25;
+    uint64_t region_id[3];
+
+    ASSERT_EQ(0, geopm_prof_region("every_iter", GEOPM_POLICY_HINT_UNKNOWN, &region_id[0]));
+    ASSERT_EQ(0, geopm_prof_region("even_iter", GEOPM_POLICY_HINT_UNKNOWN, &region_id[1]));
+    ASSERT_EQ(0, geopm_prof_region("first_iter", GEOPM_POLICY_HINT_UNKNOWN, &region_id[2]));
+    for (int i = 0; i < num_iter; ++i) {
+        ASSERT_EQ(0, geopm_prof_outer_sync());
+
+        ASSERT_EQ(0, geopm_prof_enter(region_id[0]));
+        spin(duration);
+        ASSERT_EQ(0, geopm_prof_exit(region_id[0]));
+
+        if (i % 2 == 0) {
+            ASSERT_EQ(0, geopm_prof_enter(region_id[1]));
+            spin(duration);
+            ASSERT_EQ(0, geopm_prof_exit(region_id[1]));
+        }
+
+        if (i == 0) {
+            ASSERT_EQ(0, geopm_prof_enter(region_id[2]));
+            spin(duration);
+            ASSERT_EQ(0, geopm_prof_exit(region_id[2]));
+        }
+
+        MPI_Barrier(MPI_COMM_WORLD);
     }
 
-    EXPECT_EQ(0, geopm_ctl_run(num_factor, factor, control, report, MPI_COMM_WORLD));
+    ASSERT_EQ(0, geopm_prof_shutdown());
+    sleep(1); // Wait for controller to finish writing the report
 
-    if (!rank) {
-        unlink(control);
+    if (m_is_node_root) {
+        double runtime;
+        double count;
+        parse_log("every_iter", runtime, count);
+        EXPECT_NEAR(num_iter * duration, runtime, m_epsilon);
+        EXPECT_DOUBLE_EQ(num_iter, count);
+        parse_log("even_iter", runtime, count);
+        EXPECT_NEAR(num_iter / 2 * duration, runtime, m_epsilon);
+        EXPECT_DOUBLE_EQ(num_iter / 2, count);
+        parse_log("first_iter", runtime, count);
+        EXPECT_NEAR(duration, runtime, m_epsilon);
+        EXPECT_DOUBLE_EQ(1.0, count);
     }
 }
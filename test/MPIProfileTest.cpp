@@ -465,3 +465,14 @@ TEST_F(MPIProfileTest, noctl)
     ASSERT_EQ(0, geopm_prof_exit(region_id[2]));
 
 }
+
+TEST_F(MPIProfileTest, noctl_invalid_hint)
+{
+    uint64_t region_id = 0;
+
+    EXPECT_EQ(GEOPM_ERROR_INVALID, geopm_prof_region("bad_hint", GEOPM_POLICY_HINT_NETWORK + 1, &region_id));
+    EXPECT_EQ(GEOPM_ERROR_INVALID, geopm_prof_region("bad_hint", -1, &region_id));
+    for (long hint = GEOPM_POLICY_HINT_UNKNOWN; hint <= GEOPM_POLICY_HINT_NETWORK; ++hint) {
+        EXPECT_EQ(0, geopm_prof_region("good_hint", hint, &region_id));
+    }
+}
@@ -37,6 +37,7 @@
 #include <string.h>
 #include "gtest/gtest.h"
 #include "SharedMemory.hpp"
+#include "Exception.hpp"
 
 class MPISharedMemoryTest: public :: testing :: Test
 {
@@ -85,3 +86,40 @@ TEST_F(MPISharedMemoryTest, hello)
     delete sm;
     delete smu;
 }
+
+TEST_F(MPISharedMemoryTest, attach_wait)
+{
+    int rank;
+    const char *test_string = "THIS IS THE TEST STRING";
+    geopm::SharedMemory *sm = NULL;
+    geopm::SharedMemoryUser *smu = NULL;
+
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank == 0) {
+        // Create the region after the user has started waiting on it.
+        usleep(200000);
+        sm = new geopm::SharedMemory(m_shm_key, 128);
+        strcpy((char *)sm->pointer(), test_string);
+    }
+    if (rank == 1) {
+        smu = new geopm::SharedMemoryUser(m_shm_key, 5);
+        EXPECT_EQ(128ULL, smu->size());
+        while (strncmp((char *)smu->pointer(), test_string, strlen(test_string))) {
+            usleep(1000);
+        }
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    delete sm;
+    delete smu;
+}
+
+TEST_F(MPISharedMemoryTest, attach_timeout)
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 1) {
+        EXPECT_THROW(geopm::SharedMemoryUser(m_shm_key, 1), geopm::Exception);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+}
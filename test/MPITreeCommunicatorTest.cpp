@@ -33,32 +33,88 @@
 #include <mpi.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <errno.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/utsname.h>
 #include <fcntl.h>
-
+#include <string.h>
+#include <fstream>
 
 #include "gtest/gtest.h"
 #include "TreeCommunicator.hpp"
 #include "Controller.hpp"
 #include "GlobalPolicy.hpp"
 #include "geopm_policy.h"
+#include "geopm.h"
+#include "geopm_comm.h"
+#include "geopm_time.h"
 #include "Exception.hpp"
 
 #ifndef NAME_MAX
 #define NAME_MAX 256
 #endif
 
+/// Host name reported to the tree communicator while a fixture needs
+/// ranks on one node to look like they are spread across hosts.
+static std::string g_fake_hostname;
+
+extern "C" int gethostname(char *name, size_t len) throw()
+{
+    std::string result(g_fake_hostname);
+    if (result.empty()) {
+        struct utsname uts;
+        if (uname(&uts)) {
+            return -1;
+        }
+        result = uts.nodename;
+    }
+    if (result.size() + 1 > len) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strncpy(name, result.c_str(), len);
+    return 0;
+}
+
 class MPITreeCommunicatorTest: public :: testing :: Test
 {
     public:
-        MPITreeCommunicatorTest();
+        MPITreeCommunicatorTest(bool is_rma = false, const std::string &topology = "");
         ~MPITreeCommunicatorTest();
     protected:
+        void hello(void);
+        void send_policy_down(void);
+        void send_policy_burst(void);
+        void send_sample_up(void);
+        void send_sample_stale(void);
+        void send_sample_region(void);
         geopm::TreeCommunicator *m_tcomm;
         geopm::GlobalPolicy *m_polctl;
 };
 
+class MPITreeCommunicatorRMATest: public MPITreeCommunicatorTest
+{
+    public:
+        MPITreeCommunicatorRMATest();
+};
+
+class MPITreeCommunicatorTopologyTest: public MPITreeCommunicatorTest
+{
+    public:
+        MPITreeCommunicatorTopologyTest();
+};
+
+class MPITreeCommunicatorTopologyFileTest: public MPITreeCommunicatorTest
+{
+    public:
+        MPITreeCommunicatorTopologyFileTest();
+        ~MPITreeCommunicatorTopologyFileTest();
+    protected:
+        static std::string topology_file(void);
+        static const char *M_TOPOLOGY_PATH;
+};
+
 
 class MPITreeCommunicatorTestShmem: public :: testing :: Test
 {
@@ -73,7 +129,7 @@ class MPITreeCommunicatorTestShmem: public :: testing :: Test
 };
 
 
-MPITreeCommunicatorTest::MPITreeCommunicatorTest()
+MPITreeCommunicatorTest::MPITreeCommunicatorTest(bool is_rma, const std::string &topology)
     : m_tcomm(NULL)
     , m_polctl(NULL)
 {
@@ -91,7 +147,7 @@ MPITreeCommunicatorTest::MPITreeCommunicatorTest()
         m_polctl->write();
     }
 
-    m_tcomm = new geopm::TreeCommunicator(factor, m_polctl, MPI_COMM_WORLD);
+    m_tcomm = new geopm::TreeCommunicator(factor, m_polctl, MPI_COMM_WORLD, is_rma, topology);
 
     if (!rank) {
         unlink(control.c_str());
@@ -107,6 +163,55 @@ MPITreeCommunicatorTest::~MPITreeCommunicatorTest()
     }
 }
 
+MPITreeCommunicatorRMATest::MPITreeCommunicatorRMATest()
+    : MPITreeCommunicatorTest(true)
+{
+
+}
+
+MPITreeCommunicatorTopologyTest::MPITreeCommunicatorTopologyTest()
+    : MPITreeCommunicatorTest(false, "hostname:.*")
+{
+
+}
+
+const char *MPITreeCommunicatorTopologyFileTest::M_TOPOLOGY_PATH = "/tmp/MPITreeCommunicatorTest.topology";
+
+MPITreeCommunicatorTopologyFileTest::MPITreeCommunicatorTopologyFileTest()
+    : MPITreeCommunicatorTest(false, topology_file())
+{
+
+}
+
+MPITreeCommunicatorTopologyFileTest::~MPITreeCommunicatorTopologyFileTest()
+{
+    int rank;
+    g_fake_hostname.clear();
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (!rank) {
+        unlink(M_TOPOLOGY_PATH);
+    }
+}
+
+std::string MPITreeCommunicatorTopologyFileTest::topology_file(void)
+{
+    // Even ranks run on host "node-a" in group "switch-0", odd ranks
+    // on "node-b" in "switch-1".  A host not in the file keeps its
+    // own name as key.
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    g_fake_hostname = rank % 2 ? "node-b" : "node-a";
+    if (!rank) {
+        std::ofstream topology(M_TOPOLOGY_PATH);
+        topology << "node-c switch-0" << std::endl;
+        topology << "node-b switch-1" << std::endl;
+        topology << "node-a switch-0" << std::endl;
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    return std::string("file:") + M_TOPOLOGY_PATH;
+}
+
 #if 0
 MPITreeCommunicatorTestShmem::MPITreeCommunicatorTestShmem()
     : m_tcomm(NULL)
@@ -178,7 +283,7 @@ TEST_F(MPITreeCommunicatorTestShmem, hello)
 }
 #endif
 
-TEST_F(MPITreeCommunicatorTest, hello)
+void MPITreeCommunicatorTest::hello(void)
 {
     EXPECT_EQ(1, m_tcomm->num_level() > 0 && m_tcomm->num_level() <= 3);
     EXPECT_EQ(1, m_tcomm->root_level() == 2);
@@ -187,7 +292,7 @@ TEST_F(MPITreeCommunicatorTest, hello)
     EXPECT_EQ(1, m_tcomm->level_size(2) == 1);
 }
 
-TEST_F(MPITreeCommunicatorTest, send_policy_down)
+void MPITreeCommunicatorTest::send_policy_down(void)
 {
     int success;
     struct geopm_policy_message_s policy = {0};
@@ -224,7 +329,47 @@ TEST_F(MPITreeCommunicatorTest, send_policy_down)
     }
 }
 
-TEST_F(MPITreeCommunicatorTest, send_sample_up)
+void MPITreeCommunicatorTest::send_policy_burst(void)
+{
+    // More policies than the level has receive buffers are sent
+    // before any member polls, so the sends roll over both persistent
+    // outboxes and fall back to one time sends.
+    const int num_burst = 5;
+    struct geopm_policy_message_s policy = {0};
+    std::vector <struct geopm_policy_message_s> send_policy(m_tcomm->level_size(0));
+
+    if (m_tcomm->level_rank(0) == 0) {
+        for (int burst = 1; burst <= num_burst; ++burst) {
+            policy.flags = burst;
+            fill(send_policy.begin(), send_policy.end(), policy);
+            m_tcomm->send_policy(0, send_policy);
+        }
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    int last_flags = 0;
+    struct geopm_time_s start, curr;
+    geopm_time(&start);
+    curr = start;
+    while (last_flags != num_burst && geopm_time_diff(&start, &curr) < 10.0) {
+        try {
+            m_tcomm->get_policy(0, policy);
+            // Policies arrive in the order sent
+            EXPECT_LE(last_flags, (int)policy.flags);
+            last_flags = policy.flags;
+        }
+        catch (geopm::Exception ex) {
+            if (ex.err_value() != GEOPM_ERROR_POLICY_UNKNOWN) {
+                throw ex;
+            }
+        }
+        geopm_time(&curr);
+    }
+    EXPECT_EQ(num_burst, last_flags);
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void MPITreeCommunicatorTest::send_sample_up(void)
 {
     int success;
     std::vector <struct geopm_sample_message_s> sample;
@@ -260,3 +405,265 @@ TEST_F(MPITreeCommunicatorTest, send_sample_up)
         }
     }
 }
+
+void MPITreeCommunicatorTest::send_sample_stale(void)
+{
+    std::vector <struct geopm_sample_message_s> sample;
+    std::vector <int> age;
+    struct geopm_sample_message_s send_sample = {0};
+    int size = m_tcomm->level_size(0);
+    int rank = m_tcomm->level_rank(0);
+    bool is_root = m_tcomm->num_level() > 1 && rank == 0;
+
+    sample.resize(size);
+    age.resize(size);
+    for (int step = 0; step < 2; ++step) {
+        // The last member of each group straggles on the second step
+        if (step == 0 || rank != size - 1) {
+            send_sample.signal[0] = rank + step * size;
+            m_tcomm->send_sample(0, send_sample);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+        sleep(1);
+        if (is_root && size > 1) {
+            m_tcomm->max_sample_age(step);
+            bool success = false;
+            while (!success) {
+                try {
+                    m_tcomm->get_sample(1, sample, age);
+                    success = true;
+                }
+                catch (geopm::Exception ex) {
+                    if (ex.err_value() == GEOPM_ERROR_SAMPLE_INCOMPLETE) {
+                        sleep(1);
+                    }
+                    else {
+                        throw ex;
+                    }
+                }
+            }
+            for (int child = 0; child < size; ++child) {
+                EXPECT_EQ(child + (step - age[child]) * size, sample[child].signal[0]);
+            }
+            if (step) {
+                EXPECT_EQ(1, age[size - 1]);
+                EXPECT_EQ(size - 1, sample[size - 1].signal[0]);
+            }
+            else {
+                EXPECT_EQ(0, age[size - 1]);
+            }
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+}
+
+void MPITreeCommunicatorTest::send_sample_region(void)
+{
+    std::vector<std::vector<struct geopm_sample_message_s> > sample;
+    std::vector<int> age;
+    int size = m_tcomm->level_size(0);
+    int rank = m_tcomm->level_rank(0);
+    // Each member sends a different number of region samples
+    int num_region = rank % geopm::TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION + 1;
+    std::vector<struct geopm_sample_message_s> send_sample(num_region);
+
+    for (int region = 0; region < num_region; ++region) {
+        send_sample[region] = {(uint64_t)region, {0.0}};
+        send_sample[region].signal[0] = rank;
+    }
+    send_sample[0].region_id = GEOPM_REGION_ID_OUTER;
+    m_tcomm->send_sample(0, send_sample);
+    if (m_tcomm->num_level() > 1 && rank == 0) {
+        sample.resize(size);
+        age.resize(size);
+        bool success = false;
+        while (!success) {
+            try {
+                m_tcomm->get_sample(1, sample, age);
+                success = true;
+            }
+            catch (geopm::Exception ex) {
+                if (ex.err_value() == GEOPM_ERROR_SAMPLE_INCOMPLETE) {
+                    sleep(1);
+                }
+                else {
+                    throw ex;
+                }
+            }
+        }
+        for (int child = 0; child < size; ++child) {
+            ASSERT_EQ((size_t)(child % geopm::TreeCommunicatorBase::M_MAX_NUM_SAMPLE_REGION + 1), sample[child].size());
+            EXPECT_EQ((uint64_t)GEOPM_REGION_ID_OUTER, sample[child][0].region_id);
+            for (size_t region = 0; region < sample[child].size(); ++region) {
+                if (region) {
+                    EXPECT_EQ(region, sample[child][region].region_id);
+                }
+                EXPECT_EQ(child, sample[child][region].signal[0]);
+            }
+        }
+    }
+    EXPECT_THROW(m_tcomm->send_sample(0, std::vector<struct geopm_sample_message_s>()), geopm::Exception);
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST_F(MPITreeCommunicatorTest, hello)
+{
+    hello();
+}
+
+TEST_F(MPITreeCommunicatorTest, send_policy_down)
+{
+    send_policy_down();
+}
+
+TEST_F(MPITreeCommunicatorTest, send_policy_burst)
+{
+    send_policy_burst();
+}
+
+TEST_F(MPITreeCommunicatorTest, send_sample_up)
+{
+    send_sample_up();
+}
+
+TEST_F(MPITreeCommunicatorTest, send_sample_stale)
+{
+    send_sample_stale();
+}
+
+TEST_F(MPITreeCommunicatorTest, send_sample_region)
+{
+    send_sample_region();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, hello)
+{
+    hello();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, send_policy_down)
+{
+    send_policy_down();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, send_policy_burst)
+{
+    send_policy_burst();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, send_sample_up)
+{
+    send_sample_up();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, send_sample_stale)
+{
+    send_sample_stale();
+}
+
+TEST_F(MPITreeCommunicatorRMATest, send_sample_region)
+{
+    send_sample_region();
+}
+
+TEST_F(MPITreeCommunicatorTopologyTest, leaf_group)
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    // Every rank has the same key, so consecutive ranks share a
+    // leaf group with the root first
+    int size = m_tcomm->level_size(0);
+    EXPECT_EQ(rank % size, m_tcomm->level_rank(0));
+    EXPECT_EQ(rank % size == 0, m_tcomm->num_level() > 1);
+    EXPECT_EQ(rank == 0, m_tcomm->num_level() == m_tcomm->root_level() + 1);
+}
+
+TEST_F(MPITreeCommunicatorTopologyTest, send_sample_up)
+{
+    send_sample_up();
+}
+
+TEST_F(MPITreeCommunicatorTopologyFileTest, leaf_group)
+{
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    ASSERT_EQ(16, size);
+    // The root's group "switch-0" (even ranks) fills the first two
+    // leaf groups in rank order, then "switch-1" (odd ranks) fills
+    // the last two.
+    int position = rank % 2 ? size / 2 + rank / 2 : rank / 2;
+    int leaf_size = m_tcomm->level_size(0);
+    ASSERT_EQ(4, leaf_size);
+    EXPECT_EQ(position % leaf_size, m_tcomm->level_rank(0));
+    EXPECT_EQ(position % leaf_size == 0, m_tcomm->num_level() > 1);
+    if (m_tcomm->num_level() > 1) {
+        EXPECT_EQ(position / leaf_size, m_tcomm->level_rank(1));
+    }
+    EXPECT_EQ(rank == 0, m_tcomm->num_level() == m_tcomm->root_level() + 1);
+
+    // Check that every leaf group holds a single switch.
+    int leaf_root = position - position % leaf_size;
+    int leaf_key = rank % 2;
+    std::vector<int> all_key(size);
+    MPI_Allgather(&leaf_key, 1, MPI_INT, all_key.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    for (int other = 0; other < size; ++other) {
+        int other_position = other % 2 ? size / 2 + other / 2 : other / 2;
+        if (other_position - other_position % leaf_size == leaf_root) {
+            EXPECT_EQ(leaf_key, all_key[other]);
+        }
+    }
+}
+
+TEST_F(MPITreeCommunicatorTopologyFileTest, send_sample_up)
+{
+    send_sample_up();
+}
+
+TEST(MPITreeCommunicatorTopologyErrorTest, invalid)
+{
+    int rank;
+    std::vector<int> factor(2, 4);
+    geopm::GlobalPolicy *polctl = NULL;
+    std::string control("/tmp/MPITreeCommunicatorTest.invalid.control");
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (!rank) {
+        polctl = new geopm::GlobalPolicy("", control);
+    }
+    const std::vector<std::string> topology {"hostname:(", "file:/tmp/MPITreeCommunicatorTest.missing", "switch:.*"};
+    const std::vector<int> error {GEOPM_ERROR_INVALID, GEOPM_ERROR_FILE_PARSE, GEOPM_ERROR_INVALID};
+    for (size_t i = 0; i < topology.size(); ++i) {
+        try {
+            geopm::TreeCommunicator tcomm(factor, polctl, MPI_COMM_WORLD, false, topology[i]);
+            FAIL() << "Expected geopm::Exception for topology " << topology[i];
+        }
+        catch (geopm::Exception ex) {
+            EXPECT_EQ(error[i], ex.err_value()) << topology[i];
+        }
+    }
+    delete polctl;
+    if (!rank) {
+        unlink(control.c_str());
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(MPICommSplitTest, cached)
+{
+    MPI_Comm shm_comm, shm_comm_again, ppn1_comm, split_comm;
+    int shm_rank, result;
+
+    ASSERT_EQ(0, geopm_comm_shared_cached(MPI_COMM_WORLD, &shm_comm));
+    ASSERT_EQ(0, geopm_comm_shared_cached(MPI_COMM_WORLD, &shm_comm_again));
+    EXPECT_EQ(shm_comm, shm_comm_again);
+    ASSERT_EQ(0, MPI_Comm_rank(shm_comm, &shm_rank));
+
+    ASSERT_EQ(0, geopm_comm_ppn1_cached(MPI_COMM_WORLD, &ppn1_comm));
+    EXPECT_EQ(!shm_rank, ppn1_comm != MPI_COMM_NULL);
+
+    // The public interface hands back a copy owned by the caller.
+    ASSERT_EQ(0, geopm_comm_split_shared(MPI_COMM_WORLD, "test", &split_comm));
+    ASSERT_EQ(0, MPI_Comm_compare(shm_comm, split_comm, &result));
+    EXPECT_EQ(MPI_CONGRUENT, result);
+    EXPECT_EQ(0, MPI_Comm_free(&split_comm));
+}
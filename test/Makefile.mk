@@ -53,14 +53,23 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/PlatformImpTest.negative_msr_open \
               test/gtest_links/PlatformImpTest.negative_msr_write_bad_value \
               test/gtest_links/PlatformImpTest.int_type_checks \
+              test/gtest_links/PlatformImpTest.counter_overflow \
               test/gtest_links/PlatformImpTest2.msr_write_restore_read \
               test/gtest_links/PlatformImpTest2.msr_write_backup_file \
               test/gtest_links/PlatformImpTest2.msr_restore_modified_value \
+              test/gtest_links/PlatformImpTest2.msr_restore_corrupt_file \
+              test/gtest_links/PlatformTest.transform_init \
+              test/gtest_links/PlatformTest.transform_rank_data \
+              test/gtest_links/FrequencyPlatformTest.bound \
+              test/gtest_links/FrequencyPlatformTest.enforce_policy_batched \
+              test/gtest_links/FrequencyPlatformTest.enforce_policy_per_package \
+              test/gtest_links/FrequencyPlatformTest.restore_invalidates_last_frequency \
               test/gtest_links/PlatformTopologyTest.cpu_count \
               test/gtest_links/PlatformTopologyTest.negative_num_domain \
               test/gtest_links/CircularBufferTest.buffer_size \
               test/gtest_links/CircularBufferTest.buffer_values \
               test/gtest_links/CircularBufferTest.buffer_capacity \
+              test/gtest_links/CircularBufferTest.buffer_slot \
               test/gtest_links/GlobalPolicyTest.mode_tdp_balance_static \
               test/gtest_links/GlobalPolicyTest.mode_freq_uniform_static \
               test/gtest_links/GlobalPolicyTest.mode_freq_hybrid_static \
@@ -75,7 +84,9 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/GlobalPolicyTestShmem.mode_freq_uniform_dynamic \
               test/gtest_links/GlobalPolicyTestShmem.mode_freq_hybrid_dynamic \
               test/gtest_links/GlobalPolicyTestShmem.plugin_strings \
+              test/gtest_links/GlobalPolicyTestShmem.generation \
               test/gtest_links/GlobalPolicyTest.invalid_policy \
+              test/gtest_links/GlobalPolicyTest.watch \
               test/gtest_links/GlobalPolicyTest.c_interface \
               test/gtest_links/GlobalPolicyTest.negative_c_interface \
               test/gtest_links/ExceptionTest.hello \
@@ -84,12 +95,22 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/LockingHashTableTest.name_set_fill_long \
               test/gtest_links/DeciderFactoryTest.decider_register \
               test/gtest_links/DeciderFactoryTest.no_supported_decider \
+              test/gtest_links/DeciderFactoryTest.plugin_cache \
+              test/gtest_links/QuantileSketchTest.empty \
+              test/gtest_links/QuantileSketchTest.relative_accuracy \
+              test/gtest_links/QuantileSketchTest.zero_and_negative \
+              test/gtest_links/QuantileSketchTest.merge \
+              test/gtest_links/QuantileSketchTest.collapse_lowest \
+              test/gtest_links/QuantileSketchTest.negative_invalid \
               test/gtest_links/RegionTest.identifier \
               test/gtest_links/RegionTest.hint \
+              test/gtest_links/RegionTest.region_id_hint \
               test/gtest_links/RegionTest.sample_message \
               test/gtest_links/RegionTest.signal_last \
               test/gtest_links/RegionTest.signal_num \
               test/gtest_links/RegionTest.signal_derivative \
+              test/gtest_links/RegionTest.signal_integral \
+              test/gtest_links/RegionTest.signal_integral_invalid_entry \
               test/gtest_links/RegionTest.signal_mean \
               test/gtest_links/RegionTest.signal_median \
               test/gtest_links/RegionTest.signal_stddev \
@@ -98,9 +119,13 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/RegionTest.signal_capacity_leaf \
               test/gtest_links/RegionTest.signal_capacity_tree \
               test/gtest_links/RegionTest.signal_invalid_entry \
+              test/gtest_links/RegionTest.signal_stddev_stable \
+              test/gtest_links/RegionTest.signal_median_wrap \
+              test/gtest_links/RegionTest.sample_age \
               test/gtest_links/RegionTest.negative_region_invalid \
               test/gtest_links/RegionTest.negative_signal_invalid \
               test/gtest_links/RegionTest.negative_signal_derivative_tree \
+              test/gtest_links/RegionTest.negative_signal_integral_tree \
               test/gtest_links/SampleRegulatorTest.insert_platform \
               test/gtest_links/SampleRegulatorTest.insert_profile \
               test/gtest_links/SampleRegulatorTest.align_profile \
@@ -124,19 +149,54 @@ GTEST_TESTS = test/gtest_links/PlatformFactoryTest.platform_register \
               test/gtest_links/BalancingDeciderTest.supported \
               test/gtest_links/BalancingDeciderTest.new_policy_message \
               test/gtest_links/BalancingDeciderTest.update_policy \
+              test/gtest_links/BalancingDeciderTest.seed \
+              test/gtest_links/BalancingDeciderTest.mpi_slack \
+              test/gtest_links/BandwidthDeciderTest.name \
+              test/gtest_links/BandwidthDeciderTest.first_sample \
+              test/gtest_links/BandwidthDeciderTest.enter_and_leave \
+              test/gtest_links/BandwidthDeciderTest.region_boundary \
+              test/gtest_links/BandwidthDeciderTest.hysteresis_reset \
+              test/gtest_links/BandwidthDeciderTest.hint_memory \
+              test/gtest_links/FrequencySearchDeciderTest.name \
+              test/gtest_links/FrequencySearchDeciderTest.converge \
+              test/gtest_links/FrequencySearchDeciderTest.region_boundary \
+              test/gtest_links/FrequencySearchDeciderTest.seed \
+              test/gtest_links/FrequencySearchDeciderTest.hint \
+              test/gtest_links/PolicyCacheTest.round_trip \
+              test/gtest_links/PolicyCacheTest.merge \
+              test/gtest_links/PolicyCacheTest.negative_read \
               # end
 
 if ENABLE_MPI
 GTEST_TESTS += test/gtest_links/MPITreeCommunicatorTest.hello \
                test/gtest_links/MPITreeCommunicatorTest.send_policy_down \
+               test/gtest_links/MPITreeCommunicatorTest.send_policy_burst \
                test/gtest_links/MPITreeCommunicatorTest.send_sample_up \
+               test/gtest_links/MPITreeCommunicatorTest.send_sample_stale \
+               test/gtest_links/MPITreeCommunicatorTest.send_sample_region \
+               test/gtest_links/MPITreeCommunicatorRMATest.hello \
+               test/gtest_links/MPITreeCommunicatorRMATest.send_policy_down \
+               test/gtest_links/MPITreeCommunicatorRMATest.send_policy_burst \
+               test/gtest_links/MPITreeCommunicatorRMATest.send_sample_up \
+               test/gtest_links/MPITreeCommunicatorRMATest.send_sample_stale \
+               test/gtest_links/MPITreeCommunicatorRMATest.send_sample_region \
+               test/gtest_links/MPITreeCommunicatorTopologyTest.leaf_group \
+               test/gtest_links/MPITreeCommunicatorTopologyTest.send_sample_up \
+               test/gtest_links/MPITreeCommunicatorTopologyFileTest.leaf_group \
+               test/gtest_links/MPITreeCommunicatorTopologyFileTest.send_sample_up \
+               test/gtest_links/MPITreeCommunicatorTopologyErrorTest.invalid \
+               test/gtest_links/MPICommSplitTest.cached \
                test/gtest_links/MPISharedMemoryTest.hello \
+               test/gtest_links/MPISharedMemoryTest.attach_wait \
+               test/gtest_links/MPISharedMemoryTest.attach_timeout \
                test/gtest_links/MPIProfileTest.runtime \
                test/gtest_links/MPIProfileTest.progress \
                test/gtest_links/MPIProfileTest.multiple_entries \
                test/gtest_links/MPIProfileTest.nested_region \
                test/gtest_links/MPIProfileTest.outer_sync \
                test/gtest_links/MPIProfileTest.noctl \
+               test/gtest_links/MPIProfileTest.noctl_invalid_hint \
+               test/gtest_links/MPIControllerTest.intermittent_region \
                test/gtest_links/MPIControllerDeathTest.shm_clean_up \
                # end
 endif
@@ -147,7 +207,6 @@ TESTS += $(GTEST_TESTS) \
 
 EXTRA_DIST += test/geopm_test.sh \
               test/MPITreeCommunicatorTest.cpp \
-              test/MPIControllerTest.cpp \
               test/no_omp_cpu.c \
               test/default_policy.json \
               test/invalid_policy.json \
@@ -166,10 +225,14 @@ test_geopm_test_SOURCES = test/geopm_test.cpp \
                           test/DeciderFactoryTest.cpp \
                           test/SampleRegulatorTest.cpp \
                           test/RegionTest.cpp \
+                          test/QuantileSketchTest.cpp \
+                          test/PolicyCacheTest.cpp \
                           test/PolicyTest.cpp \
                           plugin/BalancingDecider.cpp \
                           plugin/BalancingDecider.hpp \
                           test/BalancingDeciderTest.cpp \
+                          test/BandwidthDeciderTest.cpp \
+                          test/FrequencySearchDeciderTest.cpp \
                           test/MockPlatform.hpp \
                           test/MockPlatformImp.hpp \
                           test/MockPlatformTopology.hpp \
@@ -178,8 +241,24 @@ test_geopm_test_SOURCES = test/geopm_test.cpp \
 test_geopm_test_LDADD = libgtest.a \
                         libgmock.a \
                         libgeopmpolicy.la \
+                        libgeopmpi_bandwidth_test.la \
+                        libgeopmpi_search_test.la \
                         # end
 
+# Every decider plugin defines geopm_plugin_register(), so the plugins
+# tested alongside BalancingDecider are built with the symbol renamed.
+check_LTLIBRARIES += libgeopmpi_bandwidth_test.la
+libgeopmpi_bandwidth_test_la_SOURCES = plugin/BandwidthDecider.cpp \
+                                       plugin/BandwidthDecider.hpp \
+                                       # end
+libgeopmpi_bandwidth_test_la_CPPFLAGS = $(AM_CPPFLAGS) -Dgeopm_plugin_register=geopm_plugin_register_bandwidth
+
+check_LTLIBRARIES += libgeopmpi_search_test.la
+libgeopmpi_search_test_la_SOURCES = plugin/FrequencySearchDecider.cpp \
+                                    plugin/FrequencySearchDecider.hpp \
+                                    # end
+libgeopmpi_search_test_la_CPPFLAGS = $(AM_CPPFLAGS) -Dgeopm_plugin_register=geopm_plugin_register_search
+
 test_geopm_test_CPPFLAGS = $(AM_CPPFLAGS) -Iplugin
 test_geopm_test_CFLAGS = $(AM_CFLAGS)
 test_geopm_test_CXXFLAGS = $(AM_CXXFLAGS)
@@ -199,6 +278,7 @@ if ENABLE_MPI
                                   test/MPITreeCommunicatorTest.cpp \
                                   test/MPISharedMemoryTest.cpp \
                                   test/MPIProfileTest.cpp \
+                                  test/MPIControllerTest.cpp \
                                   test/MPIControllerDeathTest.cpp \
                                   # end
 
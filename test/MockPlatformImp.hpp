@@ -48,6 +48,10 @@ class MockPlatformImp : public geopm::PlatformImp {
             int(void));
         MOCK_CONST_METHOD0(num_cpu_signal,
             int(void));
+        MOCK_CONST_METHOD0(num_energy_signal,
+            int(void));
+        MOCK_CONST_METHOD0(num_counter_signal,
+            int(void));
         MOCK_CONST_METHOD0(topology,
             geopm::PlatformTopology*(void));
         MOCK_METHOD0(initialize,
@@ -76,6 +80,10 @@ class MockPlatformImp : public geopm::PlatformImp {
             void(std::vector<struct geopm::geopm_signal_descriptor> &signal_desc, bool is_changed));
         MOCK_METHOD4(write_control,
             void(int device_type, int device_index, int signal_type, double value));
+        MOCK_METHOD1(batch_write_control,
+            void(const std::vector<struct geopm::geopm_signal_descriptor> &control_desc));
+        MOCK_METHOD1(num_domain,
+            int(int domain_type));
         MOCK_METHOD3(bound,
             void(int control_type, double &upper_bound, double &lower_bound));
 };
@@ -72,6 +72,7 @@ class TestPlatformImp : public geopm::PlatformImp
 
     protected:
         FRIEND_TEST(PlatformImpTest, parse_topology);
+        FRIEND_TEST(PlatformImpTest, counter_overflow);
         std::vector<std::string> m_msr_file_paths;
 };
 
@@ -864,3 +865,90 @@ TEST_F(PlatformImpTest2, msr_restore_original)
     EXPECT_EQ(value, 0xDEADBEEFBEEFCAFE);
 }
 
+
+TEST_F(PlatformImpTest2, msr_restore_corrupt_file)
+{
+    const char *path = "/tmp/.geopm_msr_save_corrupt_test";
+    struct stat buf;
+    uint64_t value;
+
+    m_platform2->save_msr_state(path);
+    m_platform2->msr_write(geopm::GEOPM_DOMAIN_PACKAGE, 0, "PKG_POWER_LIMIT", 0xDEADBEEFBADDCAFE);
+
+    // Flip a bit in the last saved register value.
+    std::fstream save_file(path, std::ios::in | std::ios::out | std::ios::binary);
+    save_file.seekg(-1, std::ios::end);
+    char last = save_file.get();
+    save_file.seekp(-1, std::ios::end);
+    save_file.put(last ^ 0x1);
+    save_file.close();
+
+    EXPECT_THROW(m_platform2->restore_msr_state(path), geopm::Exception);
+    // A rejected file is left in place and nothing is written.
+    EXPECT_TRUE(stat(path, &buf) == 0);
+    value = m_platform2->msr_read(geopm::GEOPM_DOMAIN_PACKAGE, 0, "PKG_POWER_LIMIT");
+    EXPECT_EQ(value, 0xDEADBEEFBADDCAFE);
+
+    // A text file from an older version is not a valid snapshot.
+    std::ofstream text_file(path);
+    text_file << "0:0:0:16140901064495857663:0" << std::endl;
+    text_file.close();
+    EXPECT_THROW(m_platform2->restore_msr_state(path), geopm::Exception);
+
+    // A truncated file is rejected.
+    m_platform2->save_msr_state(path);
+    EXPECT_EQ(0, truncate(path, buf.st_size - 8));
+    EXPECT_THROW(m_platform2->restore_msr_state(path), geopm::Exception);
+
+    // A corrupt record count is rejected before anything is sized
+    // by it.  The header is magic, version, num_package, num_hw_cpu,
+    // num_record and checksum.
+    const std::streamoff num_record_offset = 4 * sizeof(uint64_t);
+    m_platform2->save_msr_state(path);
+    save_file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    uint64_t bad_count = ~0ULL;
+    save_file.seekp(num_record_offset);
+    save_file.write((const char *)&bad_count, sizeof(bad_count));
+    save_file.close();
+    EXPECT_THROW(m_platform2->restore_msr_state(path), geopm::Exception);
+    remove(path);
+}
+
+TEST_F(PlatformImpTest, counter_overflow)
+{
+    const uint64_t mask_32 = 0xffffffffULL;
+    const uint64_t mask_44 = 0xfffffffffffULL;
+    // Batch slots 0 and 1 are counters, slot 2 is not; signals 2
+    // and 3 mirror slots 0 and 1 through the scalar path.
+    m_platform->m_msr_value_last.assign(4, 0);
+    m_platform->m_msr_overflow_offset.assign(4, 0);
+    m_platform->m_batch.numops = 3;
+    m_platform->m_batch.ops = (struct geopm::PlatformImp::m_msr_batch_op *)calloc(3, sizeof(struct geopm::PlatformImp::m_msr_batch_op));
+    m_platform->m_batch_overflow_idx = {0, 1, -1};
+    m_platform->m_batch_counter_mask = {mask_32, mask_44, ~0ULL};
+    m_platform->m_batch_value.resize(3);
+
+    std::vector<std::vector<uint64_t> > raw = {
+        {0xAB000000FFFFFFF0ULL, 0xFFFFFFFFFF0ULL, 0x1234},
+        {0xAB00000000000010ULL, 0x00000000010ULL, 0x1235},
+        {0x0000000000000020ULL, 0x00000000020ULL, 0x1236},
+        {0x0000000000000010ULL, 0x00000000010ULL, 0x1237},
+    };
+    std::vector<std::vector<uint64_t> > expect = {
+        {0xFFFFFFF0ULL, 0xFFFFFFFFFF0ULL, 0x1234},
+        {0x100000010ULL, 0x100000000010ULL, 0x1235},
+        {0x100000020ULL, 0x100000000020ULL, 0x1236},
+        {0x200000010ULL, 0x200000000010ULL, 0x1237},
+    };
+    for (size_t i = 0; i < raw.size(); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            m_platform->m_batch.ops[j].msrdata = raw[i][j];
+        }
+        m_platform->batch_msr_overflow();
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ(expect[i][j], m_platform->m_batch_value[j]);
+        }
+        EXPECT_DOUBLE_EQ((double)expect[i][0], m_platform->msr_overflow(2, 32, raw[i][0]));
+        EXPECT_DOUBLE_EQ((double)expect[i][1], m_platform->msr_overflow(3, 44, raw[i][1]));
+    }
+}
@@ -37,11 +37,11 @@
 #include "geopm_error.h"
 #include "Exception.hpp"
 #include "RAPLPlatform.hpp"
+#include "FrequencyPlatform.hpp"
+#include "Policy.hpp"
 #include "MockPlatformImp.hpp"
-#include "MockPlatformTopology.hpp"
 
 using ::testing::Return;
-using ::testing::Pointee;
 using ::testing::_;
 using ::testing::SetArgReferee;
 
@@ -52,11 +52,6 @@ class PlatformTest: public :: testing :: Test
         void TearDown();
         geopm::Platform *platform;
         MockPlatformImp *platformimp;
-        MockPlatformTopology *topo;
-        std::vector<hwloc_obj_t> package;
-        std::vector<hwloc_obj_t> package1_cpu;
-        std::vector<hwloc_obj_t> package2_cpu;
-
 };
 
 void PlatformTest::SetUp()
@@ -64,7 +59,6 @@ void PlatformTest::SetUp()
 
     platform = new geopm::RAPLPlatform();
     platformimp = new MockPlatformImp();
-    topo = new MockPlatformTopology();
 
     EXPECT_CALL(*platformimp, initialize());
 
@@ -83,83 +77,233 @@ void PlatformTest::SetUp()
     EXPECT_CALL(*platformimp, num_cpu_signal())
     .WillRepeatedly(testing::Return(5));
 
+    EXPECT_CALL(*platformimp, num_tile())
+    .WillRepeatedly(Return(4));
+
+    EXPECT_CALL(*platformimp, power_control_domain())
+    .WillRepeatedly(Return(geopm::GEOPM_DOMAIN_PACKAGE));
+
+    EXPECT_CALL(*platformimp, performance_counter_domain())
+    .WillRepeatedly(Return(geopm::GEOPM_DOMAIN_CPU));
+
+    EXPECT_CALL(*platformimp, num_domain(geopm::GEOPM_DOMAIN_PACKAGE))
+    .WillRepeatedly(Return(2));
+
+    EXPECT_CALL(*platformimp, num_domain(geopm::GEOPM_DOMAIN_CPU))
+    .WillRepeatedly(Return(8));
+
+    EXPECT_CALL(*platformimp, num_energy_signal())
+    .WillRepeatedly(Return(2));
+
+    EXPECT_CALL(*platformimp, num_counter_signal())
+    .WillRepeatedly(Return(5));
+
+    EXPECT_CALL(*platformimp, batch_read_signal(_, true));
+
     platform->set_implementation((geopm::PlatformImp*)platformimp);
-    hwloc_obj_t obj;
-
-    for (int i = 0; i < 2; i++) {
-        obj = (hwloc_obj_t)malloc(sizeof(struct hwloc_obj));
-        obj->type = (hwloc_obj_type_t)(geopm::GEOPM_DOMAIN_PACKAGE);
-        obj->os_index = i;
-        obj->logical_index = i;
-        package.push_back(obj);
-    }
-    for (int i = 0; i < 4; i++) {
-        obj = (hwloc_obj_t)malloc(sizeof(struct hwloc_obj));
-        obj->type = (hwloc_obj_type_t)(geopm::GEOPM_DOMAIN_CPU);
-        obj->os_index = i;
-        obj->logical_index = i;
-        package1_cpu.push_back(obj);
-    }
-    for (int i = 4; i < 8; i++) {
-        obj = (hwloc_obj_t)malloc(sizeof(struct hwloc_obj));
-        obj->type = (hwloc_obj_type_t)(geopm::GEOPM_DOMAIN_CPU);
-        obj->os_index = i;
-        obj->logical_index = i;
-        package2_cpu.push_back(obj);
-    }
 }
 
 void PlatformTest::TearDown()
 {
-    delete topo;
-    delete platformimp;
     delete platform;
+    delete platformimp;
 }
 
-MATCHER_P(Socket, x, "") {
-    return (arg->logical_index == (unsigned)x);
+TEST_F(PlatformTest, transform_init)
+{
+    const int num_platform_signal = 7;
+    std::vector<double> aligned_data(2 * num_platform_signal + 2 * 2);
+    std::vector<struct geopm_telemetry_message_s> telemetry(2);
+
+    // Transforming before the rank layout is known is an error
+    EXPECT_THROW(platform->transform_rank_data(42, {{0, 0}}, aligned_data, telemetry), geopm::Exception);
+
+    // Two ranks, one per package
+    platform->init_transform(std::vector<int>({0, 0, 0, 0, 1, 1, 1, 1}));
+    aligned_data[2 * num_platform_signal] = 0.5;
+    aligned_data[2 * num_platform_signal + 1] = 2.0;
+    aligned_data[2 * num_platform_signal + 2] = 0.25;
+    aligned_data[2 * num_platform_signal + 3] = 3.0;
+    platform->transform_rank_data(42, {{0, 0}}, aligned_data, telemetry);
+    EXPECT_DOUBLE_EQ(0.5, telemetry[0].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(2.0, telemetry[0].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+    EXPECT_DOUBLE_EQ(0.25, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(3.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+
+    // More ranks in the data than in the layout is an error
+    aligned_data.resize(2 * num_platform_signal + 3 * 2);
+    EXPECT_THROW(platform->transform_rank_data(42, {{0, 0}}, aligned_data, telemetry), geopm::Exception);
 }
 
-TEST_F(PlatformTest, transform_init)
+TEST_F(PlatformTest, transform_rank_data)
 {
-    std::vector<int> cpu_ranks({0, 0, 1, 1, 2, 2, 3, 3});
-    std::vector<double> result(2 * GEOPM_NUM_TELEMETRY_TYPE);
-    std::vector<double> expect({1, 1, 1, 4, 4, 4, 4, 4, 2, 2, 1, 1, 1, 4, 4, 4, 4, 4, 2, 2});
+    const int num_platform_signal = 7;
+    const int rank_offset = 2 * num_platform_signal;
+    std::vector<double> aligned_data(rank_offset + 3 * 2);
+    std::vector<struct geopm_telemetry_message_s> telemetry(2);
+    struct geopm_time_s time = {{1, 0}};
+
+    // Rank 1 runs on CPUs of both packages
+    platform->init_transform(std::vector<int>({0, 0, 1, 1, 1, 2, 2, 2}));
+    for (int i = 0; i < rank_offset; ++i) {
+        aligned_data[i] = i + 1;
+    }
+    // Progress and runtime of each rank
+    std::vector<double> rank_data({0.5, 2.0,
+                                   0.25, 3.0,
+                                   1.0, 5.0});
+    std::copy(rank_data.begin(), rank_data.end(), aligned_data.begin() + rank_offset);
+    platform->transform_rank_data(42, time, aligned_data, telemetry);
+    for (int domain_idx = 0; domain_idx < 2; ++domain_idx) {
+        EXPECT_EQ(42ULL, telemetry[domain_idx].region_id);
+        EXPECT_EQ(1, telemetry[domain_idx].timestamp.t.tv_sec);
+        for (int signal_idx = 0; signal_idx < num_platform_signal; ++signal_idx) {
+            EXPECT_DOUBLE_EQ(domain_idx * num_platform_signal + signal_idx + 1,
+                             telemetry[domain_idx].signal[signal_idx]);
+        }
+    }
+    // Package progress is the least progress of its ranks
+    EXPECT_DOUBLE_EQ(0.25, telemetry[0].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(3.0, telemetry[0].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+    // Unless one has exited the region
+    EXPECT_DOUBLE_EQ(1.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(5.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+
+    // Ranks with an invalid runtime are ignored
+    aligned_data[rank_offset + 5] = -1.0;
+    platform->transform_rank_data(42, time, aligned_data, telemetry);
+    EXPECT_DOUBLE_EQ(0.25, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(3.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+
+    // A package without any valid rank reports an invalid runtime
+    platform->init_transform(std::vector<int>({0, 0, 0, 0, 1, 1, 1, 1}));
+    aligned_data.resize(rank_offset + 2 * 2);
+    aligned_data[rank_offset + 3] = -1.0;
+    platform->transform_rank_data(42, time, aligned_data, telemetry);
+    EXPECT_DOUBLE_EQ(0.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_PROGRESS]);
+    EXPECT_DOUBLE_EQ(-1.0, telemetry[1].signal[GEOPM_TELEMETRY_TYPE_RUNTIME]);
+}
 
-    EXPECT_EQ(expect.size(), result.size());
+class FrequencyPlatformTest: public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        geopm::Platform *platform;
+        MockPlatformImp *platformimp;
+};
 
-    EXPECT_CALL(*platformimp, topology())
-    .WillOnce(testing::Return(topo));
+void FrequencyPlatformTest::SetUp()
+{
+    platform = new geopm::FrequencyPlatform();
+    platformimp = new MockPlatformImp();
 
+    EXPECT_CALL(*platformimp, initialize());
+    EXPECT_CALL(*platformimp, num_hw_cpu())
+    .WillRepeatedly(Return(8));
+    EXPECT_CALL(*platformimp, num_package())
+    .WillRepeatedly(Return(2));
+    EXPECT_CALL(*platformimp, num_tile())
+    .WillRepeatedly(Return(4));
     EXPECT_CALL(*platformimp, power_control_domain())
-    .WillOnce(Return(geopm::GEOPM_DOMAIN_PACKAGE));
+    .WillRepeatedly(Return(geopm::GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(*platformimp, performance_counter_domain())
+    .WillRepeatedly(Return(geopm::GEOPM_DOMAIN_CPU));
+    EXPECT_CALL(*platformimp, frequency_control_domain())
+    .WillRepeatedly(Return(geopm::GEOPM_DOMAIN_TILE));
+    EXPECT_CALL(*platformimp, num_domain(geopm::GEOPM_DOMAIN_PACKAGE))
+    .WillRepeatedly(Return(2));
+    EXPECT_CALL(*platformimp, num_domain(geopm::GEOPM_DOMAIN_CPU))
+    .WillRepeatedly(Return(8));
+    EXPECT_CALL(*platformimp, num_domain(geopm::GEOPM_DOMAIN_TILE))
+    .WillRepeatedly(Return(4));
+    EXPECT_CALL(*platformimp, num_energy_signal())
+    .WillRepeatedly(Return(2));
+    EXPECT_CALL(*platformimp, num_counter_signal())
+    .WillRepeatedly(Return(5));
+    EXPECT_CALL(*platformimp, batch_read_signal(_, true));
+    EXPECT_CALL(*platformimp, bound(GEOPM_TELEMETRY_TYPE_FREQUENCY, _, _))
+    .WillOnce(testing::DoAll(SetArgReferee<1>(2.3), SetArgReferee<2>(1.2)));
+
+    platform->set_implementation((geopm::PlatformImp*)platformimp);
+}
+
+void FrequencyPlatformTest::TearDown()
+{
+    delete platform;
+    delete platformimp;
+}
+
+MATCHER_P(ControlCount, x, "") {
+    return (arg.size() == (size_t)x);
+}
+
+TEST_F(FrequencyPlatformTest, bound)
+{
+    double upper = 0.0;
+    double lower = 0.0;
+    EXPECT_EQ(GEOPM_CONTROL_DOMAIN_FREQUENCY, platform->control_domain());
+    platform->bound(upper, lower);
+    EXPECT_DOUBLE_EQ(2.3, upper);
+    EXPECT_DOUBLE_EQ(1.2, lower);
+}
 
-    EXPECT_CALL(*topo, num_domain(_))
-    .WillOnce(Return(2));
+TEST_F(FrequencyPlatformTest, enforce_policy_batched)
+{
+    std::vector<struct geopm::geopm_signal_descriptor> written;
+    geopm::Policy policy(4);
+    policy.update(GEOPM_REGION_ID_OUTER, std::vector<double>({1.0, 1.8, 1.8, 3.0}));
 
-    EXPECT_CALL(*topo, domain_by_type(_,_))
-    .WillRepeatedly(SetArgReferee<1>(package));
+    // First write covers every tile in one batch with clamped values
+    EXPECT_CALL(*platformimp, batch_write_control(ControlCount(4)))
+    .WillOnce(testing::SaveArg<0>(&written));
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+    ASSERT_EQ(4u, written.size());
+    EXPECT_EQ(geopm::GEOPM_DOMAIN_TILE, written[0].device_type);
+    EXPECT_DOUBLE_EQ(1.2, written[0].value);
+    EXPECT_DOUBLE_EQ(1.8, written[1].value);
+    EXPECT_DOUBLE_EQ(2.3, written[3].value);
 
-    EXPECT_CALL(*topo, children_by_type(_,Socket(0),_))
-    .WillRepeatedly(SetArgReferee<2>(package1_cpu));
+    // Unchanged targets result in no writes
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
 
-    EXPECT_CALL(*topo, children_by_type(_,Socket(1),_))
-    .WillRepeatedly(SetArgReferee<2>(package2_cpu));
+    // Only the changed tile is written
+    policy.update(GEOPM_REGION_ID_OUTER, 2, 2.0);
+    EXPECT_CALL(*platformimp, batch_write_control(ControlCount(1)))
+    .WillOnce(testing::SaveArg<0>(&written));
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+    ASSERT_EQ(1u, written.size());
+    EXPECT_EQ(2, written[0].device_index);
+    EXPECT_DOUBLE_EQ(2.0, written[0].value);
+}
 
-    platform->init_transform(cpu_ranks);
+TEST_F(FrequencyPlatformTest, restore_invalidates_last_frequency)
+{
+    geopm::Policy policy(4);
+    policy.update(GEOPM_REGION_ID_OUTER, std::vector<double>({1.5, 1.5, 2.0, 2.0}));
 
-#if 0 // This needs to be changed to match new code
-    const std::vector<double> *transform = platform->signal_domain_transform();
+    EXPECT_CALL(*platformimp, batch_write_control(ControlCount(4)))
+    .Times(2);
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+    // A restore may change IA32_PERF_CTL even if it fails part way,
+    // so the same targets are written again afterwards.
+    EXPECT_THROW(platform->restore_msr_state("/tmp/.geopm_frequency_platform_test_missing"), geopm::Exception);
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+}
 
-    for (unsigned i = 0; i < 2 * GEOPM_NUM_TELEMETRY_TYPE; ++i) {
-        result[i] = 0.0;
-        for (unsigned j = 0; j < (platform->capacity() + (4 * 2)); ++j) {
-            result[i] += (*transform)[i * (platform->capacity() + (4 * 2)) +j];
-        }
-    }
+TEST_F(FrequencyPlatformTest, enforce_policy_per_package)
+{
+    std::vector<struct geopm::geopm_signal_descriptor> written;
+    geopm::Policy policy(2);
+    policy.update(GEOPM_REGION_ID_OUTER, std::vector<double>({1.5, 2.0}));
 
-    for (unsigned i = 0; i < 2 * GEOPM_NUM_TELEMETRY_TYPE; ++i) {
-        EXPECT_DOUBLE_EQ(expect[i], result[i]);
-    }
-#endif
+    EXPECT_CALL(*platformimp, batch_write_control(ControlCount(4)))
+    .WillOnce(testing::SaveArg<0>(&written));
+    platform->enforce_policy(GEOPM_REGION_ID_OUTER, policy);
+    ASSERT_EQ(4u, written.size());
+    EXPECT_DOUBLE_EQ(1.5, written[0].value);
+    EXPECT_DOUBLE_EQ(1.5, written[1].value);
+    EXPECT_DOUBLE_EQ(2.0, written[2].value);
+    EXPECT_DOUBLE_EQ(2.0, written[3].value);
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_message.h"
+#include "Exception.hpp"
+#include "Policy.hpp"
+#include "PolicyCache.hpp"
+
+class PolicyCacheTest: public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        geopm::Policy *m_policy;
+        const int m_num_domain = 4;
+        const int m_num_node = 8;
+        const uint64_t m_profile_key = 0x1234abcd;
+        const std::string m_path = "PolicyCacheTest.cache";
+};
+
+void PolicyCacheTest::SetUp()
+{
+    m_policy = new geopm::Policy(m_num_domain);
+
+    std::vector<double> target(m_num_domain);
+    std::fill(target.begin(), target.end(), 25.0);
+    m_policy->update(GEOPM_REGION_ID_OUTER, target);
+    target[0] = 20.0;
+    target[1] = 30.0;
+    m_policy->update((uint64_t)42, target);
+    m_policy->is_converged((uint64_t)42, true);
+    // Not converged but saved as a warm start
+    m_policy->update((uint64_t)13, target);
+    (void)unlink(m_path.c_str());
+}
+
+void PolicyCacheTest::TearDown()
+{
+    delete m_policy;
+    (void)unlink(m_path.c_str());
+}
+
+TEST_F(PolicyCacheTest, round_trip)
+{
+    geopm::PolicyCache cache(m_profile_key, m_num_node);
+    cache.insert(3, 0, *m_policy);
+    EXPECT_EQ((size_t)3, cache.size());
+    cache.write(m_path);
+
+    // Different tree size is ignored
+    geopm::PolicyCache other_cache(m_profile_key, m_num_node + 1);
+    other_cache.read(m_path);
+    EXPECT_EQ((size_t)0, other_cache.size());
+
+    geopm::PolicyCache read_cache(m_profile_key, m_num_node);
+    read_cache.read(m_path);
+    EXPECT_EQ((size_t)3, read_cache.size());
+
+    geopm::Policy policy(m_num_domain);
+    std::vector<double> target(m_num_domain);
+    bool is_converged = false;
+    read_cache.seed(2, 0, policy);
+    EXPECT_FALSE(policy.seed_target(42, 100.0, target, is_converged));
+    read_cache.seed(3, 0, policy);
+    ASSERT_TRUE(policy.seed_target(42, 200.0, target, is_converged));
+    EXPECT_TRUE(is_converged);
+    EXPECT_DOUBLE_EQ(40.0, target[0]);
+    EXPECT_DOUBLE_EQ(60.0, target[1]);
+    EXPECT_DOUBLE_EQ(50.0, target[2]);
+    EXPECT_DOUBLE_EQ(50.0, target[3]);
+    ASSERT_TRUE(policy.seed_target(13, 100.0, target, is_converged));
+    EXPECT_FALSE(is_converged);
+    EXPECT_DOUBLE_EQ(20.0, target[0]);
+    EXPECT_DOUBLE_EQ(30.0, target[1]);
+}
+
+TEST_F(PolicyCacheTest, merge)
+{
+    std::ofstream cache_file(m_path);
+    cache_file << "# comment\n"
+               << "ffff 8 0 0 42 100 1 25 25 25 25\n"
+               << "1234abcd 8 5 0 2a 100 1 10 30 30 30\n";
+    cache_file.close();
+
+    geopm::PolicyCache cache(m_profile_key, m_num_node);
+    cache.read(m_path);
+    EXPECT_EQ((size_t)1, cache.size());
+    cache.insert(3, 0, *m_policy);
+    cache.write(m_path);
+
+    std::ifstream result_file(m_path);
+    std::string result((std::istreambuf_iterator<char>(result_file)), std::istreambuf_iterator<char>());
+    // Lines for other applications are kept
+    EXPECT_NE(std::string::npos, result.find("# comment\n"));
+    EXPECT_NE(std::string::npos, result.find("ffff 8 0 0 42 100 1 25 25 25 25\n"));
+
+    geopm::PolicyCache read_cache(m_profile_key, m_num_node);
+    read_cache.read(m_path);
+    EXPECT_EQ((size_t)4, read_cache.size());
+}
+
+TEST_F(PolicyCacheTest, negative_read)
+{
+    geopm::PolicyCache cache(m_profile_key, m_num_node);
+    // Missing file is an empty cache
+    cache.read(m_path);
+    EXPECT_EQ((size_t)0, cache.size());
+
+    std::istringstream bad_node("1234abcd 8 8 0 2a 100 1 10 30 30 30\n");
+    EXPECT_THROW(cache.read(bad_node), geopm::Exception);
+    std::istringstream bad_converged("1234abcd 8 0 0 2a 100 2 10 30 30 30\n");
+    EXPECT_THROW(cache.read(bad_converged), geopm::Exception);
+    std::istringstream bad_target("1234abcd 8 0 0 2a 100 1 10 x 30 30\n");
+    EXPECT_THROW(cache.read(bad_target), geopm::Exception);
+    std::istringstream no_target("1234abcd 8 0 0 2a 100 1\n");
+    EXPECT_THROW(cache.read(no_target), geopm::Exception);
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, 2016, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "Exception.hpp"
+#include "QuantileSketch.hpp"
+
+class QuantileSketchTest: public :: testing :: Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        geopm::QuantileSketch *m_sketch;
+};
+
+void QuantileSketchTest::SetUp()
+{
+    m_sketch = new geopm::QuantileSketch(0.02, 256);
+    for (int i = 1; i <= 1000; ++i) {
+        m_sketch->insert((double)i);
+    }
+}
+
+void QuantileSketchTest::TearDown()
+{
+    delete m_sketch;
+}
+
+TEST_F(QuantileSketchTest, empty)
+{
+    geopm::QuantileSketch sketch(0.02, 256);
+    EXPECT_EQ(0ULL, sketch.count());
+    EXPECT_TRUE(isnan(sketch.quantile(0.5)));
+    m_sketch->clear();
+    EXPECT_EQ(0ULL, m_sketch->count());
+    EXPECT_TRUE(isnan(m_sketch->quantile(0.5)));
+}
+
+TEST_F(QuantileSketchTest, relative_accuracy)
+{
+    EXPECT_EQ(1000ULL, m_sketch->count());
+    EXPECT_NEAR(500.0, m_sketch->quantile(0.5), 500.0 * 0.02);
+    EXPECT_NEAR(900.0, m_sketch->quantile(0.9), 900.0 * 0.02);
+    EXPECT_NEAR(990.0, m_sketch->quantile(0.99), 990.0 * 0.02);
+    // The extremes are bounded by the exact min and max
+    EXPECT_DOUBLE_EQ(1.0, m_sketch->quantile(0.0));
+    EXPECT_DOUBLE_EQ(1000.0, m_sketch->quantile(1.0));
+}
+
+TEST_F(QuantileSketchTest, zero_and_negative)
+{
+    geopm::QuantileSketch sketch(0.02, 256);
+    sketch.insert(0.0);
+    sketch.insert(-1.0);
+    sketch.insert(NAN);
+    sketch.insert(4.0);
+    EXPECT_EQ(3ULL, sketch.count());
+    EXPECT_DOUBLE_EQ(-1.0, sketch.quantile(0.0));
+    EXPECT_DOUBLE_EQ(0.0, sketch.quantile(0.5));
+    EXPECT_NEAR(4.0, sketch.quantile(1.0), 4.0 * 0.02);
+}
+
+TEST_F(QuantileSketchTest, merge)
+{
+    geopm::QuantileSketch lower(0.02, 256);
+    geopm::QuantileSketch upper(0.02, 256);
+    for (int i = 1; i <= 1000; ++i) {
+        if (i <= 500) {
+            lower.insert((double)i);
+        }
+        else {
+            upper.insert((double)i);
+        }
+    }
+    lower.merge(upper);
+    EXPECT_EQ(m_sketch->count(), lower.count());
+    EXPECT_DOUBLE_EQ(m_sketch->quantile(0.5), lower.quantile(0.5));
+    EXPECT_DOUBLE_EQ(m_sketch->quantile(0.9), lower.quantile(0.9));
+    EXPECT_DOUBLE_EQ(m_sketch->quantile(0.99), lower.quantile(0.99));
+}
+
+TEST_F(QuantileSketchTest, collapse_lowest)
+{
+    // Four buckets cannot hold values that span six orders of
+    // magnitude, the low values collapse and the top stays accurate
+    geopm::QuantileSketch sketch(0.02, 4);
+    for (int i = 0; i < 99; ++i) {
+        sketch.insert(1.0e-3 * (i + 1));
+    }
+    sketch.insert(1.0e3);
+    EXPECT_EQ(100ULL, sketch.count());
+    EXPECT_DOUBLE_EQ(1.0e3, sketch.quantile(1.0));
+    EXPECT_LT(sketch.quantile(0.5), 1.0e3);
+}
+
+TEST_F(QuantileSketchTest, negative_invalid)
+{
+    int thrown = 0;
+    try {
+        geopm::QuantileSketch sketch(0.0, 256);
+    }
+    catch (geopm::Exception e) {
+        thrown = e.err_value();
+    }
+    EXPECT_EQ(GEOPM_ERROR_INVALID, thrown);
+
+    thrown = 0;
+    try {
+        m_sketch->quantile(1.5);
+    }
+    catch (geopm::Exception e) {
+        thrown = e.err_value();
+    }
+    EXPECT_EQ(GEOPM_ERROR_INVALID, thrown);
+
+    thrown = 0;
+    try {
+        geopm::QuantileSketch sketch(0.01, 256);
+        m_sketch->merge(sketch);
+    }
+    catch (geopm::Exception e) {
+        thrown = e.err_value();
+    }
+    EXPECT_EQ(GEOPM_ERROR_INVALID, thrown);
+}
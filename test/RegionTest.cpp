@@ -31,9 +31,13 @@
  */
 
 #include <iostream>
+#include <algorithm>
+#include <math.h>
 
 #include "gtest/gtest.h"
 #include "geopm_error.h"
+#include "geopm_message.h"
+#include "geopm_hash.h"
 #include "Exception.hpp"
 #include "Region.hpp"
 
@@ -100,12 +104,27 @@ TEST_F(RegionTest, hint)
     EXPECT_EQ(GEOPM_POLICY_HINT_COMPUTE, m_tree_region->hint());
 }
 
+TEST_F(RegionTest, region_id_hint)
+{
+    uint64_t region_id = geopm_crc32_str(0, "loop_one");
+    uint64_t hint_id = geopm_region_id_set_hint(GEOPM_POLICY_HINT_MEMORY, region_id);
+    EXPECT_NE(region_id, hint_id);
+    EXPECT_EQ(GEOPM_POLICY_HINT_UNKNOWN, geopm_region_id_hint(region_id));
+    EXPECT_EQ(GEOPM_POLICY_HINT_MEMORY, geopm_region_id_hint(hint_id));
+    EXPECT_EQ(region_id, geopm_region_id_set_hint(GEOPM_POLICY_HINT_UNKNOWN, hint_id));
+    // The mpi-sync and outer-sync ids do not carry a hint
+    EXPECT_EQ((uint64_t)GEOPM_REGION_ID_MPI, geopm_region_id_set_hint(GEOPM_POLICY_HINT_COMPUTE, GEOPM_REGION_ID_MPI));
+    EXPECT_EQ(GEOPM_POLICY_HINT_UNKNOWN, geopm_region_id_hint(GEOPM_REGION_ID_OUTER));
+}
+
 TEST_F(RegionTest, sample_message)
 {
     struct geopm_sample_message_s sample;
     std::vector<struct geopm_telemetry_message_s> telemetry(2);
     telemetry[0].region_id = 42;
     telemetry[1].region_id = 42;
+    EXPECT_EQ((uint64_t)0, m_leaf_region->num_complete());
+    EXPECT_EQ((uint64_t)7, m_tree_region->num_complete());
     // Add an entry from a new region
     m_time.t.tv_sec += 2;
     telemetry[0].timestamp = m_time;
@@ -121,6 +140,7 @@ TEST_F(RegionTest, sample_message)
         }
     }
     m_leaf_region->insert(telemetry);
+    EXPECT_EQ((uint64_t)1, m_leaf_region->num_complete());
 
     m_leaf_region->sample_message(sample);
     EXPECT_EQ((uint64_t)42, sample.region_id);
@@ -133,6 +153,8 @@ TEST_F(RegionTest, sample_message)
     EXPECT_DOUBLE_EQ(13.0, sample.signal[GEOPM_SAMPLE_TYPE_RUNTIME]);
     EXPECT_DOUBLE_EQ(76.0, sample.signal[GEOPM_SAMPLE_TYPE_ENERGY]);
     EXPECT_DOUBLE_EQ(76.0, sample.signal[GEOPM_SAMPLE_TYPE_FREQUENCY_NUMER]);
+    // The least MPI wait is on the critical path
+    EXPECT_DOUBLE_EQ(6.0, sample.signal[GEOPM_SAMPLE_TYPE_MPI_RUNTIME]);
 }
 
 TEST_F(RegionTest, signal_last)
@@ -159,6 +181,81 @@ TEST_F(RegionTest, signal_derivative)
     EXPECT_DOUBLE_EQ(0.5, m_leaf_region->derivative(1, GEOPM_TELEMETRY_TYPE_RUNTIME));
 }
 
+TEST_F(RegionTest, signal_integral)
+{
+    double delta_time, integral;
+    EXPECT_DOUBLE_EQ(3.0, m_leaf_region->integral(0, GEOPM_TELEMETRY_TYPE_RUNTIME, delta_time, integral));
+    EXPECT_DOUBLE_EQ(12.0, delta_time);
+    EXPECT_DOUBLE_EQ(36.0, integral);
+    EXPECT_DOUBLE_EQ(8.0, m_leaf_region->integral(1, GEOPM_TELEMETRY_TYPE_RUNTIME, delta_time, integral));
+    EXPECT_DOUBLE_EQ(12.0, delta_time);
+    EXPECT_DOUBLE_EQ(96.0, integral);
+
+    // Exit the region, the interval ends at the exit sample
+    std::vector<struct geopm_telemetry_message_s> telemetry(2);
+    for (int i = 0; i < 2; ++i) {
+        telemetry[i].region_id = 42;
+        telemetry[i].timestamp = m_time;
+        telemetry[i].timestamp.t.tv_sec += 2;
+        for (int j = 0; j < GEOPM_NUM_TELEMETRY_TYPE; ++j) {
+            telemetry[i].signal[j] = 7.0 + 5.0 * i;
+        }
+        telemetry[i].signal[GEOPM_TELEMETRY_TYPE_PROGRESS] = 1.0;
+    }
+    m_leaf_region->insert(telemetry);
+    EXPECT_DOUBLE_EQ(3.5, m_leaf_region->integral(0, GEOPM_TELEMETRY_TYPE_RUNTIME, delta_time, integral));
+    EXPECT_DOUBLE_EQ(14.0, delta_time);
+    EXPECT_DOUBLE_EQ(49.0, integral);
+
+    // Samples outside of the region do not extend the interval
+    telemetry[0].timestamp.t.tv_sec += 2;
+    telemetry[1].timestamp.t.tv_sec += 2;
+    m_leaf_region->insert(telemetry);
+    EXPECT_DOUBLE_EQ(8.5, m_leaf_region->integral(1, GEOPM_TELEMETRY_TYPE_RUNTIME, delta_time, integral));
+    EXPECT_DOUBLE_EQ(14.0, delta_time);
+    EXPECT_DOUBLE_EQ(119.0, integral);
+}
+
+TEST_F(RegionTest, signal_integral_invalid_entry)
+{
+    double delta_time, integral;
+    std::vector<struct geopm_telemetry_message_s> telemetry(2);
+    for (int i = 0; i < 2; ++i) {
+        telemetry[i].region_id = 42;
+        telemetry[i].timestamp = m_time;
+    }
+    // Exit the region and stay outside for one sample
+    for (int step = 0; step < 2; ++step) {
+        for (int i = 0; i < 2; ++i) {
+            telemetry[i].timestamp.t.tv_sec += 2;
+            for (int j = 0; j < GEOPM_NUM_TELEMETRY_TYPE; ++j) {
+                telemetry[i].signal[j] = 7.0;
+            }
+            telemetry[i].signal[GEOPM_TELEMETRY_TYPE_PROGRESS] = 1.0;
+        }
+        m_leaf_region->insert(telemetry);
+    }
+    // Re-enter with an invalid runtime on the first sample, the
+    // interval must not start at the last time of the previous visit
+    double runtime[3] = {-1.0, 20.0, 22.0};
+    double progress[3] = {0.0, 0.0, 0.5};
+    for (int step = 0; step < 3; ++step) {
+        for (int i = 0; i < 2; ++i) {
+            telemetry[i].timestamp.t.tv_sec += 2;
+            for (int j = 0; j < GEOPM_NUM_TELEMETRY_TYPE; ++j) {
+                telemetry[i].signal[j] = runtime[step];
+            }
+            telemetry[i].signal[GEOPM_TELEMETRY_TYPE_PROGRESS] = progress[step];
+        }
+        m_leaf_region->insert(telemetry);
+    }
+    EXPECT_DOUBLE_EQ(21.0, m_leaf_region->integral(0, GEOPM_TELEMETRY_TYPE_RUNTIME, delta_time, integral));
+    EXPECT_DOUBLE_EQ(2.0, delta_time);
+    EXPECT_DOUBLE_EQ(42.0, integral);
+    EXPECT_DOUBLE_EQ(21.0, m_leaf_region->integral(1, GEOPM_TELEMETRY_TYPE_PKG_ENERGY, delta_time, integral));
+    EXPECT_DOUBLE_EQ(2.0, delta_time);
+}
+
 TEST_F(RegionTest, signal_mean)
 {
     EXPECT_DOUBLE_EQ(3.0, m_leaf_region->mean(0, GEOPM_TELEMETRY_TYPE_RUNTIME));
@@ -295,7 +392,7 @@ TEST_F(RegionTest, signal_invalid_entry)
     EXPECT_DOUBLE_EQ(4.0, m_leaf_region->median(0, GEOPM_TELEMETRY_TYPE_RUNTIME));
     EXPECT_DOUBLE_EQ(9.0, m_leaf_region->median(1, GEOPM_TELEMETRY_TYPE_RUNTIME));
     EXPECT_DOUBLE_EQ(1.707825127659933, m_leaf_region->std_deviation(0, GEOPM_TELEMETRY_TYPE_RUNTIME));
-    EXPECT_DOUBLE_EQ(1.7078251276599345, m_leaf_region->std_deviation(1, GEOPM_TELEMETRY_TYPE_RUNTIME));
+    EXPECT_DOUBLE_EQ(1.707825127659933, m_leaf_region->std_deviation(1, GEOPM_TELEMETRY_TYPE_RUNTIME));
     EXPECT_DOUBLE_EQ(1.0, m_leaf_region->min(0, GEOPM_TELEMETRY_TYPE_RUNTIME));
     EXPECT_DOUBLE_EQ(6.0, m_leaf_region->min(1, GEOPM_TELEMETRY_TYPE_RUNTIME));
     EXPECT_DOUBLE_EQ(6.0, m_leaf_region->max(0, GEOPM_TELEMETRY_TYPE_RUNTIME));
@@ -332,6 +429,125 @@ TEST_F(RegionTest, signal_invalid_entry)
 
 }
 
+TEST_F(RegionTest, signal_stddev_stable)
+{
+    // A large offset relative to the spread and a long run of
+    // evictions must not degrade the variance.
+    geopm::Region region(42, GEOPM_POLICY_HINT_COMPUTE, 1, 1);
+    std::vector<struct geopm_sample_message_s> sample(1);
+    sample[0].region_id = 42;
+    for (int i = 0; i < 100000; ++i) {
+        for (int j = 0; j < GEOPM_NUM_SAMPLE_TYPE; ++j) {
+            sample[0].signal[j] = 1.0e9 + (i % 2);
+        }
+        region.insert(sample);
+    }
+    EXPECT_EQ(8, region.num_sample(0, GEOPM_SAMPLE_TYPE_RUNTIME));
+    EXPECT_NEAR(1.0e9 + 0.5, region.mean(0, GEOPM_SAMPLE_TYPE_RUNTIME), 1.0e-6);
+    EXPECT_NEAR(0.5, region.std_deviation(0, GEOPM_SAMPLE_TYPE_RUNTIME), 1.0e-6);
+    EXPECT_DOUBLE_EQ(1.0e9, region.min(0, GEOPM_SAMPLE_TYPE_RUNTIME));
+    EXPECT_DOUBLE_EQ(1.0e9 + 1.0, region.max(0, GEOPM_SAMPLE_TYPE_RUNTIME));
+}
+
+TEST_F(RegionTest, signal_median_wrap)
+{
+    // Insert several times the history length so that the sorted
+    // buffer evicts in every position, mixing in invalid (-1.0) and
+    // NAN runtimes which must not be counted.
+    geopm::Region region(42, GEOPM_POLICY_HINT_COMPUTE, 1, 0);
+    std::vector<struct geopm_telemetry_message_s> telemetry(1);
+    std::vector<double> history;
+    telemetry[0].region_id = 42;
+    for (int i = 0; i < 40; ++i) {
+        double runtime = (double)((i * 7) % 11);
+        if (i % 5 == 3) {
+            runtime = -1.0;
+        }
+        else if (i % 7 == 4) {
+            runtime = NAN;
+        }
+        geopm_time(&telemetry[0].timestamp);
+        for (int j = 0; j < GEOPM_NUM_TELEMETRY_TYPE; ++j) {
+            telemetry[0].signal[j] = (double)i;
+        }
+        telemetry[0].signal[GEOPM_TELEMETRY_TYPE_RUNTIME] = runtime;
+        region.insert(telemetry);
+
+        history.push_back(runtime);
+        if (history.size() > 8) {
+            history.erase(history.begin());
+        }
+        std::vector<double> sorted;
+        for (auto it = history.begin(); it != history.end(); ++it) {
+            if (*it != -1.0 && !std::isnan(*it)) {
+                sorted.push_back(*it);
+            }
+        }
+        std::sort(sorted.begin(), sorted.end());
+        double median = region.median(0, GEOPM_TELEMETRY_TYPE_RUNTIME);
+        if (sorted.size()) {
+            EXPECT_DOUBLE_EQ(sorted[sorted.size() / 2], median) << "insert " << i;
+        }
+        else {
+            EXPECT_TRUE(std::isnan(median)) << "insert " << i;
+        }
+        // Signals other than progress and runtime are always valid
+        EXPECT_DOUBLE_EQ(std::max(i - 7, 0) + (std::min(i, 7) + 1) / 2,
+                         region.median(0, GEOPM_TELEMETRY_TYPE_PKG_ENERGY)) << "insert " << i;
+    }
+}
+
+TEST_F(RegionTest, sample_age)
+{
+    geopm::Region region(42, GEOPM_POLICY_HINT_COMPUTE, 2, 1);
+    std::vector<struct geopm_sample_message_s> sample(2);
+    std::vector<int> age(2, 0);
+    struct geopm_sample_message_s agg;
+    for (int i = 0; i < 2; ++i) {
+        sample[i].region_id = 42;
+        for (int j = 0; j < GEOPM_NUM_SAMPLE_TYPE; ++j) {
+            sample[i].signal[j] = 1.0 + i;
+        }
+    }
+    region.insert(sample, age);
+    EXPECT_EQ((uint64_t)1, region.num_complete());
+
+    // Only the second child has a new sample, the first is reused
+    for (int k = 0; k < 10; ++k) {
+        for (int j = 0; j < GEOPM_NUM_SAMPLE_TYPE; ++j) {
+            sample[1].signal[j] = 3.0 + k;
+        }
+        age[0] = k + 1;
+        region.insert(sample, age);
+        EXPECT_EQ(k + 1, region.sample_age(0));
+        EXPECT_EQ(0, region.sample_age(1));
+    }
+    EXPECT_EQ((uint64_t)11, region.num_complete());
+    // The reused sample is not counted again and has been evicted
+    EXPECT_EQ(0, region.num_sample(0, GEOPM_SAMPLE_TYPE_RUNTIME));
+    EXPECT_TRUE(std::isnan(region.median(0, GEOPM_SAMPLE_TYPE_RUNTIME)));
+    EXPECT_EQ(8, region.num_sample(1, GEOPM_SAMPLE_TYPE_RUNTIME));
+    EXPECT_DOUBLE_EQ(8.5, region.mean(1, GEOPM_SAMPLE_TYPE_RUNTIME));
+    EXPECT_DOUBLE_EQ(9.0, region.median(1, GEOPM_SAMPLE_TYPE_RUNTIME));
+    // The last known value is still reported
+    EXPECT_DOUBLE_EQ(1.0, region.signal(0, GEOPM_SAMPLE_TYPE_RUNTIME));
+    // Energy of the reused sample is aggregated once
+    region.aggregate_sample_message(agg);
+    EXPECT_DOUBLE_EQ(1.0 + 2.0 + 75.0, agg.signal[GEOPM_SAMPLE_TYPE_ENERGY]);
+    region.sample_message(agg);
+    EXPECT_DOUBLE_EQ(1.0 + 12.0, agg.signal[GEOPM_SAMPLE_TYPE_ENERGY]);
+
+    // Nothing new: only the ages change
+    age[0] = 11;
+    age[1] = 1;
+    region.insert(sample, age);
+    EXPECT_EQ((uint64_t)11, region.num_complete());
+    EXPECT_EQ(1, region.sample_age(1));
+    EXPECT_EQ(8, region.num_sample(1, GEOPM_SAMPLE_TYPE_RUNTIME));
+    region.aggregate_sample_message(agg);
+    EXPECT_DOUBLE_EQ(1.0 + 2.0 + 75.0, agg.signal[GEOPM_SAMPLE_TYPE_ENERGY]);
+}
+
 TEST_F(RegionTest, negative_region_invalid)
 {
     int thrown = 0;
@@ -480,3 +696,16 @@ TEST_F(RegionTest, negative_signal_derivative_tree)
     EXPECT_EQ(GEOPM_ERROR_NOT_IMPLEMENTED, thrown);
 }
 
+TEST_F(RegionTest, negative_signal_integral_tree)
+{
+    int thrown = 0;
+    double delta_time, integral;
+    try {
+        m_tree_region->integral(0, GEOPM_SAMPLE_TYPE_RUNTIME, delta_time, integral);
+    }
+    catch (geopm::Exception e) {
+        thrown = e.err_value();
+    }
+    EXPECT_EQ(GEOPM_ERROR_NOT_IMPLEMENTED, thrown);
+}
+